@@ -102,11 +102,14 @@
 #include <QTranslator>
 #include <QWindow>
 
+#include "ImageCache.h"
 #include "InstanceList.h"
 #include "MTPixmapCache.h"
 
 #include <minecraft/auth/AccountList.h>
 #include "icons/IconList.h"
+#include "modplatform/ModpackUpdatePrefetcher.h"
+#include "net/ApiResponseCache.h"
 #include "net/HttpMetaCache.h"
 
 #include "updater/ExternalUpdater.h"
@@ -664,6 +667,11 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("NumberOfConcurrentDownloads", 6);
         m_settings->registerSetting("NumberOfManualRetries", 1);
         m_settings->registerSetting("RequestTimeout", 60);
+        // seconds a modding platform API response is used without asking the server again
+        m_settings->registerSetting("ApiCacheTTL", 300);
+        // download the files of modpack updates of managed instances before they are applied, checking every so many minutes
+        m_settings->registerSetting("ModpackUpdatePrefetch", false);
+        m_settings->registerSetting("ModpackUpdatePrefetchInterval", 360);
 
         QString defaultMonospace;
         int defaultSize = 11;
@@ -691,6 +699,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("ConsoleFontSize", defaultSize);
         m_settings->registerSetting("ConsoleMaxLines", 100000);
         m_settings->registerSetting("ConsoleOverflowStop", true);
+        m_settings->registerSetting("ConsoleUnlimitedScrollback", false);
 
         logModel->setMaxLines(getConsoleMaxLines(settings()));
         logModel->setStopOnOverflow(shouldStopOnConsoleOverflow(settings()));
@@ -1023,10 +1032,18 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->addBase("java", QDir("cache/java").absolutePath());
         m_metacache->addBase("feed", QDir("cache/feed").absolutePath());
+        m_metacache->addBase("ModpackUpdates", QDir("cache/ModpackUpdates").absolutePath());
         m_metacache->Load();
+        m_apiCache.reset(new Net::ApiResponseCache(QDir("cache/api").absolutePath()));
+        // past its TTL an entry is only good for revalidating, keep those for about a day at the default TTL
+        m_apiCache->setDiskLimits(m_settings->get("ApiCacheTTL").toLongLong() * 288, 64 * 1024 * 1024);
+        m_imageCache.reset(new ImageCache(QDir("cache/thumbnails").absolutePath()));
+        m_imageCache->setDiskLimits(30 * 24 * 60 * 60, 64 * 1024 * 1024);
         qInfo() << "<> Cache initialized.";
     }
 
+    m_modpackUpdatePrefetcher.reset(new ModpackUpdatePrefetcher());
+
     // now we have network, download translation updates
     m_translations->downloadIndex();
 
@@ -1830,6 +1847,16 @@ HttpMetaCache* Application::metacache()
     return m_metacache.get();
 }
 
+Net::ApiResponseCache* Application::apiCache()
+{
+    return m_apiCache.get();
+}
+
+ImageCache* Application::imageCache()
+{
+    return m_imageCache.get();
+}
+
 QNetworkAccessManager* Application::network()
 {
     return m_network.get();
@@ -60,6 +60,8 @@ class SetupWizard;
 class GenericPageProvider;
 class QFile;
 class HttpMetaCache;
+class ImageCache;
+class ModpackUpdatePrefetcher;
 class SettingsObject;
 class InstanceList;
 class AccountList;
@@ -75,6 +77,10 @@ class MCEditTool;
 class ThemeManager;
 class IconTheme;
 
+namespace Net {
+class ApiResponseCache;
+}
+
 namespace Meta {
 class Index;
 }
@@ -146,6 +152,10 @@ class Application : public QApplication {
 
     HttpMetaCache* metacache();
 
+    Net::ApiResponseCache* apiCache();
+
+    ImageCache* imageCache();
+
     Meta::Index* metadataIndex();
 
     void updateCapabilities();
@@ -250,6 +260,8 @@ class Application : public QApplication {
     std::unique_ptr<AccountList> m_accounts;
 
     std::unique_ptr<HttpMetaCache> m_metacache;
+    std::unique_ptr<Net::ApiResponseCache> m_apiCache;
+    std::unique_ptr<ImageCache> m_imageCache;
     std::unique_ptr<Meta::Index> m_metadataIndex;
 
     std::unique_ptr<SettingsObject> m_settings;
@@ -261,6 +273,7 @@ class Application : public QApplication {
     std::unique_ptr<MCEditTool> m_mcedit;
     QSet<QString> m_features;
     std::unique_ptr<ThemeManager> m_themeManager;
+    std::unique_ptr<ModpackUpdatePrefetcher> m_modpackUpdatePrefetcher;
 
     QMap<QString, std::shared_ptr<BaseProfilerFactory>> m_profilers;
 
@@ -71,6 +71,11 @@ bool shouldStopOnConsoleOverflow(SettingsObject* settings)
     return settings->get("ConsoleOverflowStop").toBool();
 }
 
+bool shouldKeepConsoleScrollback(SettingsObject* settings)
+{
+    return settings->get("ConsoleUnlimitedScrollback").toBool();
+}
+
 BaseInstance::BaseInstance(SettingsObject* globalSettings, std::unique_ptr<SettingsObject> settings, const QString& rootDir) : QObject()
 {
     m_settings = std::move(settings);
@@ -115,6 +120,7 @@ BaseInstance::BaseInstance(SettingsObject* globalSettings, std::unique_ptr<Setti
 
     m_settings->registerPassthrough(globalSettings->getSetting("ConsoleMaxLines"), nullptr);
     m_settings->registerPassthrough(globalSettings->getSetting("ConsoleOverflowStop"), nullptr);
+    m_settings->registerPassthrough(globalSettings->getSetting("ConsoleUnlimitedScrollback"), nullptr);
 
     // Managed Packs
     m_settings->registerSetting("ManagedPack", false);
@@ -327,6 +333,7 @@ void BaseInstance::resetTimePlayed()
 {
     settings()->reset("totalTimePlayed");
     settings()->reset("lastTimePlayed");
+    emit propertiesChanged(this);
 }
 
 QString BaseInstance::instanceType() const
@@ -401,7 +408,11 @@ void BaseInstance::setName(QString val)
 bool BaseInstance::syncInstanceDirName(const QString& newRoot) const
 {
     auto oldRoot = instanceRoot();
-    return oldRoot == newRoot || QFile::rename(oldRoot, newRoot);
+    if (oldRoot == newRoot)
+        return true;
+    // pending writes would go to the old folder
+    m_settings->flush();
+    return QFile::rename(oldRoot, newRoot);
 }
 
 void BaseInstance::registerShortcut(const ShortcutData& data)
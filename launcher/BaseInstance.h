@@ -77,6 +77,7 @@ struct ShortcutData {
 /// Console settings
 int getConsoleMaxLines(SettingsObject* settings);
 bool shouldStopOnConsoleOverflow(SettingsObject* settings);
+bool shouldKeepConsoleScrollback(SettingsObject* settings);
 
 /*!
  * \brief Base class for instances.
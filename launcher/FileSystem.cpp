@@ -51,6 +51,7 @@
 #include <QUrl>
 #include <QtNetwork>
 #include <system_error>
+#include <vector>
 
 #include "DesktopServices.h"
 #include "PSaveFile.h"
@@ -1146,6 +1147,57 @@ bool overrideFolder(QString overwritten_path, QString override_path)
     return err.value() == 0;
 }
 
+bool mergeFolder(QString target_path, QString source_path, bool replace)
+{
+    if (!QFileInfo::exists(target_path))
+        return move(source_path, target_path);
+
+    const auto source = fs::path(StringUtils::toStdString(source_path));
+    const auto target = fs::path(StringUtils::toStdString(target_path));
+
+    // list everything first, the files are moved out of the folders being walked
+    std::error_code err;
+    std::vector<fs::path> folders;
+    std::vector<fs::path> files;
+    for (fs::recursive_directory_iterator it(source, err), end; !err && it != end; it.increment(err)) {
+        if (it->is_directory())
+            folders.push_back(it->path());
+        else
+            files.push_back(it->path());
+    }
+
+    // keep empty folders too
+    for (auto it = folders.begin(); !err && it != folders.end(); ++it)
+        fs::create_directories(target / it->lexically_relative(source), err);
+
+    for (auto it = files.begin(); !err && it != files.end(); ++it) {
+        auto dest = target / it->lexically_relative(source);
+        if (fs::exists(dest)) {
+            if (!replace)
+                continue;
+            fs::remove(dest, err);
+            if (err)
+                break;
+        }
+        fs::create_directories(dest.parent_path(), err);
+        if (err)
+            break;
+        fs::rename(*it, dest, err);
+        if (err) {
+            // different filesystems, most likely
+            err.clear();
+            fs::copy(*it, dest, fs::copy_options::copy_symlinks, err);
+        }
+    }
+
+    if (err) {
+        qCritical() << QString("Failed to merge %1 into %2").arg(source_path, target_path);
+        qCritical() << "Reason:" << QString::fromStdString(err.message());
+        return false;
+    }
+    return deletePath(source_path);
+}
+
 QString getFilesystemTypeName(FilesystemType type)
 {
     auto iter = s_filesystem_type_names.constFind(type);
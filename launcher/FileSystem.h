@@ -362,6 +362,10 @@ QString getApplicationsDir();
 // Equivalent to doing QDir::rename, but allowing for overrides
 bool overrideFolder(QString overwritten_path, QString override_path);
 
+// Moves the contents of one folder into another, keeping the files that are already there unless 'replace' is set
+// The source folder is removed afterwards
+bool mergeFolder(QString target_path, QString source_path, bool replace = false);
+
 /**
  * Creates a shortcut to the specified target file at the specified destination path.
  * Returns null QString if creation failed; otherwise returns the path to the created shortcut.
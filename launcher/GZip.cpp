@@ -39,6 +39,8 @@
 #include <QDebug>
 #include <QFile>
 
+#include <algorithm>
+
 bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes)
 {
     if (compressedBytes.size() == 0) {
@@ -153,41 +155,40 @@ int inf(QFile* source, std::function<bool(const QByteArray&)> handleBlock)
     if (ret != Z_OK)
         return ret;
 
-    /* decompress until deflate stream ends or end of file */
-    do {
-        strm.avail_in = source->read(in, CHUNK);
-        if (source->error()) {
-            (void)inflateEnd(&strm);
-            return Z_ERRNO;
-        }
-        if (strm.avail_in == 0)
-            break;
-        strm.next_in = reinterpret_cast<Bytef*>(in);
-
-        /* run inflate() on input until output buffer not full */
-        do {
-            strm.avail_out = CHUNK;
-            strm.next_out = out;
-            ret = inflate(&strm, Z_NO_FLUSH);
-            assert(ret != Z_STREAM_ERROR); /* state not clobbered */
-            switch (ret) {
-                case Z_NEED_DICT:
-                    ret = Z_DATA_ERROR; /* and fall through */
-                case Z_DATA_ERROR:
-                case Z_MEM_ERROR:
-                    (void)inflateEnd(&strm);
-                    return ret;
-            }
-            have = CHUNK - strm.avail_out;
-            if (!handleBlock(QByteArray(reinterpret_cast<const char*>(out), have))) {
+    /* decompress until the end of file, member after member */
+    for (;;) {
+        if (strm.avail_in == 0) {
+            strm.avail_in = source->read(in, CHUNK);
+            if (source->error()) {
                 (void)inflateEnd(&strm);
-                return Z_OK;
+                return Z_ERRNO;
             }
+            if (strm.avail_in == 0)
+                break;
+            strm.next_in = reinterpret_cast<Bytef*>(in);
+        }
 
-        } while (strm.avail_out == 0);
-
-        /* done when inflate() says it's done */
-    } while (ret != Z_STREAM_END);
+        strm.avail_out = CHUNK;
+        strm.next_out = out;
+        ret = inflate(&strm, Z_NO_FLUSH);
+        assert(ret != Z_STREAM_ERROR); /* state not clobbered */
+        switch (ret) {
+            case Z_NEED_DICT:
+                ret = Z_DATA_ERROR; /* and fall through */
+            case Z_DATA_ERROR:
+            case Z_MEM_ERROR:
+                (void)inflateEnd(&strm);
+                return ret;
+        }
+        have = CHUNK - strm.avail_out;
+        if (have > 0 && !handleBlock(QByteArray(reinterpret_cast<const char*>(out), have))) {
+            (void)inflateEnd(&strm);
+            return Z_OK;
+        }
+        /* concatenated gzip files are one file, another member may follow */
+        if (ret == Z_STREAM_END)
+            inflateReset(&strm);
+    }
 
     /* clean up and return */
     (void)inflateEnd(&strm);
@@ -216,3 +217,156 @@ QString GZip::readGzFileByBlocks(QFile* source, std::function<bool(const QByteAr
     auto ret = inf(source, handleBlock);
     return zerr(ret);
 }
+
+struct GZip::SeekIndex::Point {
+    qint64 out = 0;  // uncompressed offset
+    qint64 in = 0;   // compressed offset of the next input byte
+    z_stream state;
+    ~Point() { (void)inflateEnd(&state); }
+};
+
+GZip::SeekIndex::SeekIndex() = default;
+GZip::SeekIndex::~SeekIndex() = default;
+
+QString GZip::SeekIndex::build(QFile* source, std::function<bool(const QByteArray&)> handleBlock, qint64 spacing)
+{
+    constexpr auto CHUNK = 16384;
+    m_points.clear();
+    m_size = 0;
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    char in[CHUNK];
+    unsigned char out[CHUNK];
+
+    int ret = inflateInit2(&strm, (16 + MAX_WBITS));
+    if (ret != Z_OK)
+        return zerr(ret);
+
+    // where the current member starts, inflateReset() restarts the totals of the stream
+    qint64 inBase = 0;
+    qint64 outBase = 0;
+
+    auto addPoint = [this, &strm, &inBase, &outBase]() {
+        auto point = std::make_unique<Point>();
+        memset(&point->state, 0, sizeof(point->state));
+        if (inflateCopy(&point->state, &strm) != Z_OK)
+            return false;
+        point->out = outBase + strm.total_out;
+        point->in = inBase + strm.total_in;
+        m_points.push_back(std::move(point));
+        return true;
+    };
+
+    if (!source->seek(0) || !addPoint()) {
+        (void)inflateEnd(&strm);
+        return zerr(Z_MEM_ERROR);
+    }
+    qint64 lastPoint = 0;
+
+    for (;;) {
+        if (strm.avail_in == 0) {
+            strm.avail_in = source->read(in, CHUNK);
+            if (source->error()) {
+                (void)inflateEnd(&strm);
+                return zerr(Z_ERRNO);
+            }
+            if (strm.avail_in == 0)
+                break;
+            strm.next_in = reinterpret_cast<Bytef*>(in);
+        }
+
+        strm.avail_out = CHUNK;
+        strm.next_out = out;
+        ret = inflate(&strm, Z_NO_FLUSH);
+        switch (ret) {
+            case Z_NEED_DICT:
+                ret = Z_DATA_ERROR; /* and fall through */
+            case Z_DATA_ERROR:
+            case Z_MEM_ERROR:
+            case Z_STREAM_ERROR:
+                (void)inflateEnd(&strm);
+                return zerr(ret);
+        }
+        auto have = CHUNK - strm.avail_out;
+        if (have > 0 && handleBlock && !handleBlock(QByteArray(reinterpret_cast<const char*>(out), have))) {
+            (void)inflateEnd(&strm);
+            return {};
+        }
+        if (ret == Z_STREAM_END) {
+            // concatenated gzip files are one file, another member may follow
+            inBase += strm.total_in;
+            outBase += strm.total_out;
+            inflateReset(&strm);
+        } else if (outBase + static_cast<qint64>(strm.total_out) - lastPoint >= spacing) {
+            if (!addPoint()) {
+                (void)inflateEnd(&strm);
+                return zerr(Z_MEM_ERROR);
+            }
+            lastPoint = outBase + strm.total_out;
+        }
+    }
+
+    // the file has to end with a complete member
+    m_size = outBase;
+    (void)inflateEnd(&strm);
+    return ret == Z_STREAM_END ? QString() : zerr(Z_DATA_ERROR);
+}
+
+QByteArray GZip::SeekIndex::read(QFile* source, qint64 offset, qint64 length) const
+{
+    constexpr auto CHUNK = 16384;
+    if (m_points.empty() || offset < 0 || length <= 0 || offset >= m_size)
+        return {};
+    length = std::min(length, m_size - offset);
+
+    // last seek point at or before the offset
+    auto it = std::upper_bound(m_points.begin(), m_points.end(), offset,
+                               [](qint64 value, const std::unique_ptr<Point>& point) { return value < point->out; });
+    const auto& point = *std::prev(it);
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if (inflateCopy(&strm, const_cast<z_stream*>(&point->state)) != Z_OK || !source->seek(point->in)) {
+        (void)inflateEnd(&strm);
+        return {};
+    }
+    strm.avail_in = 0;
+
+    QByteArray result;
+    result.reserve(length);
+    qint64 skip = offset - point->out;
+    char in[CHUNK];
+    unsigned char out[CHUNK];
+    for (;;) {
+        if (strm.avail_in == 0) {
+            strm.avail_in = source->read(in, CHUNK);
+            if (source->error() || strm.avail_in == 0)
+                break;
+            strm.next_in = reinterpret_cast<Bytef*>(in);
+        }
+        strm.avail_out = CHUNK;
+        strm.next_out = out;
+        int ret = inflate(&strm, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END)
+            break;
+
+        qint64 have = CHUNK - strm.avail_out;
+        if (ret == Z_STREAM_END)
+            inflateReset(&strm);
+        auto data = reinterpret_cast<const char*>(out);
+        if (skip >= have) {
+            skip -= have;
+            continue;
+        }
+        data += skip;
+        have -= skip;
+        skip = 0;
+        result.append(data, std::min(have, length - result.size()));
+        if (result.size() >= length)
+            break;
+    }
+
+    (void)inflateEnd(&strm);
+    return result;
+}
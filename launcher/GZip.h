@@ -2,10 +2,39 @@
 #include <QByteArray>
 #include <QFile>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace GZip {
 
 bool unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes);
 bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes);
 QString readGzFileByBlocks(QFile* source, std::function<bool(const QByteArray&)> handleBlock);
 
+/**
+ * Random access into a gzip file.
+ *
+ * While the file is decompressed once by build(), a copy of the decompressor state is kept every
+ * `spacing` uncompressed bytes. read() then only has to inflate from the closest seek point
+ * instead of from the start of the file.
+ */
+class SeekIndex {
+   public:
+    SeekIndex();
+    ~SeekIndex();
+
+    /// decompress the whole file, passing each block to handleBlock. returns an error message or an empty string
+    QString build(QFile* source, std::function<bool(const QByteArray&)> handleBlock, qint64 spacing = 4 * 1024 * 1024);
+    /// uncompressed size, valid after a successful build
+    qint64 size() const { return m_size; }
+    /// read `length` uncompressed bytes starting at `offset`
+    QByteArray read(QFile* source, qint64 offset, qint64 length) const;
+
+   private:
+    struct Point;
+    std::vector<std::unique_ptr<Point>> m_points;
+    qint64 m_size = 0;
+};
+
 }  // namespace GZip
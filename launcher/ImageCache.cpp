@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ImageCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QPainter>
+#include <QSaveFile>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+#include "FileSystem.h"
+
+ImageCache::ImageCache(QString path, qsizetype memoryLimit, int maxThreads, QObject* parent)
+    : QObject(parent), m_path(std::move(path)), m_memory(memoryLimit)
+{
+    m_pool.setMaxThreadCount(maxThreads);
+}
+
+ImageCache::~ImageCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+    m_prune.waitForFinished();
+}
+
+QString ImageCache::cacheKey(const QString& key, QSize size, bool pad) const
+{
+    return QString("%1@%2x%3%4").arg(key).arg(size.width()).arg(size.height()).arg(pad ? "+pad" : "");
+}
+
+std::optional<QPixmap> ImageCache::find(const QString& key, QSize size, bool pad)
+{
+    if (auto pixmap = m_memory.object(cacheKey(key, size, pad)))
+        return *pixmap;
+    return {};
+}
+
+void ImageCache::load(const QString& key, const QString& sourcePath, QSize size, QObject* context, Callback callback, bool pad)
+{
+    auto cache_key = cacheKey(key, size, pad);
+    if (auto pixmap = m_memory.object(cache_key)) {
+        callback(*pixmap);
+        return;
+    }
+
+    auto waiting = m_loading.find(cache_key);
+    if (waiting != m_loading.end()) {
+        waiting->append({ context, std::move(callback) });
+        return;
+    }
+    m_loading.insert(cache_key, { { context, std::move(callback) } });
+
+    auto name = QCryptographicHash::hash(cache_key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    auto thumbnail_path = FS::PathCombine(m_path, QString::fromLatin1(name) + ".png");
+    m_pool.start([this, cache_key, sourcePath, thumbnail_path, size, pad] {
+        qint64 written = 0;
+        auto image = makeThumbnail(sourcePath, thumbnail_path, size, pad, &written);
+        QMetaObject::invokeMethod(this, [this, cache_key, image, written] { loaded(cache_key, image, written); }, Qt::QueuedConnection);
+    });
+}
+
+void ImageCache::remove(const QString& key, QSize size, bool pad)
+{
+    m_memory.remove(cacheKey(key, size, pad));
+}
+
+void ImageCache::loaded(const QString& cacheKey, const QImage& image, qint64 written)
+{
+    m_written += written;
+    if (m_maxSize >= 0 && m_written > m_maxSize / 4)
+        schedulePrune();
+
+    QPixmap pixmap;
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        m_memory.insert(cacheKey, new QPixmap(pixmap), qsizetype(pixmap.width()) * pixmap.height() * pixmap.depth() / 8);
+    }
+
+    for (auto& waiting : m_loading.take(cacheKey)) {
+        if (waiting.context)
+            waiting.callback(pixmap);
+    }
+}
+
+QImage ImageCache::makeThumbnail(const QString& sourcePath, const QString& thumbnailPath, QSize size, bool pad, qint64* written)
+{
+    if (written)
+        *written = 0;
+
+    QFileInfo source(sourcePath);
+    QFileInfo thumbnail(thumbnailPath);
+    if (thumbnail.exists() && thumbnail.lastModified() >= source.lastModified()) {
+        QImage image(thumbnailPath);
+        if (!image.isNull()) {
+            auto now = QDateTime::currentDateTime();
+            if (thumbnail.lastModified().secsTo(now) > 24 * 60 * 60) {
+                QFile file(thumbnailPath);
+                if (file.open(QIODevice::ReadWrite))
+                    file.setFileTime(now, QFileDevice::FileModificationTime);
+            }
+            return image;
+        }
+    }
+
+    QImageReader reader(sourcePath);
+    reader.setAutoTransform(true);
+    // let the decoder skip the detail it would throw away, where it can
+    auto source_size = reader.size();
+    if (source_size.isValid() && (source_size.width() > size.width() || source_size.height() > size.height()))
+        reader.setScaledSize(source_size.scaled(size, Qt::KeepAspectRatio));
+
+    auto image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "Error loading image" << sourcePath << ":" << reader.errorString();
+        return {};
+    }
+    if (image.width() > size.width() || image.height() > size.height())
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    if (pad && image.size() != size) {
+        QImage canvas(size, QImage::Format_ARGB32);
+        canvas.fill(Qt::transparent);
+
+        QPainter painter(&canvas);
+        painter.drawImage(QPoint((size.width() - image.width()) / 2, (size.height() - image.height()) / 2), image);
+        painter.end();
+        image = canvas;
+    }
+
+    if (!thumbnailPath.isEmpty() && FS::ensureFilePathExists(thumbnailPath)) {
+        QSaveFile file(thumbnailPath);
+        if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit())
+            qWarning() << "Failed to save thumbnail of" << sourcePath << "to" << thumbnailPath;
+        else if (written)
+            *written = QFileInfo(thumbnailPath).size();
+    }
+    return image;
+}
+
+void ImageCache::setDiskLimits(qint64 maxAge, qint64 maxSize)
+{
+    m_maxAge = maxAge;
+    m_maxSize = maxSize;
+    schedulePrune();
+}
+
+void ImageCache::schedulePrune()
+{
+    if (m_maxSize < 0 || m_prune.isRunning())
+        return;
+    m_written = 0;
+    m_prune = QtConcurrent::run(QThreadPool::globalInstance(), [this, maxAge = m_maxAge, maxSize = m_maxSize] { prune(maxAge, maxSize); });
+}
+
+void ImageCache::prune(qint64 maxAge, qint64 maxSize)
+{
+    struct File {
+        QString path;
+        qint64 size;
+        qint64 modified;
+    };
+    QList<File> files;
+    qint64 total = 0;
+    int removed = 0;
+    auto oldest = QDateTime::currentMSecsSinceEpoch() - maxAge * 1000;
+
+    QDirIterator it(m_path, { "*.png" }, QDir::Files | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        auto info = QFileInfo(it.next());
+        auto modified = info.lastModified().toMSecsSinceEpoch();
+        if (maxAge >= 0 && modified < oldest) {
+            removed += QFile::remove(info.filePath());
+            continue;
+        }
+        files.append({ info.filePath(), info.size(), modified });
+        total += info.size();
+    }
+
+    if (maxSize >= 0 && total > maxSize) {
+        std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.modified < b.modified; });
+        for (auto& file : files) {
+            if (total <= maxSize)
+                break;
+            if (QFile::remove(file.path)) {
+                total -= file.size;
+                removed++;
+            }
+        }
+    }
+    if (removed > 0)
+        qDebug() << "Pruned" << removed << "thumbnails," << total << "bytes left";
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QCache>
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QThreadPool>
+
+#include <functional>
+#include <optional>
+
+/**
+ * Thumbnails of the images shown in lists, like the logos of modding platform projects and screenshots.
+ *
+ * Images are identified by a key, like their URL or path. Their thumbnails are decoded on a few worker threads, scaled down to fit
+ * the requested size, and kept on disk so loading them again only decodes the small version. A thumbnail is made again once its
+ * source image changes. The thumbnails used last stay in memory, up to a size limit.
+ *
+ * A padded thumbnail is centered on a transparent canvas of the requested size, so thumbnails of images of any shape line up.
+ */
+class ImageCache : public QObject {
+    Q_OBJECT
+   public:
+    using Callback = std::function<void(const QPixmap&)>;
+
+    /** The size of the logos of modpacks and other resources in the lists of the modding platforms. */
+    static constexpr QSize s_logoSize{ 64, 64 };
+
+    explicit ImageCache(QString path, qsizetype memoryLimit = 32 * 1024 * 1024, int maxThreads = 2, QObject* parent = nullptr);
+    ~ImageCache() override;
+
+    /** The thumbnail of 'key' at 'size', if it is in memory. */
+    std::optional<QPixmap> find(const QString& key, QSize size, bool pad = false);
+
+    /**
+     * Loads the thumbnail of the image at 'sourcePath' known as 'key', and calls 'callback' with it, or with a null pixmap if the
+     * image can't be read. The callback is called right away if the thumbnail is in memory, and later on this thread otherwise,
+     * unless 'context' was deleted by then.
+     */
+    void load(const QString& key, const QString& sourcePath, QSize size, QObject* context, Callback callback, bool pad = false);
+
+    /** Drops the thumbnail of 'key' at 'size' from memory. */
+    void remove(const QString& key, QSize size, bool pad = false);
+
+    /**
+     * Makes a thumbnail fitting in 'size' of the image at 'sourcePath', reusing the one at 'thumbnailPath' unless it is older.
+     * A reused thumbnail is touched at most once a day, so pruning keeps the ones in use.
+     * 'written' is set to the size of the thumbnail file when a new one was saved, and to 0 otherwise.
+     */
+    static QImage makeThumbnail(const QString& sourcePath,
+                                const QString& thumbnailPath,
+                                QSize size,
+                                bool pad = false,
+                                qint64* written = nullptr);
+
+    /**
+     * Limits what is kept on disk to thumbnails used in the last 'maxAge' seconds, taking at most 'maxSize' bytes.
+     * Prunes in the background now, and again whenever about a quarter of 'maxSize' was written since.
+     */
+    void setDiskLimits(qint64 maxAge, qint64 maxSize);
+    /** Deletes the thumbnails not used in the last 'maxAge' seconds, then the oldest ones until the rest takes at most 'maxSize' bytes. */
+    void prune(qint64 maxAge, qint64 maxSize);
+
+   private:
+    QString cacheKey(const QString& key, QSize size, bool pad) const;
+    void loaded(const QString& cacheKey, const QImage& image, qint64 written);
+    void schedulePrune();
+
+   private:
+    struct Waiting {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    QString m_path;
+    QThreadPool m_pool;
+
+    qint64 m_maxAge = -1;
+    qint64 m_maxSize = -1;
+    // bytes written since the last prune
+    qint64 m_written = 0;
+    QFuture<void> m_prune;
+
+    QCache<QString, QPixmap> m_memory;
+    QHash<QString, QList<Waiting>> m_loading;
+};
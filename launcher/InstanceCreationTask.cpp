@@ -1,6 +1,7 @@
 #include "InstanceCreationTask.h"
 
 #include <QDebug>
+#include <QEventLoop>
 #include <QFile>
 #include "FileSystem.h"
 
@@ -15,11 +16,14 @@ void InstanceCreationTask::executeTask()
 
     // When the user aborted in the update stage.
     if (m_abort) {
+        stopExtraction();
         emitAborted();
         return;
     }
 
-    if (!createInstance()) {
+    // an abort while the instance was created leaves the extraction to be stopped, not waited for
+    if (!createInstance() || m_abort || !waitForExtraction()) {
+        stopExtraction();
         if (m_abort)
             return;
 
@@ -64,3 +68,39 @@ void InstanceCreationTask::executeTask()
     if (!m_abort)
         emitSucceeded();
 }
+
+bool InstanceCreationTask::waitForExtraction()
+{
+    if (!m_extraction)
+        return true;
+
+    if (!m_extraction->isFinished()) {
+        setStatus(tr("Extracting modpack..."));
+        QEventLoop loop;
+        connect(m_extraction.get(), &Task::finished, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+
+    auto extraction = std::exchange(m_extraction, nullptr);
+    if (!extraction->wasSuccessful()) {
+        setError(extraction->failReason());
+        return false;
+    }
+    return true;
+}
+
+void InstanceCreationTask::stopExtraction()
+{
+    if (!m_extraction)
+        return;
+
+    if (!m_extraction->isFinished()) {
+        // the staging folder is removed after this task, nothing may be extracted into it anymore
+        QEventLoop loop;
+        connect(m_extraction.get(), &Task::finished, &loop, &QEventLoop::quit);
+        m_extraction->abort();
+        if (!m_extraction->isFinished())
+            loop.exec();
+    }
+    m_extraction = nullptr;
+}
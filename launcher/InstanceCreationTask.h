@@ -9,6 +9,13 @@ class InstanceCreationTask : public InstanceTask {
     InstanceCreationTask() = default;
     virtual ~InstanceCreationTask() = default;
 
+    /**
+     * Extraction of the pack files that is still running while the instance is created.
+     *
+     * It is stopped if the creation fails, createInstance() has to waitForExtraction() before using the extracted files.
+     */
+    void setPendingExtraction(Task::Ptr extraction) { m_extraction = std::move(extraction); }
+
    protected:
     void executeTask() final override;
 
@@ -36,11 +43,18 @@ class InstanceCreationTask : public InstanceTask {
    protected:
     void setError(const QString& message) { m_error_message = message; };
 
+    /** Waits for the pending extraction, if any. Returns false and sets the error if it did not succeed. */
+    bool waitForExtraction();
+
    protected:
     bool m_abort = false;
 
     QStringList m_files_to_remove;
 
+   private:
+    void stopExtraction();
+
    private:
     QString m_error_message;
+    Task::Ptr m_extraction;
 };
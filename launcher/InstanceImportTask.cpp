@@ -42,6 +42,7 @@
 
 #include "QObjectPtr.h"
 #include "archive/ArchiveReader.h"
+#include "archive/ArchiveWriter.h"
 #include "archive/ExtractZipTask.h"
 #include "icons/IconList.h"
 #include "icons/IconUtils.h"
@@ -69,6 +70,8 @@ bool InstanceImportTask::abort()
         return false;
 
     bool wasAborted = false;
+    if (m_extractTask)
+        m_extractTask->abort();
     if (m_task)
         wasAborted = m_task->abort();
     return wasAborted;
@@ -124,70 +127,93 @@ void InstanceImportTask::processZipPack()
     QDir extractDir(m_stagingPath);
     qDebug() << "Attempting to create instance from" << m_archivePath;
 
-    // open the zip and find relevant files in it
+    // find relevant files in the zip, its central directory lists them without reading through the archive
     MMCZip::ArchiveReader packZip(m_archivePath);
     qDebug() << "Attempting to determine instance type";
+    if (!packZip.collectFiles(false)) {
+        emitFailed(tr("Unable to open supplied modpack zip file."));
+        return;
+    }
 
     QString root;
     // NOTE: Prioritize modpack platforms that aren't searched for recursively.
     // Especially Flame has a very common filename for its manifest, which may appear inside overrides for example
     // https://docs.modrinth.com/docs/modpacks/format_definition/#storage
-    auto detectInstance = [this, &extractDir, &root](MMCZip::ArchiveReader::File* f, bool& stop) {
-        if (!isRunning()) {
-            stop = true;
-            return true;
-        }
-        auto fileName = f->filename();
+    for (auto& fileName : packZip.getFiles()) {
         if (fileName == "modrinth.index.json") {
             // process as Modrinth pack
             qDebug() << "Modrinth:" << true;
             m_modpackType = ModpackType::Modrinth;
-            stop = true;
+            break;
         } else if (fileName == "bin/modpack.jar" || fileName == "bin/version.json") {
             // process as Technic pack
             qDebug() << "Technic:" << true;
             extractDir.mkpath("minecraft");
             extractDir.cd("minecraft");
             m_modpackType = ModpackType::Technic;
-            stop = true;
+            break;
         } else if (fileName == "manifest.json") {
             qDebug() << "Flame:" << true;
             m_modpackType = ModpackType::Flame;
-            stop = true;
+            break;
         } else if (QFileInfo fileInfo(fileName); fileInfo.fileName() == "instance.cfg") {
             qDebug() << "MultiMC:" << true;
             m_modpackType = ModpackType::MultiMC;
             root = cleanPath(fileInfo.path());
-            stop = true;
+            break;
         }
-        QCoreApplication::processEvents();
-        return true;
-    };
-    if (!packZip.parse(detectInstance)) {
-        emitFailed(tr("Unable to open supplied modpack zip file."));
-        return;
     }
     if (m_modpackType == ModpackType::Unknown) {
         emitFailed(tr("Archive does not contain a recognized modpack type."));
         return;
     }
+
+    if (m_modpackType == ModpackType::Modrinth || m_modpackType == ModpackType::Flame) {
+        // Their files download as soon as the manifest is read, so only the files at the root of the pack are
+        // extracted up front. The rest of the pack (the overrides) extracts while the instance is created.
+        QStringList rootFiles;
+        for (auto& fileName : packZip.getFiles()) {
+            if (!fileName.contains('/') || fileName == "overrides/icon.png")
+                rootFiles << fileName;
+        }
+        setStatus(tr("Reading modpack manifest"));
+        if (!extractFiles(extractDir, rootFiles)) {
+            emitFailed(tr("Failed to extract modpack manifest."));
+            return;
+        }
+        fixPermissions(extractDir);
+
+        auto zipTask = makeShared<MMCZip::ExtractZipTask>(m_archivePath, extractDir);
+        zipTask->setExcludedFiles(rootFiles);
+        // the creation task waits on this one, so the permissions are fixed before it gets to the extracted files
+        connect(zipTask.get(), &Task::succeeded, this, [this, extractDir] { fixPermissions(extractDir); });
+        startExtraction(zipTask);
+        m_extractTask = zipTask;
+
+        if (m_modpackType == ModpackType::Flame)
+            processFlame();
+        else
+            processModrinth();
+        return;
+    }
+
     setStatus(tr("Extracting modpack"));
 
     // make sure we extract just the pack
     auto zipTask = makeShared<MMCZip::ExtractZipTask>(m_archivePath, extractDir, root);
-
-    auto progressStep = std::make_shared<TaskStepProgress>();
-    connect(zipTask.get(), &Task::finished, this, [this, progressStep] {
-        progressStep->state = TaskStepState::Succeeded;
-        stepProgress(*progressStep);
-    });
-
     connect(zipTask.get(), &Task::succeeded, this, &InstanceImportTask::extractFinished, Qt::QueuedConnection);
     connect(zipTask.get(), &Task::aborted, this, &InstanceImportTask::emitAborted);
-    connect(zipTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
-        progressStep->state = TaskStepState::Failed;
+    connect(zipTask.get(), &Task::failed, this, &InstanceImportTask::emitFailed);
+    m_task.reset(zipTask);
+    startExtraction(zipTask);
+}
+
+void InstanceImportTask::startExtraction(Task::Ptr zipTask)
+{
+    auto progressStep = std::make_shared<TaskStepProgress>();
+    connect(zipTask.get(), &Task::finished, this, [this, raw = zipTask.get(), progressStep] {
+        progressStep->state = raw->wasSuccessful() ? TaskStepState::Succeeded : TaskStepState::Failed;
         stepProgress(*progressStep);
-        emitFailed(reason);
     });
     connect(zipTask.get(), &Task::stepProgress, this, &InstanceImportTask::propagateStepProgress);
 
@@ -200,15 +226,62 @@ void InstanceImportTask::processZipPack()
         stepProgress(*progressStep);
     });
     connect(zipTask.get(), &Task::warningLogged, this, [this](const QString& line) { m_Warnings.append(line); });
-    m_task.reset(zipTask);
     zipTask->start();
 }
 
+bool InstanceImportTask::extractFiles(const QDir& extractDir, const QStringList& files)
+{
+    if (files.isEmpty())
+        return true;
+
+    auto target = QUrl::fromLocalFile(extractDir.absolutePath());
+    auto extPtr = MMCZip::ArchiveWriter::createDiskWriter();
+    auto ext = extPtr.get();
+
+    MMCZip::ArchiveReader packZip(m_archivePath);
+    int remaining = files.size();
+    return packZip.parse([&](MMCZip::ArchiveReader::File* f, bool& stop) {
+        auto fileName = f->filename();
+        if (!files.contains(fileName))
+            return f->skip();
+
+        auto path = extractDir.absoluteFilePath(fileName);
+        if (!target.isParentOf(QUrl::fromLocalFile(path))) {
+            qWarning() << "Refusing to extract" << fileName << "outside of" << extractDir.absolutePath();
+            return false;
+        }
+        FS::ensureFilePathExists(path);
+        stop = --remaining == 0;
+        return f->writeFile(ext, path);
+    });
+}
+
 void InstanceImportTask::extractFinished()
 {
     setAbortable(false);
-    QDir extractDir(m_stagingPath);
+    fixPermissions(QDir(m_stagingPath));
+
+    switch (m_modpackType) {
+        case ModpackType::MultiMC:
+            processMultiMC();
+            return;
+        case ModpackType::Technic:
+            processTechnic();
+            return;
+        case ModpackType::Flame:
+            processFlame();
+            return;
+        case ModpackType::Modrinth:
+            processModrinth();
+            return;
+        case ModpackType::Unknown:
+            emitFailed(tr("Archive does not contain a recognized modpack type."));
+            return;
+    }
+}
 
+void InstanceImportTask::fixPermissions(const QDir& extractDir)
+{
     qDebug() << "Fixing permissions for extracted pack files...";
     QDirIterator it(extractDir, QDirIterator::Subdirectories);
     while (it.hasNext()) {
@@ -231,24 +304,6 @@ void InstanceImportTask::extractFinished()
             }
         }
     }
-
-    switch (m_modpackType) {
-        case ModpackType::MultiMC:
-            processMultiMC();
-            return;
-        case ModpackType::Technic:
-            processTechnic();
-            return;
-        case ModpackType::Flame:
-            processFlame();
-            return;
-        case ModpackType::Modrinth:
-            processModrinth();
-            return;
-        case ModpackType::Unknown:
-            emitFailed(tr("Archive does not contain a recognized modpack type."));
-            return;
-    }
 }
 
 bool installIcon(QString root, QString instIconKey)
@@ -325,6 +380,7 @@ void InstanceImportTask::processFlame()
 
     connect(inst_creation_task.get(), &Task::warningLogged, this, [this](const QString& line) { m_Warnings.append(line); });
 
+    inst_creation_task->setPendingExtraction(m_extractTask);
     m_task.reset(inst_creation_task);
     setAbortable(true);
     m_task->start();
@@ -424,6 +480,7 @@ void InstanceImportTask::processModrinth()
 
     connect(inst_creation_task.get(), &Task::warningLogged, this, [this](const QString& line) { m_Warnings.append(line); });
 
+    inst_creation_task->setPendingExtraction(m_extractTask);
     m_task.reset(inst_creation_task);
     setAbortable(true);
     m_task->start();
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <QDir>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QUrl>
@@ -57,6 +58,11 @@ class InstanceImportTask : public InstanceTask {
     void processFlame();
     void processModrinth();
 
+    void startExtraction(Task::Ptr zipTask);
+    /** Extracts the given archive entries right away. */
+    bool extractFiles(const QDir& extractDir, const QStringList& files);
+    void fixPermissions(const QDir& extractDir);
+
    private slots:
     void processZipPack();
     void extractFinished();
@@ -65,6 +71,8 @@ class InstanceImportTask : public InstanceTask {
     QUrl m_sourceUrl;
     QString m_archivePath;
     Task::Ptr m_task;
+    /** Extraction of the overrides while a Modrinth or Flame pack is being created. */
+    Task::Ptr m_extractTask;
     enum class ModpackType {
         Unknown,
         MultiMC,
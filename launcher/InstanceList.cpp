@@ -40,6 +40,7 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QMimeData>
@@ -48,7 +49,9 @@
 #include <QStack>
 #include <QTextStream>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
+#include <QtConcurrent>
 #include <QUuid>
 #include <QXmlStreamReader>
 
@@ -56,6 +59,7 @@
 #include "ExponentialSeries.h"
 #include "FileSystem.h"
 #include "InstanceList.h"
+#include "InstanceSettingsTask.h"
 #include "InstanceTask.h"
 #include "NullInstance.h"
 #include "WatchLock.h"
@@ -472,26 +476,46 @@ static QMap<InstanceId, InstanceLocator> getIdMapping(const std::vector<std::uni
     return out;
 }
 
+static QStringList listInstanceDirs(const QString& instDir)
+{
+    QStringList out;
+    QDirIterator iter(instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
+    while (iter.hasNext()) {
+        out.append(iter.next());
+    }
+    return out;
+}
+
+static bool isInstanceDir(const QString& instDir, const QString& subDir)
+{
+    QFileInfo dirInfo(subDir);
+    if (!QFileInfo(FS::PathCombine(subDir, "instance.cfg")).exists())
+        return false;
+    // if it is a symlink, ignore it if it goes to the instance folder
+    if (dirInfo.isSymLink()) {
+        QFileInfo targetInfo(dirInfo.symLinkTarget());
+        QFileInfo instDirInfo(instDir);
+        if (targetInfo.canonicalPath() == instDirInfo.canonicalFilePath()) {
+            qDebug() << "Ignoring symlink" << subDir << "that leads into the instances folder";
+            return false;
+        }
+    }
+    return true;
+}
+
 QList<InstanceId> InstanceList::discoverInstances()
 {
     qInfo() << "Discovering instances in" << m_instDir;
+    // listing the directory is cheap, probing every entry is not (especially on network file systems)
+    const QString instDir = m_instDir;
+    auto isInstance = [instDir](const QString& subDir) { return isInstanceDir(instDir, subDir); };
+    // blockingFiltered keeps the original order, so the discovery order is stable
+    auto instanceDirs = QtConcurrent::blockingFiltered(QThreadPool::globalInstance(), listInstanceDirs(instDir), isInstance);
+
     QList<InstanceId> out;
-    QDirIterator iter(m_instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
-    while (iter.hasNext()) {
-        QString subDir = iter.next();
-        QFileInfo dirInfo(subDir);
-        if (!QFileInfo(FS::PathCombine(subDir, "instance.cfg")).exists())
-            continue;
-        // if it is a symlink, ignore it if it goes to the instance folder
-        if (dirInfo.isSymLink()) {
-            QFileInfo targetInfo(dirInfo.symLinkTarget());
-            QFileInfo instDirInfo(m_instDir);
-            if (targetInfo.canonicalPath() == instDirInfo.canonicalFilePath()) {
-                qDebug() << "Ignoring symlink" << subDir << "that leads into the instances folder";
-                continue;
-            }
-        }
-        auto id = dirInfo.fileName();
+    out.reserve(instanceDirs.size());
+    for (auto& subDir : instanceDirs) {
+        auto id = QFileInfo(subDir).fileName();
         out.append(id);
         qInfo() << "Found instance ID" << id;
     }
@@ -501,20 +525,55 @@ QList<InstanceId> InstanceList::discoverInstances()
 }
 
 InstanceList::InstListError InstanceList::loadList()
+{
+    if (!m_snapshotTried) {
+        m_snapshotTried = true;
+        if (m_instances.empty() && loadSnapshot()) {
+            return NoError;
+        }
+    }
+    mergeInstances(discoverInstances(), {});
+    return NoError;
+}
+
+void InstanceList::mergeInstances(const QList<InstanceId>& ids, QHash<InstanceId, InstanceSnapshot::Entry> loaded)
 {
     auto existingIds = getIdMapping(m_instances);
 
     std::vector<std::unique_ptr<BaseInstance>> newList;
 
-    for (auto& id : discoverInstances()) {
+    QList<InstanceId> added;
+    for (auto& id : ids) {
         if (existingIds.contains(id)) {
             existingIds.remove(id);
             qInfo() << "Should keep and soft-reload" << id;
         } else {
-            std::unique_ptr<BaseInstance> instPtr = loadInstance(id);
-            if (instPtr) {
-                newList.push_back(std::move(instPtr));
-            }
+            added.append(id);
+        }
+    }
+
+    QList<InstanceId> toRead;
+    for (auto& id : added) {
+        if (!loaded.contains(id))
+            toRead.append(id);
+    }
+    if (!toRead.isEmpty()) {
+        // Parsing instance.cfg is the expensive part, and INIFile is a plain value, so do that on the pool.
+        // The instances themselves are QObjects hooked up to the global settings and are created here.
+        const QString instDir = m_instDir;
+        auto readConfig = [instDir](const InstanceId& id) { return InstanceSnapshot::read(instDir, id); };
+        for (auto& entry : QtConcurrent::blockingMapped(QThreadPool::globalInstance(), toRead, readConfig)) {
+            loaded.insert(entry.id, std::move(entry));
+        }
+    }
+
+    newList.reserve(added.size());
+    for (auto& id : added) {
+        auto entry = loaded.take(id);
+        m_configStamps.insert(id, entry.stamp);
+        std::unique_ptr<BaseInstance> instPtr = loadInstance(id, std::move(entry.config));
+        if (instPtr) {
+            newList.push_back(std::move(instPtr));
         }
     }
 
@@ -537,6 +596,7 @@ InstanceList::InstListError InstanceList::loadList()
         };
         for (auto& removedItem : deadList) {
             auto instPtr = removedItem.first;
+            m_configStamps.remove(instPtr->id());
             instPtr->invalidate();
             currentItem = removedItem.second;
             if (back_bookmark == -1) {
@@ -553,28 +613,171 @@ InstanceList::InstListError InstanceList::loadList()
         if (back_bookmark != -1) {
             removeNow();
         }
+        rebuildIndex();
     }
     if (newList.size()) {
         add(newList);
     }
     m_dirty = false;
-    updateTotalPlayTime();
-    return NoError;
+    saveSnapshot();
+}
+
+QString InstanceList::snapshotPath() const
+{
+    return QDir("cache").absoluteFilePath("instances.snapshot");
+}
+
+bool InstanceList::loadSnapshot()
+{
+    QList<InstanceSnapshot::Entry> entries;
+    if (!InstanceSnapshot::load(snapshotPath(), m_instDir, entries) || entries.isEmpty()) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<BaseInstance>> newList;
+    newList.reserve(entries.size());
+    QList<InstanceId> ids;
+    ids.reserve(entries.size());
+    for (auto& entry : entries) {
+        ids.append(entry.id);
+        m_configStamps.insert(entry.id, entry.stamp);
+        std::unique_ptr<BaseInstance> instPtr = loadInstance(entry.id, std::move(entry.config));
+        if (instPtr) {
+            newList.push_back(std::move(instPtr));
+        }
+    }
+    instanceSet = QSet<QString>(ids.begin(), ids.end());
+    m_instancesProbed = true;
+    add(newList);
+    m_dirty = false;
+    qInfo() << "Loaded" << ids.size() << "instances from the snapshot, checking them against" << m_instDir;
+
+    // Find out what happened to the instance folder since the snapshot was taken
+    auto check = [instDir = m_instDir, stamps = m_configStamps] {
+        SnapshotCheck result;
+        result.instDir = instDir;
+        result.known = QSet<InstanceId>(stamps.keyBegin(), stamps.keyEnd());
+        for (auto& subDir : listInstanceDirs(instDir)) {
+            if (!isInstanceDir(instDir, subDir))
+                continue;
+            auto id = QFileInfo(subDir).fileName();
+            result.ids.append(id);
+            auto stamp = stamps.constFind(id);
+            if (stamp == stamps.constEnd()) {
+                result.added.insert(id, InstanceSnapshot::read(instDir, id));
+            } else if (*stamp != InstanceSnapshot::stampOf(FS::PathCombine(instDir, id, "instance.cfg"))) {
+                result.changed.insert(id);
+            }
+        }
+        return result;
+    };
+    auto watcher = new QFutureWatcher<SnapshotCheck>(this);
+    connect(watcher, &QFutureWatcher<SnapshotCheck>::finished, this, [this, watcher] {
+        applySnapshotCheck(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), check));
+    return true;
+}
+
+void InstanceList::applySnapshotCheck(SnapshotCheck check)
+{
+    if (check.instDir != m_instDir) {
+        return;
+    }
+    for (auto& id : check.changed) {
+        auto inst = getInstanceById(id);
+        if (!inst) {
+            continue;
+        }
+        qDebug() << "Instance" << id << "changed since the snapshot was taken, reloading it";
+        auto settings = inst->settings();
+        settings->suspendSave();
+        settings->reload();
+        settings->resumeSave();
+        m_configStamps.insert(id, InstanceSnapshot::stampOf(FS::PathCombine(inst->instanceRoot(), "instance.cfg")));
+        propertiesChanged(inst);
+    }
+    // instances were created and deleted while the check ran, only what changed since the snapshot is applied
+    QSet<InstanceId> found(check.ids.begin(), check.ids.end());
+    QList<InstanceId> ids;
+    ids.reserve(m_instances.size() + check.added.size());
+    for (auto& inst : m_instances) {
+        if (found.contains(inst->id()) || !check.known.contains(inst->id())) {
+            ids.append(inst->id());
+        }
+    }
+    for (auto& id : check.ids) {
+        if (!check.known.contains(id) && !getInstanceById(id) && isInstanceDir(m_instDir, FS::PathCombine(m_instDir, id))) {
+            ids.append(id);
+        }
+    }
+    instanceSet = QSet<QString>(ids.begin(), ids.end());
+    m_instancesProbed = true;
+    mergeInstances(ids, std::move(check.added));
+}
+
+void InstanceList::saveSnapshot(bool wait)
+{
+    QList<InstanceSnapshot::Entry> entries;
+    entries.reserve(m_instances.size());
+    for (auto& inst : m_instances) {
+        auto settings = dynamic_cast<INISettingsObject*>(inst->settings());
+        auto stamp = m_configStamps.constFind(inst->id());
+        if (!settings || stamp == m_configStamps.constEnd()) {
+            continue;
+        }
+        entries.append({ inst->id(), *stamp, settings->contents() });
+    }
+
+    auto save = [path = snapshotPath(), instDir = m_instDir, entries] { InstanceSnapshot::save(path, instDir, entries); };
+    m_snapshotSave.waitForFinished();
+    if (wait) {
+        save();
+    } else {
+        m_snapshotSave = QtConcurrent::run(QThreadPool::globalInstance(), save);
+    }
 }
 
-void InstanceList::updateTotalPlayTime()
+void InstanceList::rebuildIndex()
 {
+    m_rowIndex.clear();
+    m_idIndex.clear();
+    m_runningInstances.clear();
     totalPlayTime = 0;
-    for (auto const& itr : m_instances) {
-        totalPlayTime += itr->totalTimePlayed();
+    m_rowIndex.reserve(m_instances.size());
+    m_idIndex.reserve(m_instances.size());
+    int count = m_instances.size();
+    for (int i = 0; i < count; i++) {
+        indexInstance(i);
     }
+    m_managedNameIndexDirty = true;
+}
+
+void InstanceList::indexInstance(int row)
+{
+    auto inst = m_instances.at(row).get();
+    auto playTime = inst->totalTimePlayed();
+    m_rowIndex.insert(inst, { row, playTime });
+    // on duplicate IDs the first instance wins, like it did with the linear search
+    auto id = inst->id();
+    if (!m_idIndex.contains(id)) {
+        m_idIndex.insert(id, inst);
+    }
+    if (inst->isRunning()) {
+        m_runningInstances.insert(inst);
+    }
+    totalPlayTime += playTime;
+    m_managedNameIndexDirty = true;
 }
 
 void InstanceList::saveNow()
 {
     for (auto& item : m_instances) {
         item->saveNow();
+        item->settings()->flush();
     }
+    saveSnapshot(true);
 }
 
 void InstanceList::add(std::vector<std::unique_ptr<BaseInstance>>& t)
@@ -582,7 +785,35 @@ void InstanceList::add(std::vector<std::unique_ptr<BaseInstance>>& t)
     beginInsertRows(QModelIndex(), m_instances.size(), m_instances.size() + t.size() - 1);
     for (auto& ptr : t) {
         m_instances.push_back(std::move(ptr));
-        connect(m_instances.back().get(), &BaseInstance::propertiesChanged, this, &InstanceList::propertiesChanged);
+        auto inst = m_instances.back().get();
+        connect(inst, &BaseInstance::propertiesChanged, this, &InstanceList::propertiesChanged);
+        connect(inst, &BaseInstance::runningStatusChanged, this, [this, inst](bool running) {
+            if (running) {
+                m_runningInstances.insert(inst);
+            } else {
+                m_runningInstances.remove(inst);
+                // the session is part of the saved play time now
+                updatePlayTime(inst);
+            }
+        });
+        // the managed pack name is not one of the properties shown in the list, so there is no propertiesChanged for it
+        auto managedNameChanged = [this](const Setting& setting) {
+            if (setting.id() == "ManagedPackName") {
+                m_managedNameIndexDirty = true;
+            }
+        };
+        connect(inst->settings(), &SettingsObject::SettingChanged, this, managedNameChanged);
+        connect(inst->settings(), &SettingsObject::settingReset, this, managedNameChanged);
+        // our own writes are not changes the snapshot check has to pick up
+        if (auto settings = dynamic_cast<INISettingsObject*>(inst->settings())) {
+            connect(settings, &INISettingsObject::saved, this,
+                    [this, id = inst->id(), path = FS::PathCombine(inst->instanceRoot(), "instance.cfg")] {
+                        if (m_configStamps.contains(id)) {
+                            m_configStamps.insert(id, InstanceSnapshot::stampOf(path));
+                        }
+                    });
+        }
+        indexInstance(m_instances.size() - 1);
     }
     endInsertRows();
 }
@@ -616,12 +847,7 @@ BaseInstance* InstanceList::getInstanceById(QString instId) const
 {
     if (instId.isEmpty())
         return nullptr;
-    for (auto& inst : m_instances) {
-        if (inst->id() == instId) {
-            return inst.get();
-        }
-    }
-    return nullptr;
+    return m_idIndex.value(instId);
 }
 
 BaseInstance* InstanceList::getInstanceByManagedName(const QString& managed_name) const
@@ -629,12 +855,17 @@ BaseInstance* InstanceList::getInstanceByManagedName(const QString& managed_name
     if (managed_name.isEmpty())
         return {};
 
-    for (auto& instance : m_instances) {
-        if (instance->getManagedPackName() == managed_name)
-            return instance.get();
+    if (m_managedNameIndexDirty) {
+        m_managedNameIndex.clear();
+        for (auto& instance : m_instances) {
+            auto name = instance->getManagedPackName();
+            if (!name.isEmpty() && !m_managedNameIndex.contains(name))
+                m_managedNameIndex.insert(name, instance.get());
+        }
+        m_managedNameIndexDirty = false;
     }
 
-    return {};
+    return m_managedNameIndex.value(managed_name);
 }
 
 QModelIndex InstanceList::getInstanceIndexById(const QString& id) const
@@ -644,32 +875,78 @@ QModelIndex InstanceList::getInstanceIndexById(const QString& id) const
 
 int InstanceList::getInstIndex(BaseInstance* inst) const
 {
-    int count = m_instances.size();
-    for (int i = 0; i < count; i++) {
-        if (inst == m_instances.at(i).get()) {
-            return i;
-        }
+    auto entry = m_rowIndex.constFind(inst);
+    if (entry == m_rowIndex.constEnd()) {
+        return -1;
     }
-    return -1;
+    return entry->row;
+}
+
+int InstanceList::updatePlayTime(BaseInstance* inst)
+{
+    auto entry = m_rowIndex.find(inst);
+    if (entry == m_rowIndex.end()) {
+        return -1;
+    }
+    // while running, the play time of the instance also counts the current session, even once it was saved at the end of it.
+    // getTotalPlayTime() adds the session, the play time is taken again when the instance stops.
+    if (m_runningInstances.contains(inst)) {
+        return entry->row;
+    }
+    auto playTime = inst->totalTimePlayed();
+    totalPlayTime += playTime - entry->playTime;
+    entry->playTime = playTime;
+    return entry->row;
 }
 
 void InstanceList::propertiesChanged(BaseInstance* inst)
 {
-    int i = getInstIndex(inst);
-    if (i != -1) {
-        emit dataChanged(index(i), index(i));
-        updateTotalPlayTime();
+    auto row = updatePlayTime(inst);
+    if (row >= 0) {
+        emit dataChanged(index(row), index(row));
     }
 }
 
-std::unique_ptr<BaseInstance> InstanceList::loadInstance(const InstanceId& id)
+Task::Ptr InstanceList::applySettings(const QStringList& ids, const QVariantMap& changes)
+{
+    auto task = makeShared<InstanceSettingsTask>(this, ids, changes);
+    // also on failure, most of them may have been written
+    connect(task.get(), &Task::finished, this, [this, raw = task.get()] { settingsApplied(raw->changedIds()); });
+    return task;
+}
+
+void InstanceList::settingsApplied(const QStringList& ids)
+{
+    int first = -1;
+    int last = -1;
+    for (auto& id : ids) {
+        auto inst = getInstanceById(id);
+        if (!inst) {
+            continue;
+        }
+        m_configStamps.insert(id, InstanceSnapshot::stampOf(FS::PathCombine(inst->instanceRoot(), "instance.cfg")));
+        auto row = updatePlayTime(inst);
+        if (row < 0) {
+            continue;
+        }
+        first = first < 0 ? row : std::min(first, row);
+        last = std::max(last, row);
+    }
+    if (first >= 0) {
+        emit dataChanged(index(first), index(last));
+    }
+    saveSnapshot();
+}
+
+std::unique_ptr<BaseInstance> InstanceList::loadInstance(const InstanceId& id, INIFile config)
 {
     if (!m_groupsLoaded) {
         loadGroupList();
     }
 
     auto instanceRoot = FS::PathCombine(m_instDir, id);
-    auto instanceSettings = std::make_unique<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"));
+    auto instanceSettings = std::make_unique<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"), std::move(config));
+    instanceSettings->setWriteBehind(true);
     std::unique_ptr<BaseInstance> inst;
 
     instanceSettings->registerSetting("InstanceType", "");
@@ -889,6 +1166,8 @@ void InstanceList::on_InstFolderChanged([[maybe_unused]] const Setting& setting,
         beginRemoveRows(QModelIndex(), 0, count());
         m_instances.erase(m_instances.begin(), m_instances.end());
         endRemoveRows();
+        rebuildIndex();
+        m_configStamps.clear();
         emit instancesChanged();
     }
 }
@@ -1081,8 +1360,12 @@ bool InstanceList::destroyStagingPath(const QString& keyPath)
 
 int InstanceList::getTotalPlayTime()
 {
-    updateTotalPlayTime();
-    return totalPlayTime;
+    // running instances keep adding to their play time without telling us
+    qint64 total = totalPlayTime;
+    for (auto inst : m_runningInstances) {
+        total += inst->totalTimePlayed() - m_rowIndex.value(inst).playTime;
+    }
+    return total;
 }
 
 #include "InstanceList.moc"
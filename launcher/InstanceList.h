@@ -36,6 +36,8 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QFuture>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QPair>
@@ -43,6 +45,7 @@
 #include <QStack>
 
 #include "BaseInstance.h"
+#include "InstanceSnapshot.h"
 
 class QFileSystemWatcher;
 class InstanceTask;
@@ -103,9 +106,9 @@ class InstanceList : public QAbstractListModel {
     InstListError loadList();
     void saveNow();
 
-    /* O(n) */
+    /* O(1) */
     BaseInstance* getInstanceById(QString id) const;
-    /* O(n) */
+    /* O(1), O(n) after a managed pack name changed */
     BaseInstance* getInstanceByManagedName(const QString& managed_name) const;
     QModelIndex getInstanceIndexById(const QString& id) const;
     QStringList getGroups();
@@ -121,6 +124,12 @@ class InstanceList : public QAbstractListModel {
     bool undoTrashInstance();
     void deleteInstance(const InstanceId& id);
 
+    /**
+     * Create a task that applies the same setting changes to many instances, see InstanceSettingsTask.
+     * The views are updated once all of them have been written.
+     */
+    Task::Ptr applySettings(const QStringList& ids, const QVariantMap& changes);
+
     // Wrap an instance creation task in some more task machinery and make it ready to be used
     Task* wrapInstanceTask(InstanceTask* task);
 
@@ -171,28 +180,58 @@ class InstanceList : public QAbstractListModel {
 
    private slots:
     void propertiesChanged(BaseInstance* inst);
+    void settingsApplied(const QStringList& ids);
     void providerUpdated();
     void instanceDirContentsChanged(const QString& path);
 
+   private /* types */:
+    // result of checking a loaded snapshot against the instance folder
+    struct SnapshotCheck {
+        QString instDir;
+        // the instances the check started from
+        QSet<InstanceId> known;
+        QList<InstanceId> ids;
+        QSet<InstanceId> changed;
+        QHash<InstanceId, InstanceSnapshot::Entry> added;
+    };
+
+    struct IndexEntry {
+        int row = -1;
+        qint64 playTime = 0;
+    };
+
    private:
     int getInstIndex(BaseInstance* inst) const;
-    void updateTotalPlayTime();
+    void rebuildIndex();
+    void indexInstance(int row);
+    int updatePlayTime(BaseInstance* inst);
     void suspendWatch();
     void resumeWatch();
     void add(std::vector<std::unique_ptr<BaseInstance>>& list);
     void loadGroupList();
     void saveGroupList();
     QList<InstanceId> discoverInstances();
-    std::unique_ptr<BaseInstance> loadInstance(const InstanceId& id);
+    std::unique_ptr<BaseInstance> loadInstance(const InstanceId& id, INIFile config);
+    void mergeInstances(const QList<InstanceId>& ids, QHash<InstanceId, InstanceSnapshot::Entry> loaded);
+    QString snapshotPath() const;
+    bool loadSnapshot();
+    void applySnapshotCheck(SnapshotCheck check);
+    void saveSnapshot(bool wait = false);
 
     void increaseGroupCount(const QString& group);
     void decreaseGroupCount(const QString& group);
 
    private:
     int m_watchLevel = 0;
-    int totalPlayTime = 0;
+    // sum of the play times in m_rowIndex
+    qint64 totalPlayTime = 0;
     bool m_dirty = false;
     std::vector<std::unique_ptr<BaseInstance>> m_instances;
+    QHash<const BaseInstance*, IndexEntry> m_rowIndex;
+    QHash<InstanceId, BaseInstance*> m_idIndex;
+    mutable QHash<QString, BaseInstance*> m_managedNameIndex;
+    mutable bool m_managedNameIndexDirty = true;
+    QSet<BaseInstance*> m_runningInstances;
     // id -> refs
     QMap<QString, int> m_groupNameCache;
 
@@ -205,6 +244,10 @@ class InstanceList : public QAbstractListModel {
     QSet<InstanceId> instanceSet;
     bool m_groupsLoaded = false;
     bool m_instancesProbed = false;
+    bool m_snapshotTried = false;
+    // stamps of the instance.cfg files as they were when we read them
+    QHash<InstanceId, InstanceSnapshot::Stamp> m_configStamps;
+    QFuture<void> m_snapshotSave;
 
     QStack<TrashHistoryItem> m_trashHistory;
 };
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "InstanceSettingsTask.h"
+
+#include <QDebug>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
+#include "BaseInstance.h"
+#include "InstanceList.h"
+#include "settings/INISettingsObject.h"
+
+InstanceSettingsTask::InstanceSettingsTask(InstanceList* instances, QStringList ids, QVariantMap changes)
+    : m_instances(instances), m_ids(std::move(ids)), m_changes(std::move(changes))
+{}
+
+void InstanceSettingsTask::executeTask()
+{
+    setStatus(tr("Changing the settings of %n instance(s)", "", m_ids.size()));
+
+    for (auto& id : m_ids) {
+        auto inst = m_instances->getInstanceById(id);
+        auto settings = inst ? dynamic_cast<INISettingsObject*>(inst->settings()) : nullptr;
+        if (!settings) {
+            qWarning() << "Not changing the settings of" << id << "as it is not a loaded instance";
+            continue;
+        }
+
+        // the file is written below, keep the settings object from writing it too until that is done
+        settings->suspendSave();
+        for (auto it = m_changes.constBegin(); it != m_changes.constEnd(); ++it) {
+            if (!settings->contains(it.key())) {
+                qWarning() << "Instance" << id << "has no setting" << it.key();
+            } else if (it.value().isValid()) {
+                settings->set(it.key(), it.value());
+            } else {
+                settings->reset(it.key());
+            }
+        }
+        m_jobs.append({ settings, settings->filePath(), settings->contents() });
+        m_changedIds.append(id);
+    }
+
+    setProgress(0, m_jobs.size());
+    connect(&m_watcher, &QFutureWatcher<bool>::progressValueChanged, this, [this](int value) { setProgress(value, m_jobs.size()); });
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, &InstanceSettingsTask::writeFinished);
+    m_watcher.setFuture(QtConcurrent::mapped(QThreadPool::globalInstance(), m_jobs, [](const Job& job) {
+        // saveFile() may add the config version, keep the contents as they were handed over
+        INIFile contents = job.contents;
+        return contents.saveFile(job.path);
+    }));
+}
+
+void InstanceSettingsTask::writeFinished()
+{
+    auto future = m_watcher.future();
+    int failed = 0;
+    for (int i = 0; i < m_jobs.size(); i++) {
+        auto& job = m_jobs[i];
+        // the instance went away meanwhile
+        if (!job.settings) {
+            continue;
+        }
+        if (future.resultAt(i)) {
+            job.settings->resumeSave(job.contents);
+        } else {
+            failed++;
+            // try again the usual way
+            job.settings->resumeSave();
+        }
+    }
+    m_jobs.clear();
+
+    if (failed > 0) {
+        emitFailed(tr("Failed to save the settings of %n instance(s).", "", failed));
+        return;
+    }
+    emitSucceeded();
+}
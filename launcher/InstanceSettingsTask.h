@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QList>
+#include <QPointer>
+#include <QVariantMap>
+
+#include "settings/INIFile.h"
+#include "tasks/Task.h"
+
+class InstanceList;
+class INISettingsObject;
+
+/**
+ * Applies the same setting changes to many instances at once.
+ *
+ * The settings are changed on the GUI thread like any other change, but their instance.cfg files are then written
+ * in parallel on the thread pool instead of one after another. Use InstanceList::applySettings() to create one.
+ */
+class InstanceSettingsTask : public Task {
+    Q_OBJECT
+   public:
+    /** 'changes' maps setting IDs to their new value, an invalid value resets the setting. */
+    InstanceSettingsTask(InstanceList* instances, QStringList ids, QVariantMap changes);
+
+    /** The instances that were changed. */
+    QStringList changedIds() const { return m_changedIds; }
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void writeFinished();
+
+   private:
+    struct Job {
+        QPointer<INISettingsObject> settings;
+        QString path;
+        INIFile contents;
+    };
+
+    InstanceList* m_instances;
+    QStringList m_ids;
+    QVariantMap m_changes;
+    QStringList m_changedIds;
+    QList<Job> m_jobs;
+    QFutureWatcher<bool> m_watcher;
+};
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "InstanceSnapshot.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+
+#include "FileSystem.h"
+
+namespace InstanceSnapshot {
+
+static const quint32 SNAPSHOT_MAGIC = 0x494E5350;  // "INSP"
+static const quint32 SNAPSHOT_VERSION = 1;
+
+Stamp stampOf(const QString& filePath)
+{
+    QFileInfo info(filePath);
+    if (!info.exists())
+        return {};
+    return { info.lastModified().toMSecsSinceEpoch(), info.size() };
+}
+
+Entry read(const QString& instDir, const QString& id)
+{
+    auto path = FS::PathCombine(instDir, id, "instance.cfg");
+    Entry entry;
+    entry.id = id;
+    // stamp before reading, so a concurrent write shows up as a changed stamp next time
+    entry.stamp = stampOf(path);
+    entry.config.loadFile(path);
+    return entry;
+}
+
+bool load(const QString& path, const QString& instDir, QList<Entry>& entries)
+{
+    if (!QFileInfo::exists(path))
+        return false;
+
+    QByteArray data;
+    try {
+        data = FS::read(path);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to read instance snapshot:" << e.cause();
+        return false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString snapshotDir;
+    quint32 count = 0;
+    stream >> magic >> version >> snapshotDir >> count;
+    if (stream.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        qWarning() << "Ignoring instance snapshot" << path << "with unknown format";
+        return false;
+    }
+    if (snapshotDir != instDir) {
+        qDebug() << "Ignoring instance snapshot of" << snapshotDir;
+        return false;
+    }
+
+    QList<Entry> out;
+    out.reserve(count);
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        Entry entry;
+        stream >> entry.id >> entry.stamp.modified >> entry.stamp.size >> static_cast<QMap<QString, QVariant>&>(entry.config);
+        out.append(std::move(entry));
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Ignoring truncated instance snapshot" << path;
+        return false;
+    }
+    entries = std::move(out);
+    return true;
+}
+
+bool save(const QString& path, const QString& instDir, const QList<Entry>& entries)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << instDir << quint32(entries.size());
+    for (auto& entry : entries) {
+        stream << entry.id << entry.stamp.modified << entry.stamp.size << static_cast<const QMap<QString, QVariant>&>(entry.config);
+    }
+
+    try {
+        FS::write(path, data);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write instance snapshot:" << e.cause();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace InstanceSnapshot
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "settings/INIFile.h"
+
+/**
+ * On-disk snapshot of the parsed instance.cfg of every instance.
+ *
+ * It lets the instance list show up without opening every instance folder first. Each entry carries the
+ * modification time and size of the instance.cfg it was read from, so it can be checked against the disk later.
+ */
+namespace InstanceSnapshot {
+
+struct Stamp {
+    qint64 modified = -1;
+    qint64 size = -1;
+
+    bool operator==(const Stamp&) const = default;
+};
+
+struct Entry {
+    QString id;
+    Stamp stamp;
+    INIFile config;
+};
+
+Stamp stampOf(const QString& filePath);
+
+/** Stamp and parse the instance.cfg of instance 'id'. Safe to use from any thread. */
+Entry read(const QString& instDir, const QString& id);
+
+/** Load the snapshot at 'path'. Fails if it is unreadable or was taken of a different instance folder. */
+bool load(const QString& path, const QString& instDir, QList<Entry>& entries);
+
+bool save(const QString& path, const QString& instDir, const QList<Entry>& entries);
+
+}  // namespace InstanceSnapshot
@@ -1,57 +1,145 @@
 #include "Version.h"
 
 #include <QDebug>
+#include <QHash>
+#include <QReadWriteLock>
 #include <QRegularExpressionMatch>
 #include <QUrl>
 
+#include <deque>
+
+namespace {
+// the string parts of all versions seen so far, there are only a few of them ("." "-pre" "+build"...)
+const QString* internStringPart(QStringView part)
+{
+    static QReadWriteLock s_lock;
+    static QMultiHash<size_t, const QString*> s_index;
+    static std::deque<QString> s_strings;
+
+    const auto hash = qHash(part);
+    auto find = [&]() -> const QString* {
+        auto [it, end] = s_index.equal_range(hash);
+        for (; it != end; ++it) {
+            if (**it == part)
+                return *it;
+        }
+        return nullptr;
+    };
+
+    {
+        QReadLocker locker(&s_lock);
+        if (auto interned = find())
+            return interned;
+    }
+    QWriteLocker locker(&s_lock);
+    if (auto interned = find())
+        return interned;
+    auto interned = &s_strings.emplace_back(part.toString());
+    s_index.insert(hash, interned);
+    return interned;
+}
+
+bool stringPartLess(const QString* a, const QString* b)
+{
+    // interned, so the same pointer is the same string
+    if (a == b)
+        return false;
+    if (!a)
+        return true;
+    if (!b)
+        return false;
+    return *a < *b;
+}
+}  // namespace
+
 Version::Version(QString str) : m_string(std::move(str))
 {
     parse();
 }
 
-#define VERSION_OPERATOR(return_on_different)                                               \
-    bool exclude_our_sections = false;                                                      \
-    bool exclude_their_sections = false;                                                    \
-                                                                                            \
-    const auto size = qMax(m_sections.size(), other.m_sections.size());                     \
-    for (int i = 0; i < size; ++i) {                                                        \
-        Section sec1 = (i >= m_sections.size()) ? Section() : m_sections.at(i);             \
-        Section sec2 = (i >= other.m_sections.size()) ? Section() : other.m_sections.at(i); \
-                                                                                            \
-        { /* Don't include appendixes in the comparison */                                  \
-            if (sec1.isAppendix())                                                          \
-                exclude_our_sections = true;                                                \
-            if (sec2.isAppendix())                                                          \
-                exclude_their_sections = true;                                              \
-                                                                                            \
-            if (exclude_our_sections) {                                                     \
-                sec1 = Section();                                                           \
-                if (sec2.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-                                                                                            \
-            if (exclude_their_sections) {                                                   \
-                sec2 = Section();                                                           \
-                if (sec1.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-        }                                                                                   \
-                                                                                            \
-        if (sec1 != sec2)                                                                   \
-            return return_on_different;                                                     \
+bool Version::Section::operator==(const Section& other) const
+{
+    if (m_isNull != other.m_isNull)
+        return false;
+    if (!m_isNull)
+        return m_numPart == other.m_numPart && m_stringPart == other.m_stringPart;
+    return true;
+}
+
+bool Version::Section::operator<(const Section& other) const
+{
+    static auto unequal_is_less = [](Section const& non_null) -> bool {
+        if (!non_null.m_stringPart)
+            return non_null.m_numPart == 0;
+        return non_null.m_isPreRelease;
+    };
+
+    if (!m_isNull && other.m_isNull)
+        return unequal_is_less(*this);
+    if (m_isNull && !other.m_isNull)
+        return !unequal_is_less(other);
+
+    if (!m_isNull && !other.m_isNull) {
+        if (m_numPart < other.m_numPart)
+            return true;
+        if (m_numPart == other.m_numPart && stringPartLess(m_stringPart, other.m_stringPart))
+            return true;
+
+        if (m_stringPart && !other.m_stringPart)
+            return false;
+        if (!m_stringPart && other.m_stringPart)
+            return true;
+
+        return false;
     }
 
-bool Version::operator<(const Version& other) const
+    return false;
+}
+
+bool Version::firstDifference(const Version& other, Section& sec1, Section& sec2) const
 {
-    VERSION_OPERATOR(sec1 < sec2)
+    bool exclude_our_sections = false;
+    bool exclude_their_sections = false;
+
+    const auto size = qMax(m_sections.size(), other.m_sections.size());
+    for (qsizetype i = 0; i < size; ++i) {
+        sec1 = (i >= m_sections.size()) ? Section() : m_sections[i];
+        sec2 = (i >= other.m_sections.size()) ? Section() : other.m_sections[i];
+
+        { /* Don't include appendixes in the comparison */
+            if (sec1.m_isAppendix)
+                exclude_our_sections = true;
+            if (sec2.m_isAppendix)
+                exclude_their_sections = true;
+
+            if (exclude_our_sections) {
+                sec1 = Section();
+                if (sec2.m_isNull)
+                    break;
+            }
+
+            if (exclude_their_sections) {
+                sec2 = Section();
+                if (sec1.m_isNull)
+                    break;
+            }
+        }
 
+        if (!(sec1 == sec2))
+            return true;
+    }
     return false;
 }
+
+bool Version::operator<(const Version& other) const
+{
+    Section sec1, sec2;
+    return firstDifference(other, sec1, sec2) && sec1 < sec2;
+}
 bool Version::operator==(const Version& other) const
 {
-    VERSION_OPERATOR(false)
-
-    return true;
+    Section sec1, sec2;
+    return !firstDifference(other, sec1, sec2);
 }
 bool Version::operator!=(const Version& other) const
 {
@@ -73,38 +161,57 @@ bool Version::operator>=(const Version& other) const
 void Version::parse()
 {
     m_sections.clear();
-    QString currentSection;
 
     if (m_string.isEmpty())
         return;
 
-    auto classChange = [&currentSection](QChar lastChar, QChar currentChar) {
+    const QStringView str{ m_string };
+    auto addSection = [this](QStringView text) {
+        Section section;
+        // sections are never empty
+        section.m_isNull = false;
+
+        qsizetype cutoff = text.size();
+        for (qsizetype i = 0; i < text.size(); i++) {
+            if (!text[i].isDigit()) {
+                cutoff = i;
+                break;
+            }
+        }
+
+        auto numPart = text.left(cutoff);
+        if (!numPart.isEmpty())
+            section.m_numPart = numPart.toInt();
+
+        auto stringPart = text.mid(cutoff);
+        if (!stringPart.isEmpty()) {
+            section.m_stringPart = internStringPart(stringPart);
+            section.m_isAppendix = stringPart.startsWith('+');
+            section.m_isPreRelease = stringPart.startsWith('-') && stringPart.length() > 1;
+        }
+        m_sections.append(section);
+    };
+
+    auto classChange = [&str](qsizetype sectionStart, QChar lastChar, QChar currentChar) {
         if (lastChar.isNull())
             return false;
         if (lastChar.isDigit() != currentChar.isDigit())
             return true;
 
-        const QList<QChar> s_separators{ '.', '-', '+' };
-        if (s_separators.contains(currentChar) && currentSection.at(0) != currentChar)
+        if ((currentChar == '.' || currentChar == '-' || currentChar == '+') && str[sectionStart] != currentChar)
             return true;
 
         return false;
     };
 
-    currentSection += m_string.at(0);
-    for (int i = 1; i < m_string.size(); ++i) {
-        const auto& current_char = m_string.at(i);
-        if (classChange(m_string.at(i - 1), current_char)) {
-            if (!currentSection.isEmpty())
-                m_sections.append(Section(currentSection));
-            currentSection = "";
+    qsizetype sectionStart = 0;
+    for (qsizetype i = 1; i < str.size(); ++i) {
+        if (classChange(sectionStart, str[i - 1], str[i])) {
+            addSection(str.mid(sectionStart, i - sectionStart));
+            sectionStart = i;
         }
-
-        currentSection += current_char;
     }
-
-    if (!currentSection.isEmpty())
-        m_sections.append(Section(currentSection));
+    addSection(str.mid(sectionStart));
 }
 
 /// qDebug print support for the Version class
@@ -115,10 +222,13 @@ QDebug operator<<(QDebug debug, const Version& v)
     debug.nospace() << "Version{ string: " << v.toString() << ", sections: [ ";
 
     bool first = true;
-    for (auto s : v.m_sections) {
+    for (auto& s : v.m_sections) {
         if (!first)
             debug.nospace() << ", ";
-        debug.nospace() << s.m_fullString;
+        if (s.m_stringPart)
+            debug.nospace() << *s.m_stringPart;
+        else
+            debug.nospace() << s.m_numPart;
         first = false;
     }
 
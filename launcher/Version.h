@@ -40,6 +40,7 @@
 #include <QList>
 #include <QString>
 #include <QStringView>
+#include <QVarLengthArray>
 
 class QUrl;
 
@@ -61,95 +62,26 @@ class Version {
     friend QDebug operator<<(QDebug debug, const Version& v);
 
    private:
+    /*
+     * A section of the version string: a run of digits, or a run of anything else.
+     * Instead of the text, it keeps the value of the digits and an interned copy of everything else,
+     * so versions compare without allocating or touching the string again.
+     */
     struct Section {
-        explicit Section(QString fullString) : m_fullString(std::move(fullString))
-        {
-            qsizetype cutoff = m_fullString.size();
-            for (int i = 0; i < m_fullString.size(); i++) {
-                if (!m_fullString[i].isDigit()) {
-                    cutoff = i;
-                    break;
-                }
-            }
-
-            auto numPart = QStringView{ m_fullString }.left(cutoff);
-
-            if (!numPart.isEmpty()) {
-                m_isNull = false;
-                m_numPart = numPart.toInt();
-            }
-
-            auto stringPart = QStringView{ m_fullString }.mid(cutoff);
-
-            if (!stringPart.isEmpty()) {
-                m_isNull = false;
-                m_stringPart = stringPart.toString();
-            }
-        }
-
-        explicit Section() = default;
-
-        bool m_isNull = true;
-
+        const QString* m_stringPart = nullptr;  // interned, null if empty
         int m_numPart = 0;
-        QString m_stringPart;
-
-        QString m_fullString;
-
-        inline bool isAppendix() const { return m_stringPart.startsWith('+'); }
-        inline bool isPreRelease() const { return m_stringPart.startsWith('-') && m_stringPart.length() > 1; }
-
-        inline bool operator==(const Section& other) const
-        {
-            if (m_isNull && !other.m_isNull)
-                return false;
-            if (!m_isNull && other.m_isNull)
-                return false;
-
-            if (!m_isNull && !other.m_isNull) {
-                return (m_numPart == other.m_numPart) && (m_stringPart == other.m_stringPart);
-            }
-
-            return true;
-        }
-
-        inline bool operator<(const Section& other) const
-        {
-            static auto unequal_is_less = [](Section const& non_null) -> bool {
-                if (non_null.m_stringPart.isEmpty())
-                    return non_null.m_numPart == 0;
-                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.isPreRelease();
-            };
-
-            if (!m_isNull && other.m_isNull)
-                return unequal_is_less(*this);
-            if (m_isNull && !other.m_isNull)
-                return !unequal_is_less(other);
-
-            if (!m_isNull && !other.m_isNull) {
-                if (m_numPart < other.m_numPart)
-                    return true;
-                if (m_numPart == other.m_numPart && m_stringPart < other.m_stringPart)
-                    return true;
-
-                if (!m_stringPart.isEmpty() && other.m_stringPart.isEmpty())
-                    return false;
-                if (m_stringPart.isEmpty() && !other.m_stringPart.isEmpty())
-                    return true;
-
-                return false;
-            }
-
-            return m_fullString < other.m_fullString;
-        }
+        bool m_isNull = true;
+        bool m_isAppendix = false;
+        bool m_isPreRelease = false;
 
-        inline bool operator!=(const Section& other) const { return !(*this == other); }
-        inline bool operator>(const Section& other) const { return !(*this < other || *this == other); }
+        bool operator==(const Section& other) const;
+        bool operator<(const Section& other) const;
     };
 
    private:
     QString m_string;
-    QList<Section> m_sections;
+    QVarLengthArray<Section, 12> m_sections;
 
     void parse();
+    bool firstDifference(const Version& other, Section& ours, Section& theirs) const;
 };
@@ -22,7 +22,10 @@
 #include <archive.h>
 #include <archive_entry.h>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QtEndian>
+#include <algorithm>
 #include <memory>
 
 namespace MMCZip {
@@ -33,6 +36,12 @@ QStringList ArchiveReader::getFiles()
 
 bool ArchiveReader::collectFiles(bool onlyFiles)
 {
+    // zips list all their entries at the end, no need to walk through the archive for them
+    if (auto names = readCentralDirectory(m_archivePath, onlyFiles)) {
+        m_fileNames = *names;
+        return true;
+    }
+    m_fileNames.clear();
     return parse([this, onlyFiles](File* f) {
         if (!onlyFiles || f->isFile())
             m_fileNames << f->filename();
@@ -230,5 +239,93 @@ bool ArchiveReader::exists(const QString& filePath) const
     return false;
 }
 
+std::optional<QStringList> ArchiveReader::readCentralDirectory(const QString& path, bool onlyFiles)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    // the end of central directory record is 22 bytes, followed by a comment of up to 64 KiB
+    const qint64 tailSize = std::min<qint64>(file.size(), 22 + 0xFFFF);
+    if (tailSize < 22 || !file.seek(file.size() - tailSize))
+        return {};
+    const auto tail = file.read(tailSize);
+    auto u16 = [](const char* p) { return qFromLittleEndian<quint16>(p); };
+    auto u32 = [](const char* p) { return qFromLittleEndian<quint32>(p); };
+    auto u64 = [](const char* p) { return qFromLittleEndian<quint64>(p); };
+
+    // the record ends the file, so its comment length has to match what follows it. That skips a signature in the comment
+    qsizetype eocd = tail.size() - 22;
+    while (eocd >= 0 && (u32(tail.constData() + eocd) != 0x06054b50 || u16(tail.constData() + eocd + 20) != tail.size() - eocd - 22))
+        eocd--;
+    if (eocd < 0)
+        return {};
+    const char* record = tail.constData() + eocd;
+    quint64 count = u16(record + 10);
+    quint64 size = u32(record + 12);
+    // the directory is found relative to the record, so data prepended to the zip does not matter
+    qint64 recordPos = file.size() - tailSize + eocd;
+
+    if (count == 0xFFFF || size == 0xFFFFFFFF) {
+        // zip64: the real numbers are in the zip64 end of central directory record, found through its locator
+        if (eocd < 20 || u32(record - 20) != 0x07064b50)
+            return {};
+        // the record may have an extensible data sector, it is found from its offset and has to end at the locator
+        const qint64 locatorPos = recordPos - 20;
+        const quint64 zip64Pos = u64(record - 20 + 8);
+        if (zip64Pos >= quint64(locatorPos) || !file.seek(qint64(zip64Pos)))
+            return {};
+        const auto zip64 = file.read(56);
+        if (zip64.size() != 56 || u32(zip64.constData()) != 0x06064b50)
+            return {};
+        const quint64 recordSize = u64(zip64.constData() + 4);
+        if (recordSize < 44 || recordSize > quint64(locatorPos) || zip64Pos + 12 + recordSize != quint64(locatorPos))
+            return {};
+        count = u64(zip64.constData() + 32);
+        size = u64(zip64.constData() + 40);
+        recordPos = qint64(zip64Pos);
+    }
+
+    if (size > quint64(recordPos) || !file.seek(recordPos - qint64(size)))
+        return {};
+    const auto directory = file.read(qint64(size));
+    if (directory.size() != qint64(size))
+        return {};
+
+    QStringList names;
+    qsizetype pos = 0;
+    for (quint64 i = 0; i < count; i++) {
+        if (pos + 46 > directory.size())
+            return {};
+        const char* header = directory.constData() + pos;
+        if (u32(header) != 0x02014b50)
+            return {};
+        const quint16 madeBy = u16(header + 4);
+        const quint16 flags = u16(header + 8);
+        const quint16 nameLength = u16(header + 28);
+        const qsizetype entrySize = 46 + nameLength + u16(header + 30) + u16(header + 32);
+        if (pos + entrySize > directory.size())
+            return {};
+
+        const auto name = QByteArrayView(header + 46, nameLength);
+        // names that are neither flagged as UTF-8 nor plain ASCII are in some legacy code page, leave those to libarchive
+        if (!(flags & 0x800) && !std::all_of(name.begin(), name.end(), [](char c) { return uchar(c) < 0x80; }))
+            return {};
+
+        bool isFile = !name.endsWith('/');
+        if ((madeBy >> 8) == 3) {
+            // made on Unix, the external attributes carry the file mode
+            const quint32 mode = u32(header + 38) >> 16;
+            if (mode != 0)
+                isFile = (mode & 0170000) == 0100000;
+        }
+        if (!onlyFiles || isFile)
+            names << QString::fromUtf8(name);
+        pos += entrySize;
+    }
+
+    return names;
+}
+
 ArchiveReader::File::File() : m_archive(ArchivePtr(archive_read_new(), archive_read_free)) {}
 }  // namespace MMCZip
@@ -21,6 +21,7 @@
 #include <QDateTime>
 #include <QStringList>
 #include <memory>
+#include <optional>
 
 struct archive;
 struct archive_entry;
@@ -63,6 +64,12 @@ class ArchiveReader {
     bool parse(std::function<bool(File*)>);
     bool parse(std::function<bool(File*, bool&)>);
 
+    /**
+     * Lists the entries of the zip at 'path' from its central directory, without walking through the archive.
+     * Returns nothing when it is not a zip, or one this can't read, for libarchive to go through instead.
+     */
+    static std::optional<QStringList> readCentralDirectory(const QString& path, bool onlyFiles);
+
    private:
     QString m_archivePath;
     size_t m_blockSize = 10240;
@@ -52,19 +52,45 @@ auto ExportToZipTask::exportZip() -> ZipResult
         if (m_buildZipFuture.isCanceled())
             return ZipResult();
 
-        auto absolute = file.absoluteFilePath();
-        auto relative = m_dir.relativeFilePath(absolute);
-        setStatus("Compressing: " + relative);
-        setProgress(m_progress + 1, m_progressTotal);
-        if (m_followSymlinks) {
-            if (file.isSymLink())
-                absolute = file.symLinkTarget();
-            else
-                absolute = file.canonicalFilePath();
+        auto relative = m_dir.relativeFilePath(file.absoluteFilePath());
+        if (m_deferredFiles.contains(relative)) {
+            m_heldBackFiles.append(file);
+            continue;
         }
+        if (auto result = addFile(file, relative); result.has_value())
+            return result;
+    }
+
+    // the held back files are added, and the archive closed, once it is known which of them to add
+    if (m_deferred)
+        return ZipResult();
+
+    if (!m_output.close()) {
+        return ZipResult(tr("A zip error occurred"));
+    }
+    return ZipResult();
+}
 
-        if (!m_excludeFiles.contains(relative) && !m_output.addFile(absolute, m_destinationPrefix + relative)) {
-            return ZipResult(tr("Could not read and compress %1").arg(relative));
+auto ExportToZipTask::completeZip() -> ZipResult
+{
+    for (const QFileInfo& file : m_heldBackFiles) {
+        if (m_buildZipFuture.isCanceled())
+            return ZipResult();
+
+        auto relative = m_dir.relativeFilePath(file.absoluteFilePath());
+        if (m_completion->excludeFiles.contains(relative)) {
+            setProgress(m_progress + 1, m_progressTotal);
+            continue;
+        }
+        if (auto result = addFile(file, relative); result.has_value())
+            return result;
+    }
+
+    for (auto it = m_completion->extraFiles.constBegin(); it != m_completion->extraFiles.constEnd(); it++) {
+        if (m_buildZipFuture.isCanceled())
+            return ZipResult();
+        if (!m_output.addFile(it.key(), it.value())) {
+            return ZipResult(tr("Could not add:") + it.key());
         }
     }
 
@@ -74,6 +100,42 @@ auto ExportToZipTask::exportZip() -> ZipResult
     return ZipResult();
 }
 
+auto ExportToZipTask::addFile(const QFileInfo& file, const QString& relative) -> ZipResult
+{
+    setStatus("Compressing: " + relative);
+    setProgress(m_progress + 1, m_progressTotal);
+
+    auto absolute = file.absoluteFilePath();
+    if (m_followSymlinks) {
+        if (file.isSymLink())
+            absolute = file.symLinkTarget();
+        else
+            absolute = file.canonicalFilePath();
+    }
+
+    if (!m_excludeFiles.contains(relative) && !m_output.addFile(absolute, m_destinationPrefix + relative)) {
+        return ZipResult(tr("Could not read and compress %1").arg(relative));
+    }
+    return ZipResult();
+}
+
+void ExportToZipTask::complete(QStringList excludeFiles, QHash<QString, QByteArray> extraFiles)
+{
+    m_completion = Completion{ QSet<QString>(excludeFiles.begin(), excludeFiles.end()), std::move(extraFiles) };
+    if (m_waitingForCompletion) {
+        m_waitingForCompletion = false;
+        startCompletion();
+    }
+}
+
+void ExportToZipTask::startCompletion()
+{
+    m_completing = true;
+    setStatus("Adding files...");
+    m_buildZipFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this]() { return completeZip(); });
+    m_buildZipWatcher.setFuture(m_buildZipFuture);
+}
+
 void ExportToZipTask::finish()
 {
     if (m_buildZipFuture.isCanceled()) {
@@ -82,6 +144,11 @@ void ExportToZipTask::finish()
     } else if (auto result = m_buildZipFuture.result(); result.has_value()) {
         FS::deletePath(m_outputPath);
         emitFailed(result.value());
+    } else if (m_deferred && !m_completing) {
+        if (m_completion)
+            startCompletion();
+        else
+            m_waitingForCompletion = true;
     } else {
         emitSucceeded();
     }
@@ -95,6 +162,13 @@ bool ExportToZipTask::abort()
         // immediately.
         return true;
     }
+    if (m_waitingForCompletion) {
+        m_waitingForCompletion = false;
+        m_output.close();
+        FS::deletePath(m_outputPath);
+        emitAborted();
+        return true;
+    }
     return false;
 }
 }  // namespace MMCZip
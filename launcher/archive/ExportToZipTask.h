@@ -21,6 +21,9 @@
 #include <QFileInfoList>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QSet>
+
+#include <optional>
 
 #include "archive/ArchiveWriter.h"
 #include "tasks/Task.h"
@@ -44,9 +47,21 @@ class ExportToZipTask : public Task {
 
     virtual ~ExportToZipTask() = default;
 
-    void setExcludeFiles(QStringList excludeFiles) { m_excludeFiles = excludeFiles; }
+    void setExcludeFiles(QStringList excludeFiles) { m_excludeFiles = QSet<QString>(excludeFiles.begin(), excludeFiles.end()); }
     void addExtraFile(QString fileName, QByteArray data) { m_extraFiles.insert(fileName, data); }
 
+    /**
+     * Holds back the files at the relative paths 'files' until complete() is called, so the rest of the archive can be written while
+     * it is still being worked out which of them belong in it. The task doesn't finish before complete() is called.
+     */
+    void setDeferredFiles(QStringList files)
+    {
+        m_deferredFiles = QSet<QString>(files.begin(), files.end());
+        m_deferred = true;
+    }
+    /** Adds the held back files but 'excludeFiles', and 'extraFiles', then closes the archive. */
+    void complete(QStringList excludeFiles, QHash<QString, QByteArray> extraFiles = {});
+
     using ZipResult = std::optional<QString>;
 
    protected:
@@ -54,6 +69,9 @@ class ExportToZipTask : public Task {
     bool abort() override;
 
     ZipResult exportZip();
+    ZipResult completeZip();
+    ZipResult addFile(const QFileInfo& file, const QString& relative);
+    void startCompletion();
     void finish();
 
    private:
@@ -63,9 +81,20 @@ class ExportToZipTask : public Task {
     QFileInfoList m_files;
     QString m_destinationPrefix;
     bool m_followSymlinks;
-    QStringList m_excludeFiles;
+    QSet<QString> m_excludeFiles;
     QHash<QString, QByteArray> m_extraFiles;
 
+    bool m_deferred = false;
+    QSet<QString> m_deferredFiles;
+    QFileInfoList m_heldBackFiles;
+    struct Completion {
+        QSet<QString> excludeFiles;
+        QHash<QString, QByteArray> extraFiles;
+    };
+    std::optional<Completion> m_completion;
+    bool m_waitingForCompletion = false;
+    bool m_completing = false;
+
     QFuture<ZipResult> m_buildZipFuture;
     QFutureWatcher<ZipResult> m_buildZipWatcher;
 };
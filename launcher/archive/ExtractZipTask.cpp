@@ -58,7 +58,7 @@ auto ExtractZipTask::extractZip() -> ZipResult
                 return false;
             setProgress(m_progress + 1, m_progressTotal);
             QString file_name = f->filename();
-            if (!file_name.startsWith(m_subdirectory)) {
+            if (!file_name.startsWith(m_subdirectory) || m_excludedFiles.contains(file_name)) {
                 f->skip();
                 return true;
             }
@@ -33,6 +33,9 @@ class ExtractZipTask : public Task {
     {}
     virtual ~ExtractZipTask() = default;
 
+    /** Archive entries to leave out, e.g. because they were already extracted. */
+    void setExcludedFiles(QStringList files) { m_excludedFiles = std::move(files); }
+
     using ZipResult = std::optional<QString>;
 
    protected:
@@ -46,6 +49,7 @@ class ExtractZipTask : public Task {
     ArchiveReader m_input;
     QDir m_outputDir;
     QString m_subdirectory;
+    QStringList m_excludedFiles;
 
     QFuture<ZipResult> m_zipFuture;
     QFutureWatcher<ZipResult> m_zipWatcher;
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "JavaCheckCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QStandardPaths>
+
+#include "FileSystem.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace JavaCheckCache {
+
+static const int CACHE_FORMAT_VERSION = 1;
+
+namespace {
+struct Entry {
+    Identity identity;
+    JavaChecker::Result result;
+};
+
+struct Cache {
+    QMutex mutex;
+    bool loaded = false;
+    QString path;
+    QHash<QString, Entry> entries;
+};
+
+Cache& cache()
+{
+    static Cache s_cache;
+    return s_cache;
+}
+
+QJsonObject toJson(const Entry& entry)
+{
+    QJsonObject obj;
+    obj["path"] = entry.identity.path;
+    obj["size"] = entry.identity.size;
+    obj["modified"] = entry.identity.modified;
+    obj["inode"] = QString::number(entry.identity.inode);
+    obj["version"] = entry.result.javaVersion.toString();
+    obj["vendor"] = entry.result.javaVendor;
+    obj["arch"] = entry.result.realPlatform;
+    obj["platform"] = entry.result.mojangPlatform;
+    obj["64bit"] = entry.result.is_64bit;
+    obj["output"] = entry.result.outLog;
+    return obj;
+}
+
+Entry fromJson(const QJsonObject& obj)
+{
+    Entry entry;
+    entry.identity.path = obj["path"].toString();
+    entry.identity.size = obj["size"].toInteger(-1);
+    entry.identity.modified = obj["modified"].toInteger(-1);
+    entry.identity.inode = obj["inode"].toString().toULongLong();
+    entry.result.javaVersion = obj["version"].toString();
+    entry.result.javaVendor = obj["vendor"].toString();
+    entry.result.realPlatform = obj["arch"].toString();
+    entry.result.mojangPlatform = obj["platform"].toString();
+    entry.result.is_64bit = obj["64bit"].toBool();
+    entry.result.outLog = obj["output"].toString();
+    entry.result.validity = JavaChecker::Result::Validity::Valid;
+    return entry;
+}
+
+// needs the cache mutex
+void load(Cache& c)
+{
+    if (c.loaded)
+        return;
+    c.loaded = true;
+    c.path = QDir("cache").absoluteFilePath("javacheck.json");
+    if (!QFileInfo::exists(c.path))
+        return;
+
+    QJsonParseError error;
+    QJsonDocument doc;
+    try {
+        doc = QJsonDocument::fromJson(FS::read(c.path), &error);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to read the Java check cache:" << e.cause();
+        return;
+    }
+    auto root = doc.object();
+    if (error.error != QJsonParseError::NoError || root["formatVersion"].toInt() != CACHE_FORMAT_VERSION) {
+        qWarning() << "Ignoring Java check cache" << c.path << "with unknown format";
+        return;
+    }
+    for (auto value : root["entries"].toArray()) {
+        auto entry = fromJson(value.toObject());
+        if (entry.identity.isValid())
+            c.entries.insert(entry.identity.path, entry);
+    }
+}
+
+// needs the cache mutex
+void save(Cache& c)
+{
+    QJsonArray entries;
+    for (auto& entry : c.entries)
+        entries.append(toJson(entry));
+    QJsonObject root;
+    root["formatVersion"] = CACHE_FORMAT_VERSION;
+    root["entries"] = entries;
+    try {
+        FS::write(c.path, QJsonDocument(root).toJson(QJsonDocument::Compact));
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write the Java check cache:" << e.cause();
+    }
+}
+}  // namespace
+
+Identity identify(const QString& javaPath)
+{
+    // the checker gets names like "java" too, resolve them the same way QProcess does
+    auto resolved = javaPath;
+    if (!javaPath.contains('/') && !javaPath.contains('\\'))
+        resolved = QStandardPaths::findExecutable(javaPath);
+    QFileInfo info(resolved);
+    auto canonical = info.canonicalFilePath();
+    if (canonical.isEmpty())
+        return {};
+
+    info = QFileInfo(canonical);
+    Identity identity;
+    identity.path = canonical;
+    identity.size = info.size();
+    identity.modified = info.lastModified().toMSecsSinceEpoch();
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(canonical).constData(), &st) == 0)
+        identity.inode = st.st_ino;
+#endif
+    return identity;
+}
+
+bool lookup(const Identity& identity, JavaChecker::Result& result)
+{
+    if (!identity.isValid())
+        return false;
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    load(c);
+    auto entry = c.entries.constFind(identity.path);
+    if (entry == c.entries.constEnd() || !(entry->identity == identity))
+        return false;
+
+    auto path = result.path;
+    auto id = result.id;
+    result = entry->result;
+    result.path = path;
+    result.id = id;
+    return true;
+}
+
+void store(const Identity& identity, const JavaChecker::Result& result)
+{
+    if (!identity.isValid() || result.validity != JavaChecker::Result::Validity::Valid)
+        return;
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    load(c);
+    Entry entry{ identity, result };
+    entry.result.errorLog.clear();
+    c.entries.insert(identity.path, entry);
+    save(c);
+}
+
+}  // namespace JavaCheckCache
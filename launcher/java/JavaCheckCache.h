@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QString>
+
+#include "java/JavaChecker.h"
+
+/**
+ * Results of the Java checker, kept on disk across runs.
+ *
+ * Results are keyed by the identity of the java binary the checked path resolves to, so a runtime is only checked again
+ * once it was replaced or updated. Only plain checks (no extra arguments or memory settings) that succeeded are cached.
+ */
+namespace JavaCheckCache {
+
+struct Identity {
+    QString path;  ///< canonical path of the binary, with symlinks resolved
+    qint64 size = -1;
+    qint64 modified = -1;
+    quint64 inode = 0;  ///< 0 where not available
+
+    bool isValid() const { return !path.isEmpty(); }
+    bool operator==(const Identity&) const = default;
+};
+
+Identity identify(const QString& javaPath);
+
+/** Fills in everything the checker reports about the binary, except for the path and id of the check. */
+bool lookup(const Identity& identity, JavaChecker::Result& result);
+
+void store(const Identity& identity, const JavaChecker::Result& result);
+
+}  // namespace JavaCheckCache
@@ -36,20 +36,138 @@
 #include "JavaChecker.h"
 
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QMap>
 #include <QProcess>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QtEndian>
 
 #include "Commandline.h"
 #include "FileSystem.h"
+#include "java/JavaCheckCache.h"
 #include "java/JavaUtils.h"
 
+namespace {
+bool is64BitArch(const QString& arch)
+{
+    return arch == "x86_64" || arch == "amd64" || arch == "aarch64" || arch == "arm64" || arch == "riscv64";
+}
+
+struct BinaryArch {
+    QString host;  ///< as in QSysInfo::currentCpuArchitecture()
+    QString jvm;   ///< as the JVM reports it in os.arch
+};
+
+// architecture of an ELF, PE or (thin) Mach-O executable
+BinaryArch readBinaryArch(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    auto header = file.read(64);
+    if (header.size() < 20)
+        return {};
+    auto bytes = reinterpret_cast<const uchar*>(header.constData());
+
+    if (header.startsWith("\x7f" "ELF")) {
+        bool is64 = bytes[4] == 2;
+        bool bigEndian = bytes[5] == 2;
+        auto machine = bigEndian ? qFromBigEndian<quint16>(bytes + 18) : qFromLittleEndian<quint16>(bytes + 18);
+        switch (machine) {
+            case 0x03:
+                return { "i386", "i386" };
+            case 0x28:
+                return { "arm", "arm" };
+            case 0x3E:
+                return { "x86_64", "amd64" };
+            case 0xB7:
+                return { "arm64", "aarch64" };
+            case 0xF3:
+                if (is64)
+                    return { "riscv64", "riscv64" };
+                break;
+        }
+        return {};
+    }
+
+    if (header.startsWith("MZ") && header.size() >= 0x40) {
+        auto peOffset = qFromLittleEndian<quint32>(bytes + 0x3C);
+        if (!file.seek(peOffset))
+            return {};
+        auto pe = file.read(6);
+        if (pe.size() < 6 || !pe.startsWith(QByteArray("PE\0\0", 4)))
+            return {};
+        switch (qFromLittleEndian<quint16>(pe.constData() + 4)) {
+            case 0x014C:
+                return { "i386", "x86" };
+            case 0x8664:
+                return { "x86_64", "amd64" };
+            case 0xAA64:
+                return { "arm64", "aarch64" };
+        }
+        return {};
+    }
+
+    // 64-bit Mach-O, universal binaries would need the JVM to tell which part runs
+    if (qFromLittleEndian<quint32>(bytes) == 0xFEEDFACF) {
+        switch (qFromLittleEndian<quint32>(bytes + 4)) {
+            case 0x01000007:
+                return { "x86_64", "x86_64" };
+            case 0x0100000C:
+                return { "arm64", "aarch64" };
+        }
+    }
+    return {};
+}
+
+// the KEY="value" lines of the release file in a Java home
+QMap<QString, QString> readReleaseFile(const QString& path)
+{
+    QMap<QString, QString> values;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return values;
+    for (auto line : QString::fromUtf8(file.readAll()).split('\n', Qt::SkipEmptyParts)) {
+        auto separator = line.indexOf('=');
+        if (separator <= 0)
+            continue;
+        auto value = line.mid(separator + 1).trimmed();
+        if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"'))
+            value = value.mid(1, value.size() - 2);
+        values.insert(line.left(separator).trimmed(), value);
+    }
+    return values;
+}
+}  // namespace
+
 JavaChecker::JavaChecker(QString path, QString args, int minMem, int maxMem, int permGen, int id)
     : Task(), m_path(path), m_args(args), m_minMem(minMem), m_maxMem(maxMem), m_permGen(permGen), m_id(id)
 {}
 
 void JavaChecker::executeTask()
 {
+    // extra arguments and memory settings may make the JVM fail to start, those always need a real check
+    m_cacheable = m_args.isEmpty() && m_minMem == 0 && m_maxMem == 0 && (m_permGen == 0 || m_permGen == 64);
+    if (m_cacheable) {
+        Result result = { m_path, m_id };
+        if (JavaCheckCache::lookup(JavaCheckCache::identify(m_path), result)) {
+            qDebug() << "Using cached Java checker result for" << m_path;
+            emit checkFinished(result);
+            emitSucceeded();
+            return;
+        }
+        if (probe(m_path, result)) {
+            qDebug() << "Identified" << m_path << "as Java" << result.javaVersion.toString() << result.realPlatform << "without running it";
+            emit checkFinished(result);
+            emitSucceeded();
+            return;
+        }
+        qDebug() << "Running" << m_path << "to check it:" << result.outLog;
+    }
+
     QString checkerJar = JavaUtils::getJavaCheckPath();
 
     if (checkerJar.isEmpty()) {
@@ -94,6 +212,65 @@ void JavaChecker::executeTask()
     process->start();
 }
 
+bool JavaChecker::probe(const QString& path, Result& result)
+{
+    // why the JVM has to be asked after all, shown as the output of the probe
+    auto inconclusive = [&result](const QString& reason) {
+        result.outLog = reason;
+        return false;
+    };
+
+    auto binary = path;
+    if (!path.contains('/') && !path.contains('\\'))
+        binary = QStandardPaths::findExecutable(path);
+    binary = QFileInfo(binary).canonicalFilePath();
+    if (binary.isEmpty())
+        return inconclusive(QString("%1 was not found").arg(path));
+
+    // <home>/bin/java, for Java 8 JDKs also <jdk>/jre/bin/java with the release file in <jdk>
+    QDir home = QFileInfo(binary).dir();
+    if (home.dirName() != "bin" || !home.cdUp())
+        return inconclusive(QString("%1 is not in the bin folder of a Java home").arg(binary));
+    auto releasePath = home.filePath("release");
+    auto release = readReleaseFile(releasePath);
+    if (release.isEmpty() && home.dirName() == "jre" && home.cdUp()) {
+        releasePath = home.filePath("release");
+        release = readReleaseFile(releasePath);
+    }
+    if (release.isEmpty())
+        return inconclusive(QString("The Java home of %1 has no release file").arg(binary));
+
+    auto version = release.value("JAVA_VERSION");
+    auto vendor = release.value("IMPLEMENTOR");
+    if (version.isEmpty() || vendor.isEmpty())
+        return inconclusive(QString("%1 does not name the Java version and vendor").arg(releasePath));
+
+    // only trust the header for binaries that run natively, anything else may not start at all
+    auto arch = readBinaryArch(binary);
+    auto host = QSysInfo::currentCpuArchitecture();
+    if (arch.host.isEmpty())
+        return inconclusive(QString("The architecture of %1 could not be read from its header").arg(binary));
+#ifdef Q_OS_WIN
+    bool runs = arch.host == host || (arch.host == "i386" && host == "x86_64");
+#else
+    bool runs = arch.host == host;
+#endif
+    if (!runs)
+        return inconclusive(QString("%1 is built for %2, not for %3").arg(binary, arch.host, host));
+
+    bool is_64 = is64BitArch(arch.jvm);
+    result.validity = Result::Validity::Valid;
+    result.is_64bit = is_64;
+    result.mojangPlatform = is_64 ? "64" : "32";
+    result.realPlatform = arch.jvm;
+    result.javaVersion = version;
+    result.javaVendor = vendor;
+    // what the checker would have printed, and where it came from instead
+    result.outLog = QString("Identified from %1 and the header of %2 without running it\n").arg(releasePath, binary) +
+                    QString("os.arch=%1\njava.version=%2\njava.vendor=%3\n").arg(arch.jvm, version, vendor);
+    return true;
+}
+
 void JavaChecker::stdoutReady()
 {
     QByteArray data = process->readAllStandardOutput();
@@ -163,7 +340,7 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
     auto os_arch = results["os.arch"];
     auto java_version = results["java.version"];
     auto java_vendor = results["java.vendor"];
-    bool is_64 = os_arch == "x86_64" || os_arch == "amd64" || os_arch == "aarch64" || os_arch == "arm64" || os_arch == "riscv64";
+    bool is_64 = is64BitArch(os_arch);
 
     result.validity = Result::Validity::Valid;
     result.is_64bit = is_64;
@@ -172,6 +349,9 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
     result.javaVersion = java_version;
     result.javaVendor = java_vendor;
     qDebug() << "Java checker succeeded.";
+    if (m_cacheable) {
+        JavaCheckCache::store(JavaCheckCache::identify(m_path), result);
+    }
     emit checkFinished(result);
     emitSucceeded();
 }
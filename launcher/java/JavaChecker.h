@@ -27,6 +27,12 @@ class JavaChecker : public Task {
 
     explicit JavaChecker(QString path, QString args, int minMem = 0, int maxMem = 0, int permGen = 0, int id = 0);
 
+    /**
+     * Identify the runtime of the java binary at 'path' without starting it, from the release file of its Java home
+     * and the header of the executable. Returns false when that is not conclusive and the JVM has to be asked.
+     */
+    static bool probe(const QString& path, Result& result);
+
    signals:
     void checkFinished(const Result& result);
 
@@ -45,6 +51,8 @@ class JavaChecker : public Task {
     int m_maxMem = 0;
     int m_permGen = 64;
     int m_id = 0;
+    // set for checks whose result can be cached
+    bool m_cacheable = false;
 
    private slots:
     void timeout();
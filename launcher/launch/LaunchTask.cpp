@@ -206,6 +206,7 @@ shared_qobject_ptr<LogModel> LaunchTask::getLogModel()
         m_logModel.reset(new LogModel());
         m_logModel->setMaxLines(getConsoleMaxLines(m_instance->settings()));
         m_logModel->setStopOnOverflow(shouldStopOnConsoleOverflow(m_instance->settings()));
+        m_logModel->setUnlimitedScrollback(shouldKeepConsoleScrollback(m_instance->settings()));
         // FIXME: should this really be here?
         m_logModel->setOverflowMessage(tr("Stopped watching the game log because the log length surpassed %1 lines.\n"
                                           "You may have to fix your mods because the game is still logging to files and"
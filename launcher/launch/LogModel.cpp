@@ -1,5 +1,8 @@
 #include "LogModel.h"
 
+#include <algorithm>
+#include <limits>
+
 LogModel::LogModel(QObject* parent) : QAbstractListModel(parent)
 {
     m_content.resize(m_maxLines);
@@ -10,15 +13,26 @@ int LogModel::rowCount(const QModelIndex& parent) const
     if (parent.isValid())
         return 0;
 
-    return m_numLines;
+    // append() stops spilling to the scrollback before the rows run out of int
+    return static_cast<int>(std::min<qint64>(m_scrollback.size() + m_numLines, std::numeric_limits<int>::max()));
 }
 
 QVariant LogModel::data(const QModelIndex& index, int role) const
 {
-    if (index.row() < 0 || index.row() >= m_numLines)
+    if (index.row() < 0 || index.row() >= rowCount())
         return QVariant();
 
     auto row = index.row();
+    if (row < m_scrollback.size()) {
+        if (role == Qt::DisplayRole || role == Qt::EditRole) {
+            return m_scrollback.line(row);
+        }
+        if (role == LevelRole) {
+            return static_cast<int>(m_scrollback.level(row));
+        }
+        return QVariant();
+    }
+    row -= m_scrollback.size();
     auto realRow = (row + m_firstLine) % m_maxLines;
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
         return m_content[realRow].line;
@@ -37,26 +51,46 @@ void LogModel::append(MessageLevel level, QString line)
     }
     int lineNum = (m_firstLine + m_numLines) % m_maxLines;
     // overflow
-    if (m_numLines == m_maxLines) {
+    if (m_numLines == m_maxLines && m_unlimitedScrollback && rowCount() < std::numeric_limits<int>::max() && m_scrollback.open()) {
+        // the oldest line moves to disk, its row stays where it is
+        spillOldest();
+    } else if (m_numLines == m_maxLines) {
         if (m_stopOnOverflow) {
             // nothing more to do, the buffer is full
             return;
         }
-        beginRemoveRows(QModelIndex(), 0, 0);
+        auto first = static_cast<int>(m_scrollback.size());
+        beginRemoveRows(QModelIndex(), first, first);
         m_firstLine = (m_firstLine + 1) % m_maxLines;
         m_numLines--;
+        if (m_search)
+            m_search->linesRemoved(first, 1);
         endRemoveRows();
-    } else if (m_numLines == m_maxLines - 1 && m_stopOnOverflow) {
+    } else if (m_numLines == m_maxLines - 1 && m_stopOnOverflow && !m_unlimitedScrollback) {
         level = MessageLevel::Fatal;
         line = m_overflowMessage;
     }
-    beginInsertRows(QModelIndex(), m_numLines, m_numLines);
+    auto newRow = static_cast<int>(m_scrollback.size()) + m_numLines;
+    beginInsertRows(QModelIndex(), newRow, newRow);
     m_numLines++;
     m_content[lineNum].level = level;
     m_content[lineNum].line = line;
+    if (m_search)
+        m_search->lineAppended(level, line);
     endInsertRows();
 }
 
+void LogModel::spillOldest()
+{
+    auto& oldest = m_content[m_firstLine];
+    m_scrollback.append(oldest.level, oldest.line);
+    oldest.line.clear();
+    m_firstLine = (m_firstLine + 1) % m_maxLines;
+    m_numLines--;
+    if (m_search)
+        m_search->linesSpilled(1);
+}
+
 void LogModel::suspend(bool suspend)
 {
     m_suspended = suspend;
@@ -72,13 +106,19 @@ void LogModel::clear()
     beginResetModel();
     m_firstLine = 0;
     m_numLines = 0;
+    m_scrollback.clear();
+    if (m_search)
+        m_search->clear();
     endResetModel();
 }
 
 QString LogModel::toPlainText()
 {
     QString out;
-    out.reserve(m_numLines * 80);
+    out.reserve(rowCount() * 80);
+    for (qint64 i = 0; i < m_scrollback.size(); i++) {
+        out.append(m_scrollback.line(i) + '\n');
+    }
     for (int i = 0; i < m_numLines; i++) {
         QString& line = m_content[(m_firstLine + i) % m_maxLines].line;
         out.append(line + '\n');
@@ -93,8 +133,8 @@ void LogModel::setMaxLines(int maxLines)
     if (maxLines == m_maxLines) {
         return;
     }
-    // if it all still fits in the buffer, just resize it
-    if (m_firstLine + m_numLines < m_maxLines) {
+    // if it all still fits in the buffer, without wrapping before or after, just resize it
+    if (m_firstLine + m_numLines < std::min(m_maxLines, maxLines + 1)) {
         m_maxLines = maxLines;
         m_content.resize(maxLines);
         return;
@@ -108,15 +148,28 @@ void LogModel::setMaxLines(int maxLines)
             newContent[i] = m_content[(m_firstLine + i) % m_maxLines];
         }
         m_content.swap(newContent);
+    } else if (m_unlimitedScrollback && m_scrollback.open()) {
+        // if it doesn't fit, the oldest log messages move to the scrollback, rows don't change
+        int lead = m_numLines - maxLines;
+        for (int i = 0; i < lead; i++) {
+            spillOldest();
+        }
+        for (int i = 0; i < maxLines; i++) {
+            newContent[i] = m_content[(m_firstLine + i) % m_maxLines];
+        }
+        m_content.swap(newContent);
     } else {
         // if it doesn't fit, part of the data needs to be thrown away (the oldest log messages)
         int lead = m_numLines - maxLines;
-        beginRemoveRows(QModelIndex(), 0, lead - 1);
+        auto first = static_cast<int>(m_scrollback.size());
+        beginRemoveRows(QModelIndex(), first, first + lead - 1);
         for (int i = 0; i < maxLines; i++) {
             newContent[i] = m_content[(m_firstLine + lead + i) % m_maxLines];
         }
-        m_numLines = m_maxLines;
+        m_numLines = maxLines;
         m_content.swap(newContent);
+        if (m_search)
+            m_search->linesRemoved(first, lead);
         endRemoveRows();
     }
     m_firstLine = 0;
@@ -164,13 +217,40 @@ bool LogModel::colorLines() const
 
 bool LogModel::isOverFlow()
 {
-    return m_numLines >= m_maxLines && m_stopOnOverflow;
+    return m_numLines >= m_maxLines && m_stopOnOverflow && !m_unlimitedScrollback;
+}
+
+void LogModel::setUnlimitedScrollback(bool unlimited)
+{
+    m_unlimitedScrollback = unlimited;
+}
+
+bool LogModel::unlimitedScrollback() const
+{
+    return m_unlimitedScrollback;
 }
 
 MessageLevel LogModel::previousLevel()
 {
     if (m_numLines > 0) {
-        return m_content[m_numLines - 1].level;
+        return m_content[(m_firstLine + m_numLines - 1) % m_maxLines].level;
+    }
+    if (m_scrollback.size() > 0) {
+        return m_scrollback.level(m_scrollback.size() - 1);
     }
     return MessageLevel::Unknown;
 }
+
+LogSearch* LogModel::search()
+{
+    if (!m_search) {
+        m_search = new LogSearch(this);
+        // the scrollback is read from disk by the searches themselves, only the lines in memory are indexed here
+        m_search->setScrollback(&m_scrollback);
+        for (int i = 0; i < m_numLines; i++) {
+            auto& line = m_content[(m_firstLine + i) % m_maxLines];
+            m_search->lineAppended(line.level, line.line);
+        }
+    }
+    return m_search;
+}
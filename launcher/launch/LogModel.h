@@ -2,6 +2,8 @@
 
 #include <QAbstractListModel>
 #include <QString>
+#include "LogScrollback.h"
+#include "LogSearch.h"
 #include "MessageLevel.h"
 
 class LogModel : public QAbstractListModel {
@@ -25,6 +27,9 @@ class LogModel : public QAbstractListModel {
     void setStopOnOverflow(bool stop);
     void setOverflowMessage(const QString& overflowMessage);
     bool isOverFlow();
+    /// keep lines that fall out of the in-memory window in an on-disk scrollback instead of dropping them
+    void setUnlimitedScrollback(bool unlimited);
+    bool unlimitedScrollback() const;
 
     void setLineWrap(bool state);
     bool wrapLines() const;
@@ -33,6 +38,9 @@ class LogModel : public QAbstractListModel {
 
     MessageLevel previousLevel();
 
+    /// search service that follows this model, created on first use
+    LogSearch* search();
+
     enum Roles { LevelRole = Qt::UserRole };
 
    private /* types */:
@@ -41,6 +49,8 @@ class LogModel : public QAbstractListModel {
         QString line;
     };
 
+    void spillOldest();
+
    private: /* data */
     QList<entry> m_content;
     int m_maxLines = 1000;
@@ -49,6 +59,10 @@ class LogModel : public QAbstractListModel {
     // number of lines occupied in the circular buffer
     int m_numLines = 0;
     bool m_stopOnOverflow = false;
+    bool m_unlimitedScrollback = false;
+    // lines evicted from the circular buffer, they come before it in row order
+    LogScrollback m_scrollback;
+    LogSearch* m_search = nullptr;
     QString m_overflowMessage = "OVERFLOW";
     bool m_suspended = false;
     bool m_lineWrap = true;
@@ -0,0 +1,179 @@
+#include "LogScrollback.h"
+
+#include <QDebug>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+// each index record is the start offset of the line in the data file followed by the level
+constexpr qint64 RecordSize = sizeof(quint64) + sizeof(quint8);
+}  // namespace
+
+bool LogScrollback::isOpen() const
+{
+    return m_data.isOpen() && m_index.isOpen();
+}
+
+bool LogScrollback::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+    if (!m_data.open() || !m_index.open()) {
+        qWarning() << "Failed to create console scrollback files:" << m_data.errorString() << m_index.errorString();
+        m_data.close();
+        m_index.close();
+        return false;
+    }
+    return true;
+}
+
+void LogScrollback::clear()
+{
+    m_lineCache.clear();
+    m_numLines = 0;
+    m_dataSize = 0;
+    m_dirty = false;
+    if (isOpen()) {
+        m_data.resize(0);
+        m_index.resize(0);
+        m_data.seek(0);
+        m_index.seek(0);
+    }
+}
+
+void LogScrollback::append(MessageLevel level, const QString& line)
+{
+    if (!isOpen()) {
+        return;
+    }
+    auto utf8 = line.toUtf8();
+
+    char record[RecordSize];
+    qToLittleEndian<quint64>(static_cast<quint64>(m_dataSize), record);
+    record[sizeof(quint64)] = static_cast<char>(static_cast<quint8>(static_cast<int>(level)));
+
+    m_data.seek(m_dataSize);
+    m_index.seek(m_numLines * RecordSize);
+    if (m_data.write(utf8) != utf8.size() || m_index.write(record, RecordSize) != RecordSize) {
+        qWarning() << "Failed to write console scrollback:" << m_data.errorString() << m_index.errorString();
+        return;
+    }
+    m_dataSize += utf8.size();
+    m_numLines++;
+    m_dirty = true;
+}
+
+void LogScrollback::flush() const
+{
+    if (m_dirty) {
+        m_data.flush();
+        m_index.flush();
+        m_dirty = false;
+    }
+}
+
+LogScrollback::Record LogScrollback::record(qint64 row) const
+{
+    Record result;
+    if (row < 0 || row >= m_numLines) {
+        return result;
+    }
+    flush();
+
+    // read this record and the start offset of the next one, which is the end of this line
+    char buf[RecordSize + sizeof(quint64)];
+    qint64 wanted = row + 1 < m_numLines ? sizeof(buf) : RecordSize;
+    m_index.seek(row * RecordSize);
+    if (m_index.read(buf, wanted) != wanted) {
+        return result;
+    }
+    result.offset = static_cast<qint64>(qFromLittleEndian<quint64>(buf));
+    result.level = static_cast<MessageLevel::Enum>(static_cast<quint8>(buf[sizeof(quint64)]));
+    auto end = row + 1 < m_numLines ? static_cast<qint64>(qFromLittleEndian<quint64>(buf + RecordSize)) : m_dataSize;
+    result.length = end - result.offset;
+    return result;
+}
+
+QString LogScrollback::line(qint64 row) const
+{
+    if (auto cached = m_lineCache.object(row)) {
+        return *cached;
+    }
+    auto rec = record(row);
+    if (rec.length <= 0) {
+        return {};
+    }
+    m_data.seek(rec.offset);
+    auto text = QString::fromUtf8(m_data.read(rec.length));
+    m_lineCache.insert(row, new QString(text));
+    return text;
+}
+
+MessageLevel LogScrollback::level(qint64 row) const
+{
+    return record(row).level;
+}
+
+LogScrollback::Reader LogScrollback::reader() const
+{
+    Reader reader;
+    if (!isOpen()) {
+        return reader;
+    }
+    flush();
+    reader.m_dataPath = m_data.fileName();
+    reader.m_indexPath = m_index.fileName();
+    reader.m_numLines = m_numLines;
+    reader.m_dataSize = m_dataSize;
+    return reader;
+}
+
+bool LogScrollback::Reader::read(qint64 first, qint64 count, const Callback& callback)
+{
+    count = std::min(count, m_numLines - first);
+    if (first < 0 || count <= 0) {
+        return count == 0;
+    }
+    if (!m_data) {
+        m_data = std::make_shared<QFile>(m_dataPath);
+        m_index = std::make_shared<QFile>(m_indexPath);
+        if (!m_data->open(QIODevice::ReadOnly) || !m_index->open(QIODevice::ReadOnly)) {
+            qWarning() << "Failed to read console scrollback:" << m_data->errorString() << m_index->errorString();
+            return false;
+        }
+    }
+
+    // the records of the lines, and the start of the one after them, which is the end of the last line
+    const bool last = first + count == m_numLines;
+    const qint64 wanted = count * RecordSize + (last ? 0 : sizeof(quint64));
+    if (!m_index->seek(first * RecordSize)) {
+        return false;
+    }
+    auto records = m_index->read(wanted);
+    if (records.size() != wanted) {
+        return false;
+    }
+    auto offset = [&records](qint64 i) { return static_cast<qint64>(qFromLittleEndian<quint64>(records.constData() + i * RecordSize)); };
+    const auto start = offset(0);
+    const auto end = last ? m_dataSize : offset(count);
+    if (start < 0 || end < start || !m_data->seek(start)) {
+        return false;
+    }
+    auto data = m_data->read(end - start);
+    if (data.size() != end - start) {
+        return false;
+    }
+
+    for (qint64 i = 0; i < count; i++) {
+        auto lineStart = offset(i) - start;
+        auto lineEnd = i + 1 < count ? offset(i + 1) - start : data.size();
+        if (lineStart < 0 || lineEnd < lineStart || lineEnd > data.size()) {
+            return false;
+        }
+        auto level = static_cast<MessageLevel::Enum>(static_cast<quint8>(records.at(i * RecordSize + sizeof(quint64))));
+        callback(level, QByteArray::fromRawData(data.constData() + lineStart, lineEnd - lineStart));
+    }
+    return true;
+}
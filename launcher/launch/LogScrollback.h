@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QFile>
+#include <QString>
+#include <QTemporaryFile>
+
+#include <functional>
+#include <memory>
+
+#include "MessageLevel.h"
+
+/**
+ * Append-only on-disk store for log lines that fell out of the LogModel's in-memory window.
+ *
+ * Line text is written as UTF-8 to a data file, and every line gets a fixed size record
+ * (offset into the data file + level byte) in an index file, so any line can be found with a
+ * single seek. Only a small cache of recently read lines is kept in memory.
+ */
+class LogScrollback {
+   public:
+    /**
+     * Reads the lines that were in the scrollback when it was made, in chunks, through its own handles to the files.
+     * It may be used on another thread while lines are appended, but not once the scrollback was cleared.
+     */
+    class Reader {
+       public:
+        using Callback = std::function<void(MessageLevel level, const QByteArray& utf8)>;
+
+        qint64 size() const { return m_numLines; }
+        /// calls `callback` for the lines [first, first + count), returns false if they could not be read
+        bool read(qint64 first, qint64 count, const Callback& callback);
+
+       private:
+        friend class LogScrollback;
+        QString m_dataPath;
+        QString m_indexPath;
+        qint64 m_numLines = 0;
+        qint64 m_dataSize = 0;
+        std::shared_ptr<QFile> m_data;
+        std::shared_ptr<QFile> m_index;
+    };
+
+    LogScrollback() = default;
+
+    bool isOpen() const;
+    bool open();
+    void clear();
+
+    qint64 size() const { return m_numLines; }
+
+    void append(MessageLevel level, const QString& line);
+    QString line(qint64 row) const;
+    MessageLevel level(qint64 row) const;
+    /// a reader for the lines written so far
+    Reader reader() const;
+
+   private:
+    struct Record {
+        qint64 offset = 0;
+        qint64 length = 0;
+        MessageLevel level = MessageLevel::Unknown;
+    };
+    Record record(qint64 row) const;
+    void flush() const;
+
+   private:
+    mutable QTemporaryFile m_data;
+    mutable QTemporaryFile m_index;
+    mutable QCache<qint64, QString> m_lineCache{ 512 };
+    mutable bool m_dirty = false;
+    qint64 m_numLines = 0;
+    qint64 m_dataSize = 0;
+};
@@ -0,0 +1,392 @@
+#include "LogSearch.h"
+
+#include <QDebug>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr qsizetype LinesPerBlock = 4096;
+// lines of the scrollback read from disk at once
+constexpr qint64 ScrollbackChunk = 4096;
+// matches are handed to the GUI thread in batches of this size
+constexpr qsizetype BatchSize = 256;
+
+QByteArray fold(const QString& line)
+{
+    auto folded = line.toLower().toUtf8();
+    // lines are separated by newlines in the blocks, a match never spans lines
+    folded.replace('\n', ' ');
+    return folded;
+}
+
+quint32 levelBit(MessageLevel level)
+{
+    return 1u << static_cast<int>(level);
+}
+
+// memchr for the first byte of the needle is vectorized by the C library, only candidates get compared in full
+const char* findBytes(const char* haystack, qsizetype length, const QByteArray& needle)
+{
+    const auto size = needle.size();
+    if (size == 0 || length < size) {
+        return nullptr;
+    }
+    const char first = needle.front();
+    const char* end = haystack + length - size + 1;
+    while (haystack < end) {
+        auto candidate = static_cast<const char*>(std::memchr(haystack, first, end - haystack));
+        if (!candidate) {
+            return nullptr;
+        }
+        if (std::memcmp(candidate + 1, needle.constData() + 1, size - 1) == 0) {
+            return candidate;
+        }
+        haystack = candidate + 1;
+    }
+    return nullptr;
+}
+
+void scanBlock(const LogSearch::Block& block, const QByteArray& needle, quint32 levelMask, qint64 firstId, QList<qint64>& out)
+{
+    const auto count = block.starts.size();
+    // skip lines that were removed from the model since the snapshot was taken
+    qsizetype line = std::clamp<qint64>(firstId - block.firstId, 0, count);
+    if (needle.isEmpty()) {
+        for (; line < count; line++) {
+            if (levelMask & (1u << block.levels[line])) {
+                out.append(block.firstId + line);
+            }
+        }
+        return;
+    }
+    const char* data = block.text.constData();
+    const qsizetype size = block.text.size();
+    qsizetype pos = line < count ? block.starts[line] : size;
+    while (pos < size) {
+        auto hit = findBytes(data + pos, size - pos, needle);
+        if (!hit) {
+            break;
+        }
+        auto offset = hit - data;
+        line = std::distance(block.starts.cbegin(), std::upper_bound(block.starts.cbegin(), block.starts.cend(), offset)) - 1;
+        if (levelMask & (1u << block.levels[line])) {
+            out.append(block.firstId + line);
+        }
+        pos = line + 1 < count ? block.starts[line + 1] : size;
+    }
+}
+}  // namespace
+
+LogSearch::LogSearch(QObject* parent) : QObject(parent) {}
+
+LogSearch::~LogSearch()
+{
+    cancel();
+    m_future.waitForFinished();
+}
+
+bool LogSearch::isRunning() const
+{
+    return m_future.isRunning();
+}
+
+void LogSearch::cancel()
+{
+    if (m_canceled) {
+        *m_canceled = true;
+        m_canceled.reset();
+    }
+    m_generation++;
+    m_active = false;
+    m_matches.clear();
+}
+
+void LogSearch::start(const Query& query)
+{
+    cancel();
+    m_needle = fold(query.text);
+    m_levelMask = 0;
+    for (auto level : query.levels) {
+        m_levelMask |= levelBit(level);
+    }
+    if (m_levelMask == 0) {
+        m_levelMask = ~0u;
+    }
+    if (m_needle.isEmpty() && m_levelMask == ~0u) {
+        // nothing to look for
+        emit finished();
+        return;
+    }
+    m_active = true;
+
+    // the scrollback is only ever appended to, the lines in it now can be read while more are spilled
+    LogScrollback::Reader reader;
+    if (m_scrollback && m_scrollbackLines > 0) {
+        reader = m_scrollback->reader();
+    }
+    auto scrollbackLines = std::min(reader.size(), m_scrollbackLines);
+
+    // full blocks never change, the one still being filled is copied
+    std::vector<std::shared_ptr<const Block>> snapshot(m_blocks.begin(), m_blocks.end());
+    if (!snapshot.empty() && snapshot.back()->starts.size() < LinesPerBlock) {
+        snapshot.back() = std::make_shared<const Block>(*snapshot.back());
+    }
+
+    auto generation = m_generation;
+    auto canceled = m_canceled = std::make_shared<std::atomic_bool>(false);
+    auto needle = m_needle;
+    auto levelMask = m_levelMask;
+    auto firstId = m_firstId;
+    m_future = QtConcurrent::run(QThreadPool::globalInstance(), [this, reader, scrollbackLines, snapshot, canceled, needle, levelMask,
+                                                                  firstId, generation]() mutable {
+        QList<qint64> batch;
+        // rows of the scrollback, then ids of the lines in memory
+        auto deliver = [this, &batch, generation](bool scrollback) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, found = std::move(batch), generation, scrollback] {
+                    if (generation != m_generation) {
+                        return;
+                    }
+                    if (scrollback) {
+                        addScrollbackMatches(found);
+                    } else {
+                        addMatches(found);
+                    }
+                },
+                Qt::QueuedConnection);
+            batch = {};
+        };
+        for (qint64 first = 0; first < scrollbackLines; first += ScrollbackChunk) {
+            if (*canceled) {
+                return;
+            }
+            auto row = first;
+            auto read = reader.read(first, ScrollbackChunk, [&](MessageLevel level, const QByteArray& utf8) {
+                if (levelMask & levelBit(level)) {
+                    auto folded = needle.isEmpty() ? QByteArray() : fold(QString::fromUtf8(utf8));
+                    if (needle.isEmpty() || findBytes(folded.constData(), folded.size(), needle)) {
+                        batch.append(row);
+                    }
+                }
+                row++;
+            });
+            if (!read) {
+                qWarning() << "Failed to search the console scrollback";
+                break;
+            }
+            if (batch.size() >= BatchSize) {
+                deliver(true);
+            }
+        }
+        deliver(true);
+        for (const auto& block : snapshot) {
+            if (*canceled) {
+                return;
+            }
+            scanBlock(*block, needle, levelMask, firstId, batch);
+            if (batch.size() >= BatchSize) {
+                deliver(false);
+            }
+        }
+        deliver(false);
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation] {
+                if (generation == m_generation) {
+                    emit finished();
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void LogSearch::addMatches(const QList<qint64>& ids)
+{
+    QList<int> rows;
+    QList<qint64> found;
+    rows.reserve(ids.size());
+    found.reserve(ids.size());
+    // lines in memory when the scan started may have been spilled or removed since
+    for (auto id : ids) {
+        auto row = rowOf(id);
+        if (row >= 0) {
+            rows.append(static_cast<int>(row));
+            found.append(id);
+        }
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+    // results from the scan are older than any line matched live, so they go in front of those
+    auto pos = std::lower_bound(m_matches.begin(), m_matches.end(), found.front());
+    auto index = std::distance(m_matches.begin(), pos);
+    for (auto id : found) {
+        m_matches.insert(index++, id);
+    }
+    emit matchesFound(rows);
+}
+
+void LogSearch::addScrollbackMatches(const QList<qint64>& rows)
+{
+    QList<qint64> ids;
+    ids.reserve(rows.size());
+    for (auto row : rows) {
+        ids.append(idOf(row));
+    }
+    addMatches(ids);
+}
+
+qint64 LogSearch::rowOf(qint64 id) const
+{
+    if (id >= m_firstId) {
+        return id < m_nextId ? m_scrollbackLines + id - m_firstId : -1;
+    }
+    // the last run starting at or before the id
+    auto next = std::upper_bound(m_runs.cbegin(), m_runs.cend(), id, [](qint64 id, const Run& run) { return id < run.firstId; });
+    if (next == m_runs.cbegin()) {
+        return -1;
+    }
+    auto& run = *std::prev(next);
+    auto row = run.row + id - run.firstId;
+    auto end = next != m_runs.cend() ? next->row : m_scrollbackLines;
+    return row < end ? row : -1;
+}
+
+qint64 LogSearch::idOf(qint64 row) const
+{
+    if (row >= m_scrollbackLines) {
+        return m_firstId + row - m_scrollbackLines;
+    }
+    auto next = std::upper_bound(m_runs.cbegin(), m_runs.cend(), row, [](qint64 row, const Run& run) { return row < run.row; });
+    if (next == m_runs.cbegin()) {
+        return -1;
+    }
+    auto& run = *std::prev(next);
+    return run.firstId + row - run.row;
+}
+
+bool LogSearch::lineMatches(const QByteArray& folded, MessageLevel level) const
+{
+    if (!(m_levelMask & levelBit(level))) {
+        return false;
+    }
+    return m_needle.isEmpty() || findBytes(folded.constData(), folded.size(), m_needle);
+}
+
+void LogSearch::lineAppended(MessageLevel level, const QString& line)
+{
+    auto folded = fold(line);
+    if (m_blocks.empty() || m_blocks.back()->starts.size() >= LinesPerBlock) {
+        auto block = std::make_shared<Block>();
+        block->firstId = m_nextId;
+        block->text.reserve(LinesPerBlock * 100);
+        m_blocks.push_back(block);
+    }
+    auto& block = *m_blocks.back();
+    block.starts.append(block.text.size());
+    block.levels.append(static_cast<quint8>(static_cast<int>(level)));
+    block.text.append(folded);
+    block.text.append('\n');
+    if (block.starts.size() == LinesPerBlock) {
+        block.text.squeeze();
+    }
+
+    auto id = m_nextId++;
+    if (m_active && lineMatches(folded, level)) {
+        m_matches.append(id);
+        emit matchesFound({ static_cast<int>(rowOf(id)) });
+    }
+}
+
+void LogSearch::setScrollback(const LogScrollback* scrollback)
+{
+    m_scrollback = scrollback;
+    m_scrollbackLines = scrollback ? scrollback->size() : 0;
+    // the lines that are on disk already get the first ids
+    m_runs.clear();
+    if (m_scrollbackLines > 0) {
+        m_runs.append({ 0, 0 });
+    }
+    m_firstId = m_nextId = m_scrollbackLines;
+}
+
+void LogSearch::linesSpilled(int count)
+{
+    count = static_cast<int>(std::min<qint64>(count, m_nextId - m_firstId));
+    if (count <= 0) {
+        return;
+    }
+    // the ids go on where the last run ends, unless lines were removed in between
+    if (m_runs.isEmpty() || m_runs.back().firstId + m_scrollbackLines - m_runs.back().row != m_firstId) {
+        m_runs.append({ m_scrollbackLines, m_firstId });
+    }
+    m_scrollbackLines += count;
+    m_firstId += count;
+    dropBlocks();
+}
+
+void LogSearch::linesRemoved(int first, int count)
+{
+    // the lines in memory keep consecutive ids, so only the oldest of them can go
+    Q_ASSERT(first == m_scrollbackLines);
+    auto firstId = idOf(first);
+    auto endId = std::min(firstId + count, m_nextId);
+    auto from = std::lower_bound(m_matches.begin(), m_matches.end(), firstId);
+    auto to = std::lower_bound(from, m_matches.end(), endId);
+    m_matches.erase(from, to);
+    m_firstId = std::max(m_firstId, endId);
+    dropBlocks();
+}
+
+void LogSearch::dropBlocks()
+{
+    while (!m_blocks.empty() && m_blocks.front()->firstId + m_blocks.front()->starts.size() <= m_firstId) {
+        m_blocks.erase(m_blocks.begin());
+    }
+}
+
+void LogSearch::clear()
+{
+    // a running scan would report lines that are gone
+    bool scanning = m_active && m_future.isRunning();
+    if (m_canceled) {
+        *m_canceled = true;
+        m_canceled.reset();
+    }
+    m_generation++;
+    m_matches.clear();
+    m_blocks.clear();
+    m_runs.clear();
+    m_scrollbackLines = 0;
+    m_firstId = m_nextId;
+    if (scanning) {
+        emit finished();
+    }
+}
+
+QList<int> LogSearch::matchingRows() const
+{
+    QList<int> rows;
+    rows.reserve(m_matches.size());
+    for (auto id : m_matches) {
+        rows.append(static_cast<int>(rowOf(id)));
+    }
+    return rows;
+}
+
+int LogSearch::nextMatch(int row, bool reverse) const
+{
+    if (m_matches.isEmpty()) {
+        return -1;
+    }
+    auto id = idOf(row);
+    if (!reverse) {
+        auto it = std::upper_bound(m_matches.cbegin(), m_matches.cend(), id);
+        return static_cast<int>(rowOf(it != m_matches.cend() ? *it : m_matches.front()));
+    }
+    auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), id);
+    return static_cast<int>(rowOf(it != m_matches.cbegin() ? *std::prev(it) : m_matches.back()));
+}
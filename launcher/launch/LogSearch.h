@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "LogScrollback.h"
+#include "MessageLevel.h"
+
+/**
+ * Full text search over the lines of a LogModel.
+ *
+ * Keeps a compact case folded UTF-8 copy of the lines in the memory window of the model, in blocks that are never modified
+ * once full. Lines that moved to the scrollback of the model are not kept, a search reads them from disk in chunks instead.
+ * A search scans the scrollback and a snapshot of the blocks on a worker thread and reports matches in batches,
+ * while lines appended during and after the scan are matched as they arrive.
+ */
+class LogSearch : public QObject {
+    Q_OBJECT
+   public:
+    struct Query {
+        QString text;
+        /// only lines with one of these levels match, any level if empty
+        QList<MessageLevel> levels;
+    };
+
+    explicit LogSearch(QObject* parent = nullptr);
+    ~LogSearch() override;
+
+    void start(const Query& query);
+    void cancel();
+    bool isActive() const { return m_active; }
+    bool isRunning() const;
+
+    /// rows of all matches found so far, ascending
+    QList<int> matchingRows() const;
+    /// the closest matching row after (or before, if reverse) `row`, wrapping around. -1 if there is none
+    int nextMatch(int row, bool reverse) const;
+
+    // kept up to date by LogModel
+    /// the lines already in `scrollback` are the first rows of the model, to be set before any line is appended
+    void setScrollback(const LogScrollback* scrollback);
+    void lineAppended(MessageLevel level, const QString& line);
+    /// the oldest `count` lines in memory moved to the end of the scrollback, their rows did not change
+    void linesSpilled(int count);
+    /// the `count` rows from `first` were removed, only the oldest lines in memory can be
+    void linesRemoved(int first, int count);
+    void clear();
+
+   signals:
+    /// new matching rows, ascending within one batch
+    void matchesFound(QList<int> rows);
+    void finished();
+
+   public:
+    struct Block {
+        qint64 firstId = 0;
+        QByteArray text;  // folded lines, each one terminated by '\n'
+        QList<qsizetype> starts;
+        QList<quint8> levels;
+    };
+
+   private:
+    // lines with consecutive ids that are consecutive rows of the scrollback
+    struct Run {
+        qint64 row = 0;
+        qint64 firstId = 0;
+    };
+
+    void addMatches(const QList<qint64>& ids);
+    void addScrollbackMatches(const QList<qint64>& rows);
+    bool lineMatches(const QByteArray& folded, MessageLevel level) const;
+    /// the row of the line with `id`, -1 if it was removed
+    qint64 rowOf(qint64 id) const;
+    qint64 idOf(qint64 row) const;
+    void dropBlocks();
+
+   private:
+    const LogScrollback* m_scrollback = nullptr;
+    // every line gets an id when it is added, ids increase with the rows and stay the same when a line is spilled.
+    // Removed lines leave a gap, so the ids of the scrollback are mapped to its rows through runs.
+    QList<Run> m_runs;
+    qint64 m_scrollbackLines = 0;
+    std::vector<std::shared_ptr<Block>> m_blocks;
+    qint64 m_firstId = 0;  // id of the first line in memory
+    qint64 m_nextId = 0;   // id the next appended line will get
+
+    bool m_active = false;
+    QByteArray m_needle;
+    quint32 m_levelMask = 0;
+    QList<qint64> m_matches;  // ids of matching lines, ascending
+
+    int m_generation = 0;
+    std::shared_ptr<std::atomic_bool> m_canceled;
+    QFuture<void> m_future;
+};
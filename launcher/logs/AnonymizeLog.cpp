@@ -60,9 +60,100 @@ static const QVector<RegReplace> anonymizeRules = {
                "\"device_code\" :  \"<DEVICE_CODE>\""),  // device code
 };
 
-void anonymizeLog(QString& log)
+namespace {
+// all rules as one alternation, so the text only has to be scanned once.
+// the leftmost match wins and the rules are tried in order at each position, like applying them one after the other
+struct CombinedRules {
+    QRegularExpression reg;
+    // the capture group number of each rule, so a match doesn't have to look the rules up by name
+    QList<int> groups;
+};
+
+const CombinedRules& combinedRules()
+{
+    static const CombinedRules combined = [] {
+        QStringList alternatives;
+        for (qsizetype i = 0; i < anonymizeRules.size(); i++) {
+            alternatives << QString("(?<rule%1>%2)").arg(i).arg(anonymizeRules[i].reg.pattern());
+        }
+        CombinedRules rules{ QRegularExpression(alternatives.join('|'), QRegularExpression::CaseInsensitiveOption), {} };
+        rules.reg.optimize();
+
+        auto names = rules.reg.namedCaptureGroups();
+        for (qsizetype i = 0; i < anonymizeRules.size(); i++) {
+            rules.groups << static_cast<int>(names.indexOf(QString("rule%1").arg(i)));
+        }
+        return rules;
+    }();
+    return combined;
+}
+}  // namespace
+
+void LogAnonymizer::anonymize(const QString& text, QString& out)
+{
+    auto& rules = combinedRules();
+    qsizetype last = 0;
+    auto it = rules.reg.globalMatch(text);
+    while (it.hasNext()) {
+        auto match = it.next();
+        out.append(QStringView(text).sliced(last, match.capturedStart() - last));
+        for (qsizetype i = 0; i < rules.groups.size(); i++) {
+            if (match.capturedStart(rules.groups[i]) != -1) {
+                out.append(anonymizeRules[i].with);
+                break;
+            }
+        }
+        last = match.capturedEnd();
+    }
+    out.append(QStringView(text).sliced(last));
+}
+
+void LogAnonymizer::write(QStringView data)
 {
-    for (auto rule : anonymizeRules) {
-        log.replace(rule.reg, rule.with);
+    while (!data.isEmpty()) {
+        auto newline = data.indexOf('\n');
+        if (newline == -1) {
+            m_pending.append(data);
+            return;
+        }
+        m_pending.append(data.first(newline + 1));
+        data = data.sliced(newline + 1);
+
+        m_line.clear();
+        anonymize(m_pending, m_line);
+        m_pending.clear();
+        m_sink(m_line);
+    }
+}
+
+void LogAnonymizer::finish()
+{
+    if (m_pending.isEmpty()) {
+        return;
     }
+    m_line.clear();
+    anonymize(m_pending, m_line);
+    m_pending.clear();
+    m_sink(m_line);
+}
+
+void anonymizeLog(QString& log)
+{
+    // line by line like the uploads, so a rule can never match across a line break here but not there
+    QString out;
+    out.reserve(log.size());
+    LogAnonymizer anonymizer([&out](const QString& line) { out.append(line); });
+    anonymizer.write(log);
+    anonymizer.finish();
+    log = std::move(out);
+}
+
+QByteArray anonymizeLogToUtf8(QStringView log)
+{
+    QByteArray out;
+    out.reserve(log.size());
+    LogAnonymizer anonymizer([&out](const QString& line) { out.append(line.toUtf8()); });
+    anonymizer.write(log);
+    anonymizer.finish();
+    return out;
 }
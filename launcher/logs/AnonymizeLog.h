@@ -35,6 +35,36 @@
  */
 #pragma once
 
+#include <QByteArray>
 #include <QString>
+#include <QStringView>
+
+#include <functional>
 
 void anonymizeLog(QString& log);
+/// anonymize the log straight into UTF-8, without an intermediate copy of the whole text
+QByteArray anonymizeLogToUtf8(QStringView log);
+
+/**
+ * Anonymizes a log while it is streamed through, one line at a time.
+ *
+ * Data can be written in chunks of any size, every completed line (including its line break)
+ * is passed to the sink once all rules were applied to it. Only the current unfinished line is buffered.
+ */
+class LogAnonymizer {
+   public:
+    using Sink = std::function<void(const QString&)>;
+    explicit LogAnonymizer(Sink sink) : m_sink(std::move(sink)) {}
+
+    void write(QStringView data);
+    /// flush the last line if it didn't end with a line break
+    void finish();
+
+    /// apply all the rules to a single piece of text in one scan, appending the result to `out`
+    static void anonymize(const QString& text, QString& out);
+
+   private:
+    Sink m_sink;
+    QString m_pending;
+    QString m_line;
+};
@@ -0,0 +1,215 @@
+#include "LogFileIndex.h"
+
+#include <QMutexLocker>
+#include <QObject>
+#include <QStringDecoder>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// how much is read at once when searching or filling the gzip window
+constexpr qint64 ChunkSize = 4 * 1024 * 1024;
+
+// record the start of every line in `data`, which begins at `base` in the file
+void indexLines(const char* data, qint64 length, qint64 base, QList<qint64>& lineStarts)
+{
+    const char* end = data + length;
+    const char* pos = data;
+    while (pos < end) {
+        auto newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+        if (!newline) {
+            break;
+        }
+        lineStarts.append(base + (newline - data) + 1);
+        pos = newline + 1;
+    }
+}
+}  // namespace
+
+LogFileIndex::~LogFileIndex()
+{
+    if (m_map) {
+        m_file.unmap(const_cast<uchar*>(m_map));
+    }
+}
+
+QString LogFileIndex::build(const QString& path, const std::atomic_bool& canceled)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QFile::ReadOnly)) {
+        return m_file.errorString();
+    }
+    m_lineStarts = { 0 };
+
+    if (path.endsWith(".gz")) {
+        m_gzip = std::make_unique<GZip::SeekIndex>();
+        qint64 base = 0;
+        auto error = m_gzip->build(&m_file, [this, &base, &canceled](const QByteArray& block) {
+            indexLines(block.constData(), block.size(), base, m_lineStarts);
+            base += block.size();
+            return !canceled;
+        });
+        if (!error.isEmpty()) {
+            return error;
+        }
+        m_size = m_gzip->size();
+    } else {
+        m_size = m_file.size();
+        if (m_size > 0) {
+            m_map = m_file.map(0, m_size);
+            if (!m_map) {
+                return m_file.errorString();
+            }
+            for (qint64 offset = 0; offset < m_size && !canceled; offset += ChunkSize) {
+                indexLines(reinterpret_cast<const char*>(m_map) + offset, std::min(ChunkSize, m_size - offset), offset, m_lineStarts);
+            }
+        }
+    }
+    if (canceled) {
+        return QObject::tr("Canceled");
+    }
+
+    // a trailing newline doesn't start another line
+    if (m_lineStarts.size() > 1 && m_lineStarts.last() >= m_size) {
+        m_lineStarts.removeLast();
+    }
+    if (m_size == 0) {
+        m_lineStarts.clear();
+    }
+    m_lineStarts.squeeze();
+    return {};
+}
+
+QByteArray LogFileIndex::read(qint64 offset, qint64 length) const
+{
+    if (offset < 0 || offset >= m_size || length <= 0) {
+        return {};
+    }
+    length = std::min(length, m_size - offset);
+    if (m_map) {
+        return QByteArray::fromRawData(reinterpret_cast<const char*>(m_map) + offset, length);
+    }
+    if (!m_gzip) {
+        return {};
+    }
+    QMutexLocker locker(&m_readMutex);
+    if (offset >= m_windowOffset && offset + length <= m_windowOffset + m_window.size()) {
+        return m_window.mid(offset - m_windowOffset, length);
+    }
+    if (length >= ChunkSize) {
+        return m_gzip->read(const_cast<QFile*>(&m_file), offset, length);
+    }
+    // keep a window around the requested range so neighbouring lines don't inflate again
+    m_windowOffset = std::max<qint64>(0, offset - ChunkSize / 4);
+    m_window = m_gzip->read(const_cast<QFile*>(&m_file), m_windowOffset, ChunkSize);
+    return m_window.mid(offset - m_windowOffset, length);
+}
+
+qint64 LogFileIndex::lineEnd(qsizetype row) const
+{
+    return row + 1 < m_lineStarts.size() ? m_lineStarts[row + 1] : m_size;
+}
+
+qsizetype LogFileIndex::lineAt(qint64 offset) const
+{
+    auto it = std::upper_bound(m_lineStarts.cbegin(), m_lineStarts.cend(), offset);
+    return std::distance(m_lineStarts.cbegin(), it) - 1;
+}
+
+QString LogFileIndex::line(qsizetype row) const
+{
+    if (row < 0 || row >= m_lineStarts.size()) {
+        return {};
+    }
+    auto start = m_lineStarts[row];
+    auto data = read(start, lineEnd(row) - start);
+    while (data.endsWith('\n') || data.endsWith('\r')) {
+        data.chop(1);
+    }
+    return QString::fromUtf8(data);
+}
+
+qint64 LogFileIndex::searchBytes(qint64 begin,
+                                 qint64 end,
+                                 const QByteArray& pattern,
+                                 bool reverse,
+                                 const std::function<bool(qint64)>& step) const
+{
+    const qint64 overlap = pattern.size() - 1;
+    if (!reverse) {
+        for (qint64 pos = begin; pos < end; pos += ChunkSize) {
+            auto length = std::min(ChunkSize, end - pos);
+            auto chunk = read(pos, std::min(length + overlap, end - pos)).toLower();
+            auto index = chunk.indexOf(pattern);
+            if (index >= 0 && index < length) {
+                return pos + index;
+            }
+            if (!step(length)) {
+                return -1;
+            }
+        }
+    } else {
+        for (qint64 pos = end; pos > begin;) {
+            auto start = std::max(begin, pos - ChunkSize);
+            auto chunk = read(start, std::min(pos + overlap, end) - start).toLower();
+            auto index = chunk.lastIndexOf(pattern, pos - start - 1);
+            if (index >= 0) {
+                return start + index;
+            }
+            if (!step(pos - start)) {
+                return -1;
+            }
+            pos = start;
+        }
+    }
+    return -1;
+}
+
+qsizetype LogFileIndex::findLine(const QString& needle, qsizetype from, bool reverse, const Progress& progress) const
+{
+    if (needle.isEmpty() || m_lineStarts.isEmpty()) {
+        return -1;
+    }
+    // the whole file is matched as raw bytes, only ASCII letters are folded
+    auto pattern = needle.toLower().toUtf8();
+    from = std::clamp<qsizetype>(from, -1, m_lineStarts.size());
+
+    qint64 done = 0;
+    bool stopped = false;
+    auto step = [this, &progress, &done, &stopped](qint64 searched) {
+        done += searched;
+        stopped = progress && !progress(done, m_size);
+        return !stopped;
+    };
+
+    qint64 hit = -1;
+    if (!reverse) {
+        auto start = from + 1 < m_lineStarts.size() ? m_lineStarts[from + 1] : m_size;
+        hit = searchBytes(start, m_size, pattern, false, step);
+        if (hit < 0 && !stopped) {
+            hit = searchBytes(0, start, pattern, false, step);
+        }
+    } else {
+        auto end = from >= m_lineStarts.size() ? m_size : (from > 0 ? m_lineStarts[from] : 0);
+        hit = searchBytes(0, end, pattern, true, step);
+        if (hit < 0 && !stopped) {
+            hit = searchBytes(end, m_size, pattern, true, step);
+        }
+    }
+    return hit < 0 ? -1 : lineAt(hit);
+}
+
+QString LogFileIndex::text(const Progress& progress) const
+{
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QString out;
+    for (qint64 pos = 0; pos < m_size; pos += ChunkSize) {
+        // the decoder keeps what is left of a character cut in half by the chunk
+        out += decoder.decode(read(pos, ChunkSize));
+        if (progress && !progress(std::min(pos + ChunkSize, m_size), m_size)) {
+            return {};
+        }
+    }
+    return out;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "GZip.h"
+
+/**
+ * Line index over a log file on disk.
+ *
+ * Plain files are memory mapped, gzip compressed logs (`.log.gz`) are accessed through a GZip::SeekIndex.
+ * build() only records where each line starts, so it is cheap enough to run over very large logs on a
+ * worker thread. Lines are decoded on demand. Once built, it may be read from several threads at once.
+ */
+class LogFileIndex {
+   public:
+    /// told how many of the total bytes are done, returns false to stop
+    using Progress = std::function<bool(qint64 done, qint64 total)>;
+
+    LogFileIndex() = default;
+    ~LogFileIndex();
+
+    /// open the file and index its lines. may run on a worker thread, returns an error message or an empty string
+    QString build(const QString& path, const std::atomic_bool& canceled);
+
+    qsizetype lineCount() const { return m_lineStarts.size(); }
+    QString line(qsizetype row) const;
+
+    /// case insensitive search for the next line containing `needle`, starting after (or before, if reverse) `from`
+    /// and wrapping around. returns -1 if no line matches or it was stopped
+    qsizetype findLine(const QString& needle, qsizetype from, bool reverse, const Progress& progress = {}) const;
+    /// the text of the whole file, empty if it was stopped
+    QString text(const Progress& progress = {}) const;
+
+   private:
+    QByteArray read(qint64 offset, qint64 length) const;
+    qint64 searchBytes(qint64 begin, qint64 end, const QByteArray& pattern, bool reverse, const std::function<bool(qint64)>& step) const;
+    qsizetype lineAt(qint64 offset) const;
+    qint64 lineEnd(qsizetype row) const;
+
+   private:
+    QFile m_file;
+    const uchar* m_map = nullptr;
+    qint64 m_size = 0;
+    std::unique_ptr<GZip::SeekIndex> m_gzip;
+    QList<qint64> m_lineStarts;
+
+    // decompressed window around the last lines read from a gzip file, it and the file are guarded by m_readMutex
+    mutable QMutex m_readMutex;
+    mutable qint64 m_windowOffset = 0;
+    mutable QByteArray m_window;
+};
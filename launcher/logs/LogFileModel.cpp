@@ -0,0 +1,186 @@
+#include "LogFileModel.h"
+
+#include <QPromise>
+#include <QtConcurrentRun>
+
+#include <limits>
+
+#include "launch/LogModel.h"
+#include "logs/LogParser.h"
+
+namespace {
+// indented lines continue the message before them, but don't walk back further than this to find it
+constexpr int MaxContinuationLines = 64;
+constexpr int MaxCachedLevels = 16384;
+}  // namespace
+
+LogFileModel::LogFileModel(QObject* parent) : QAbstractListModel(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, &LogFileModel::indexFinished);
+}
+
+LogFileModel::~LogFileModel()
+{
+    if (m_canceled) {
+        *m_canceled = true;
+    }
+}
+
+void LogFileModel::load(const QString& path)
+{
+    if (m_canceled) {
+        *m_canceled = true;
+    }
+    m_canceled = std::make_shared<std::atomic_bool>(false);
+    m_pending = std::make_shared<LogFileIndex>();
+
+    // the worker keeps its own references, so the model can go away while it runs
+    auto index = m_pending;
+    auto canceled = m_canceled;
+    m_watcher.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [index, canceled, path] { return index->build(path, *canceled); }));
+}
+
+bool LogFileModel::isLoading() const
+{
+    return m_watcher.isRunning();
+}
+
+void LogFileModel::indexFinished()
+{
+    if (m_watcher.isCanceled() || !m_pending) {
+        return;
+    }
+    auto error = m_watcher.result();
+    if (!error.isEmpty()) {
+        m_pending.reset();
+        emit loadFailed(error);
+        return;
+    }
+    beginResetModel();
+    m_index = std::move(m_pending);
+    m_levels.clear();
+    endResetModel();
+    emit loaded();
+}
+
+int LogFileModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !m_index)
+        return 0;
+    return static_cast<int>(std::min<qsizetype>(m_index->lineCount(), std::numeric_limits<int>::max()));
+}
+
+QVariant LogFileModel::data(const QModelIndex& index, int role) const
+{
+    if (!m_index || index.row() < 0 || index.row() >= rowCount())
+        return {};
+
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return m_index->line(index.row());
+        case LogModel::LevelRole:
+            return static_cast<int>(levelOf(index.row()));
+        default:
+            return {};
+    }
+}
+
+MessageLevel LogFileModel::levelOf(int row) const
+{
+    if (auto it = m_levels.constFind(row); it != m_levels.cend()) {
+        return *it;
+    }
+    if (m_levels.size() > MaxCachedLevels) {
+        m_levels.clear();
+    }
+
+    auto classify = [this](const QString& line, MessageLevel previous) {
+        if (m_launcherLog) {
+            QString lineTemp = line;
+            return MessageLevel::takeFromLauncherLine(lineTemp);
+        }
+        return LogParser::guessLevel(line, previous);
+    };
+
+    // find the line that starts this message, or one we already know the level of
+    int first = row;
+    while (first > 0 && row - first < MaxContinuationLines && !m_levels.contains(first - 1)) {
+        auto line = m_index->line(first);
+        if (!line.startsWith('\t') && !line.startsWith(' ')) {
+            break;
+        }
+        first--;
+    }
+
+    MessageLevel level = m_levels.value(first - 1, MessageLevel::Unknown);
+    for (int i = first; i <= row; i++) {
+        level = classify(m_index->line(i), level);
+        m_levels.insert(i, level);
+    }
+    return level;
+}
+
+shared_qobject_ptr<LogFileTask> LogFileModel::find(const QString& what, const QModelIndex& start, bool reverse) const
+{
+    if (!m_index)
+        return {};
+    qsizetype from = start.isValid() ? start.row() : (reverse ? rowCount() : -1);
+    return makeShared<LogFileTask>(m_index, [what, from, reverse](const LogFileIndex& index, const LogFileIndex::Progress& progress) {
+        return QVariant::fromValue(index.findLine(what, from, reverse, progress));
+    });
+}
+
+shared_qobject_ptr<LogFileTask> LogFileModel::readText() const
+{
+    if (!m_index)
+        return {};
+    return makeShared<LogFileTask>(
+        m_index, [](const LogFileIndex& index, const LogFileIndex::Progress& progress) { return QVariant(index.text(progress)); });
+}
+
+LogFileTask::LogFileTask(std::shared_ptr<LogFileIndex> index, Work work) : m_index(std::move(index)), m_work(std::move(work))
+{
+    connect(&m_watcher, &QFutureWatcher<QVariant>::progressValueChanged, this, [this](int value) { setProgress(value, 1000); });
+    connect(&m_watcher, &QFutureWatcher<QVariant>::finished, this, &LogFileTask::workFinished);
+}
+
+LogFileTask::~LogFileTask()
+{
+    // the worker has its own references, it only needs to be told to stop
+    m_watcher.cancel();
+}
+
+void LogFileTask::executeTask()
+{
+    setProgress(0, 1000);
+    auto index = m_index;
+    auto work = m_work;
+    m_watcher.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [index, work](QPromise<QVariant>& promise) {
+        promise.setProgressRange(0, 1000);
+        auto progress = [&promise](qint64 done, qint64 total) {
+            promise.setProgressValue(total > 0 ? static_cast<int>(done * 1000 / total) : 1000);
+            return !promise.isCanceled();
+        };
+        promise.addResult(work(*index, progress));
+    }));
+}
+
+bool LogFileTask::abort()
+{
+    if (!isRunning())
+        return true;
+    // finishes as aborted once the worker stopped
+    m_watcher.cancel();
+    return true;
+}
+
+void LogFileTask::workFinished()
+{
+    if (m_watcher.isCanceled() || m_watcher.future().resultCount() == 0) {
+        emitAborted();
+        return;
+    }
+    m_result = m_watcher.result();
+    emitSucceeded();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QFutureWatcher>
+#include <QHash>
+
+#include <atomic>
+#include <memory>
+
+#include "LogFileIndex.h"
+#include "MessageLevel.h"
+#include "tasks/Task.h"
+
+/**
+ * Searches or reads a LogFileIndex on a worker thread, with progress, so that inflating a large
+ * gzip compressed log doesn't block the GUI. Get one from LogFileModel.
+ */
+class LogFileTask : public Task {
+    Q_OBJECT
+   public:
+    using Work = std::function<QVariant(const LogFileIndex&, const LogFileIndex::Progress&)>;
+
+    LogFileTask(std::shared_ptr<LogFileIndex> index, Work work);
+    ~LogFileTask() override;
+
+    /// what the work returned, valid once the task succeeded
+    QVariant result() const { return m_result; }
+
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void workFinished();
+
+   private:
+    std::shared_ptr<LogFileIndex> m_index;
+    Work m_work;
+    QVariant m_result;
+    QFutureWatcher<QVariant> m_watcher;
+};
+
+/**
+ * Read-only model over a log file that may be far too large to load as a whole.
+ *
+ * The file is indexed on a worker thread by LogFileIndex. Line text and levels are only produced for
+ * the rows a view actually asks for. Uses the same LevelRole as LogModel, so LogFormatProxyModel works on top of it.
+ */
+class LogFileModel : public QAbstractListModel {
+    Q_OBJECT
+   public:
+    explicit LogFileModel(QObject* parent = nullptr);
+    ~LogFileModel() override;
+
+    /// start indexing a file, loaded() or loadFailed() is emitted when done
+    void load(const QString& path);
+    bool isLoading() const;
+
+    /// classify lines like the launcher's own log instead of game logs
+    void setLauncherLog(bool launcherLog) { m_launcherLog = launcherLog; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+
+    /// searches for the row of the next line containing `what`, wrapping around. the result is the row or -1 if there is none
+    shared_qobject_ptr<LogFileTask> find(const QString& what, const QModelIndex& start, bool reverse) const;
+    /// reads the text of the whole file, the result is a QString
+    shared_qobject_ptr<LogFileTask> readText() const;
+
+   signals:
+    void loaded();
+    void loadFailed(QString error);
+
+   private:
+    MessageLevel levelOf(int row) const;
+    void indexFinished();
+
+   private:
+    std::shared_ptr<LogFileIndex> m_index;
+    std::shared_ptr<LogFileIndex> m_pending;
+    std::shared_ptr<std::atomic_bool> m_canceled;
+    QFutureWatcher<QString> m_watcher;
+    bool m_launcherLog = false;
+    mutable QHash<int, MessageLevel> m_levels;
+};
@@ -20,20 +20,31 @@
 #include "LogParser.h"
 
 #include <QRegularExpression>
+#include <algorithm>
 #include "MessageLevel.h"
 
 using namespace Qt::Literals::StringLiterals;
 
 void LogParser::appendLine(QAnyStringView data)
 {
-    if (!m_partialData.isEmpty()) {
-        m_buffer = QString(m_partialData);
-        m_buffer.append("\n");
-        m_partialData.clear();
+    if (m_hasPartial) {
+        // the buffer still holds the partial event, continue it on a new line
+        m_buffer.append(u'\n');
+        m_hasPartial = false;
     }
     m_buffer.append(data.toString());
 }
 
+void LogParser::consume(qsizetype count)
+{
+    if (count >= m_buffer.length()) {
+        m_buffer.clear();
+    } else {
+        m_buffer.remove(0, count);
+    }
+    m_scan = {};
+}
+
 std::optional<LogParser::Error> LogParser::getError()
 {
     return m_error;
@@ -88,12 +99,125 @@ void LogParser::clearError()
 
 bool isPotentialLog4JStart(QStringView buffer)
 {
-    static QString target = QStringLiteral("<log4j:event");
+    static constexpr QStringView target = u"<log4j:event";
     if (buffer.isEmpty() || buffer[0] != '<') {
         return false;
     }
-    auto bufLower = buffer.toString().toLower();
-    return target.startsWith(bufLower) || bufLower.startsWith(target);
+    auto len = std::min(buffer.length(), target.length());
+    return buffer.first(len).compare(target.first(len), Qt::CaseInsensitive) == 0;
+}
+
+qsizetype LogParser::scanForEventEnd()
+{
+    using Mode = ScanState::Mode;
+    auto& s = m_scan;
+    if (s.notEvent) {
+        return -1;
+    }
+
+    const auto buf = QStringView(m_buffer);
+    const auto len = buf.length();
+    while (s.pos < len) {
+        const QChar c = buf[s.pos];
+        switch (s.mode) {
+            case Mode::Text: {
+                if (c == '<') {
+                    s.mode = Mode::Open;
+                    s.tokenStart = s.pos;
+                } else if (s.depth == 0 && !c.isSpace()) {
+                    // text before the root element, this is not a log4j event
+                    s.notEvent = true;
+                    return -1;
+                }
+            } break;
+            case Mode::Open: {
+                s.endTag = false;
+                s.checkName = false;
+                if (c == '/') {
+                    if (s.depth == 0) {
+                        s.notEvent = true;
+                        return -1;
+                    }
+                    s.mode = Mode::Tag;
+                    s.endTag = true;
+                } else if (c == '?') {
+                    s.mode = Mode::Instruction;
+                } else if (c == '!') {
+                    static constexpr QStringView comment = u"<!--";
+                    static constexpr QStringView cdata = u"<![CDATA[";
+                    auto markup = buf.sliced(s.tokenStart);
+                    if (markup.startsWith(comment)) {
+                        s.mode = Mode::Comment;
+                        s.pos = s.tokenStart + comment.length();
+                        continue;
+                    }
+                    if (markup.startsWith(cdata)) {
+                        s.mode = Mode::CData;
+                        s.pos = s.tokenStart + cdata.length();
+                        continue;
+                    }
+                    if (comment.startsWith(markup) || cdata.startsWith(markup)) {
+                        return 0;  // need more data to tell what this is
+                    }
+                    s.mode = Mode::Declaration;
+                } else {
+                    s.mode = Mode::Tag;
+                    s.checkName = s.depth == 0;
+                }
+            } break;
+            case Mode::Tag: {
+                if (s.checkName && (c.isSpace() || c == '/' || c == '>')) {
+                    auto name = buf.sliced(s.tokenStart + 1, s.pos - s.tokenStart - 1);
+                    if (name.compare(u"log4j:Event", Qt::CaseInsensitive) != 0) {
+                        s.notEvent = true;
+                        return -1;
+                    }
+                    s.checkName = false;
+                }
+                if (c == '"' || c == '\'') {
+                    s.mode = Mode::Quoted;
+                    s.quote = c;
+                } else if (c == '>') {
+                    s.mode = Mode::Text;
+                    if (s.endTag) {
+                        s.depth -= 1;
+                    } else if (buf[s.pos - 1] != '/') {
+                        s.depth += 1;
+                    }
+                    if (s.depth == 0) {
+                        return s.pos + 1;
+                    }
+                }
+            } break;
+            case Mode::Quoted: {
+                if (c == s.quote) {
+                    s.mode = Mode::Tag;
+                }
+            } break;
+            case Mode::Comment: {
+                if (c == '>' && s.pos >= s.tokenStart + 6 && buf[s.pos - 1] == '-' && buf[s.pos - 2] == '-') {
+                    s.mode = Mode::Text;
+                }
+            } break;
+            case Mode::CData: {
+                if (c == '>' && s.pos >= s.tokenStart + 11 && buf[s.pos - 1] == ']' && buf[s.pos - 2] == ']') {
+                    s.mode = Mode::Text;
+                }
+            } break;
+            case Mode::Instruction: {
+                if (c == '>' && s.pos >= s.tokenStart + 3 && buf[s.pos - 1] == '?') {
+                    s.mode = Mode::Text;
+                }
+            } break;
+            case Mode::Declaration: {
+                if (c == '>') {
+                    s.mode = Mode::Text;
+                }
+            } break;
+        }
+        s.pos += 1;
+    }
+    return 0;
 }
 
 std::optional<LogParser::ParsedItem> LogParser::parseNext()
@@ -104,82 +228,47 @@ std::optional<LogParser::ParsedItem> LogParser::parseNext()
         return {};
     }
 
-    if (m_buffer.trimmed().isEmpty()) {
+    if (QStringView(m_buffer).trimmed().isEmpty()) {
         auto text = QString(m_buffer);
-        m_buffer.clear();
+        consume(m_buffer.length());
         return LogParser::PlainText{ text };
     }
 
-    // check if we have a full xml log4j event
-    bool isCompleteLog4j = false;
-    m_parser.clear();
-    m_parser.setNamespaceProcessing(false);
-    m_parser.addData(m_buffer);
-    if (m_parser.readNextStartElement()) {
-        if (m_parser.qualifiedName().compare("log4j:Event"_L1, Qt::CaseInsensitive) == 0) {
-            int depth = 1;
-            bool eod = false;
-            while (depth > 0 && !eod) {
-                auto tok = m_parser.readNext();
-                switch (tok) {
-                    case QXmlStreamReader::TokenType::StartElement: {
-                        depth += 1;
-                    } break;
-                    case QXmlStreamReader::TokenType::EndElement: {
-                        depth -= 1;
-                    } break;
-                    case QXmlStreamReader::TokenType::EndDocument: {
-                        eod = true;  // break outer while loop
-                    } break;
-                    default: {
-                        // no op
-                    }
-                }
-                if (m_parser.hasError()) {
-                    break;
-                }
-            }
-
-            isCompleteLog4j = depth == 0;
-        }
+    // check if we have a full xml log4j event, only looking at data appended since the last call
+    if (auto end = scanForEventEnd(); end > 0) {
+        return parseLog4J(end);
     }
 
-    if (isCompleteLog4j) {
-        return parseLog4J();
-    } else {
-        if (isPotentialLog4JStart(m_buffer)) {
-            m_partialData = QString(m_buffer);
-            return LogParser::Partial{ QString(m_buffer) };
-        }
+    if (isPotentialLog4JStart(m_buffer)) {
+        m_hasPartial = true;
+        return LogParser::Partial{ QString(m_buffer) };
+    }
 
-        int start = 0;
-        auto bufView = QStringView(m_buffer);
-        while (start < bufView.length()) {
-            if (qsizetype pos = bufView.right(bufView.length() - start).indexOf('<'); pos != -1) {
-                auto slicestart = start + pos;
-                auto slice = bufView.right(bufView.length() - slicestart);
-                if (isPotentialLog4JStart(slice)) {
-                    if (slicestart > 0) {
-                        auto text = m_buffer.left(slicestart);
-                        m_buffer = m_buffer.right(m_buffer.length() - slicestart);
-                        if (!text.trimmed().isEmpty()) {
-                            return LogParser::PlainText{ text };
-                        }
+    auto bufView = QStringView(m_buffer);
+    qsizetype start = 0;
+    while (start < bufView.length()) {
+        if (qsizetype pos = bufView.indexOf('<', start); pos != -1) {
+            if (isPotentialLog4JStart(bufView.sliced(pos))) {
+                if (pos > 0) {
+                    auto text = m_buffer.left(pos);
+                    consume(pos);
+                    if (!text.trimmed().isEmpty()) {
+                        return LogParser::PlainText{ text };
                     }
-                    m_partialData = QString(m_buffer);
-                    return LogParser::Partial{ QString(m_buffer) };
                 }
-                start = slicestart + 1;
-            } else {
-                break;
+                m_hasPartial = true;
+                return LogParser::Partial{ QString(m_buffer) };
             }
+            start = pos + 1;
+        } else {
+            break;
         }
-
-        // no log4j found, all plain text
-        auto text = QString(m_buffer);
-        m_buffer.clear();
-        return LogParser::PlainText{ text };
     }
+
+    // no log4j found, all plain text
+    auto text = QString(m_buffer);
+    consume(m_buffer.length());
+    return LogParser::PlainText{ text };
 }
 
 QList<LogParser::ParsedItem> LogParser::parseAvailable()
@@ -205,18 +294,31 @@ QList<LogParser::ParsedItem> LogParser::parseAvailable()
     return items;
 }
 
-std::optional<LogParser::ParsedItem> LogParser::parseLog4J()
+std::optional<LogParser::ParsedItem> LogParser::parseLog4J(qsizetype end)
 {
+    // the scanner already found where the event ends, only hand that slice to the xml reader
     m_parser.clear();
     m_parser.setNamespaceProcessing(false);
-    m_parser.addData(m_buffer);
+    m_parser.addData(m_buffer.left(end));
+
+    // a malformed event will never parse, drop it so it doesn't block the rest of the log
+    auto dropEvent = [this, end]() -> std::optional<ParsedItem> {
+        if (!m_error.has_value()) {
+            if (!m_parser.hasError()) {
+                m_parser.raiseError("log4j:Event could not be parsed");
+            }
+            setError();
+        }
+        consume(end);
+        return {};
+    };
 
     m_parser.readNextStartElement();
     if (m_parser.qualifiedName().compare("log4j:Event"_L1, Qt::CaseInsensitive) == 0) {
         auto entry_ = parseAttributes();
         if (!entry_.has_value()) {
             setError();
-            return {};
+            return dropEvent();
         }
         auto entry = entry_.value();
 
@@ -267,11 +369,8 @@ std::optional<LogParser::ParsedItem> LogParser::parseLog4J()
             depth -= 1;
             if (depth == 0 && m_parser.qualifiedName().compare("log4j:Event"_L1, Qt::CaseInsensitive) == 0) {
                 if (foundMessage) {
-                    auto consumed = m_parser.characterOffset();
-                    if (consumed > 0 && consumed <= m_buffer.length()) {
-                        m_buffer = m_buffer.right(m_buffer.length() - consumed);
-                        // potential whitespace preserved for next item
-                    }
+                    // potential whitespace preserved for next item
+                    consume(end);
                     clearError();
                     return entryReady;
                 }
@@ -293,7 +392,7 @@ std::optional<LogParser::ParsedItem> LogParser::parseLog4J()
                     op = foundEnd();
                 } break;
                 case QXmlStreamReader::TokenType::EndDocument: {
-                    return {};
+                    return dropEvent();
                 } break;
                 default: {
                     // no op
@@ -302,7 +401,7 @@ std::optional<LogParser::ParsedItem> LogParser::parseLog4J()
 
             switch (op) {
                 case parseError:
-                    return {};  // parse fail or error
+                    return dropEvent();  // parse fail or error
                 case entryReady:
                     return entry;
                 case noOp:
@@ -312,12 +411,12 @@ std::optional<LogParser::ParsedItem> LogParser::parseLog4J()
             }
 
             if (m_parser.hasError()) {
-                return {};
+                return dropEvent();
             }
         }
     }
 
-    throw std::runtime_error("unreachable: already verified this was a complete log4j:Event");
+    return dropEvent();
 }
 
 MessageLevel LogParser::guessLevel(const QString& line, MessageLevel previous)
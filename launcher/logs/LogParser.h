@@ -66,11 +66,32 @@ class LogParser {
     void setError();
     void clearError();
 
-    std::optional<ParsedItem> parseLog4J();
+    std::optional<ParsedItem> parseLog4J(qsizetype end);
+
+    /// scan newly appended data for the end of a log4j:Event at the start of the buffer.
+    /// returns the offset one past the closing tag, 0 if the event is not complete yet,
+    /// or -1 if the buffer does not start with a log4j:Event
+    qsizetype scanForEventEnd();
+    /// drop the first `count` characters of the buffer and restart scanning
+    void consume(qsizetype count);
 
    private:
+    /// resumable tokenizer state, so each appended line is only scanned once
+    struct ScanState {
+        enum class Mode { Text, Open, Tag, Quoted, Comment, CData, Instruction, Declaration };
+        Mode mode = Mode::Text;
+        qsizetype pos = 0;
+        qsizetype tokenStart = 0;
+        int depth = 0;
+        bool endTag = false;
+        bool checkName = false;
+        bool notEvent = false;
+        QChar quote;
+    };
+
     QString m_buffer;
-    QString m_partialData;
+    bool m_hasPartial = false;
+    ScanState m_scan;
     QXmlStreamReader m_parser;
     std::optional<Error> m_error;
 };
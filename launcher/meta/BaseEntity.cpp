@@ -15,6 +15,13 @@
 
 #include "BaseEntity.h"
 
+#include <QCborValue>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
 #include "Exception.h"
 #include "FileSystem.h"
 #include "Json.h"
@@ -31,6 +38,10 @@
 
 namespace Meta {
 
+// header of the files in meta/.parsed, which keep the parsed local meta files as CBOR
+static const quint32 PARSED_MAGIC = 0x4D504152;  // "MPAR"
+static const quint32 PARSED_VERSION = 1;
+
 class ParsingValidator : public Net::Validator {
    public: /* con/des */
     ParsingValidator(BaseEntity* entity) : m_entity(entity) {};
@@ -110,40 +121,135 @@ BaseEntityLoadTask::BaseEntityLoadTask(BaseEntity* parent, Net::Mode mode) : m_e
 
 void BaseEntityLoadTask::executeTask()
 {
-    const QString fname = QDir("meta").absoluteFilePath(m_entity->localFilename());
-    auto hashMatches = false;
+    m_fileName = QDir("meta").absoluteFilePath(m_entity->localFilename());
+    m_parsedFileName = QDir("meta/.parsed").absoluteFilePath(m_entity->localFilename());
     // the file exists on disk try to load it
-    if (QFile::exists(fname)) {
+    if (!QFile::exists(m_fileName)) {
+        loadRemote(false);
+        return;
+    }
+    // read local file if nothing is loaded yet
+    if (m_entity->m_load_status != BaseEntity::LoadStatus::NotLoaded && !m_entity->m_file_sha256.isEmpty()) {
+        applyLocalFile({});
+        return;
+    }
+
+    setStatus(tr("Loading local file"));
+    auto parse = m_entity->m_load_status == BaseEntity::LoadStatus::NotLoaded;
+    connect(&m_localRead, &QFutureWatcher<LocalFile>::finished, this, &BaseEntityLoadTask::localFileRead, Qt::UniqueConnection);
+    m_localRead.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), &BaseEntityLoadTask::readLocalFile, m_fileName,
+                                            m_parsedFileName, parse));
+}
+
+BaseEntityLoadTask::LocalFile BaseEntityLoadTask::readLocalFile(const QString& fileName, const QString& parsedFileName, bool parse)
+{
+    LocalFile local;
+    QFileInfo info(fileName);
+    const qint64 size = info.size();
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    // the parsed file knows the hash and contents of the file it was made from, as long as that did not change since
+    if (QFile::exists(parsedFileName)) {
         try {
-            QByteArray fileData;
-            // read local file if nothing is loaded yet
-            if (m_entity->m_load_status == BaseEntity::LoadStatus::NotLoaded || m_entity->m_file_sha256.isEmpty()) {
-                setStatus(tr("Loading local file"));
-                fileData = FS::read(fname);
-                m_entity->m_file_sha256 = Hashing::hash(fileData, Hashing::Algorithm::Sha256);
+            auto data = FS::read(parsedFileName);
+            QDataStream stream(data);
+            stream.setVersion(QDataStream::Qt_6_0);
+            quint32 magic = 0;
+            quint32 version = 0;
+            qint64 parsedSize = -1;
+            qint64 parsedModified = -1;
+            QString sha256;
+            QByteArray cbor;
+            stream >> magic >> version >> parsedSize >> parsedModified >> sha256;
+            if (stream.status() == QDataStream::Ok && magic == PARSED_MAGIC && version == PARSED_VERSION && parsedSize == size &&
+                parsedModified == modified) {
+                if (!parse) {
+                    local.sha256 = sha256;
+                    return local;
+                }
+                stream >> cbor;
+                QCborParserError error;
+                auto value = QCborValue::fromCbor(cbor, &error);
+                if (stream.status() == QDataStream::Ok && error.error == QCborError::NoError && value.isMap()) {
+                    local.sha256 = sha256;
+                    local.object = value.toJsonValue().toObject();
+                    return local;
+                }
             }
+        } catch (const Exception& e) {
+            qDebug() << "Unable to read parsed meta file" << parsedFileName << ":" << e.cause();
+        }
+    }
 
-            // on online the hash needs to match
-            hashMatches = m_entity->m_sha256 == m_entity->m_file_sha256;
-            if (m_mode == Net::Mode::Online && !m_entity->m_sha256.isEmpty() && !hashMatches) {
-                throw Exception("mismatched checksum");
-            }
+    try {
+        auto fileData = FS::read(fileName);
+        local.sha256 = Hashing::hash(fileData, Hashing::Algorithm::Sha256);
+        if (!parse) {
+            return local;
+        }
+        auto doc = Json::requireDocument(fileData, fileName);
+        local.object = Json::requireObject(doc, fileName);
+    } catch (const Exception& e) {
+        local.error = e.cause();
+        return local;
+    }
 
-            // load local file
-            if (m_entity->m_load_status == BaseEntity::LoadStatus::NotLoaded) {
-                auto doc = Json::requireDocument(fileData, fname);
-                auto obj = Json::requireObject(doc, fname);
-                m_entity->parse(obj);
-                m_entity->m_load_status = BaseEntity::LoadStatus::Local;
-            }
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << PARSED_MAGIC << PARSED_VERSION << size << modified << local.sha256 << QCborValue::fromJsonValue(local.object).toCbor();
+    try {
+        FS::write(parsedFileName, data);
+    } catch (const Exception& e) {
+        qDebug() << "Unable to write parsed meta file" << parsedFileName << ":" << e.cause();
+    }
+    return local;
+}
 
-        } catch (const Exception& e) {
-            qDebug() << QString("Unable to parse file %1: %2").arg(fname, e.cause());
-            // just make sure it's gone and we never consider it again.
-            FS::deletePath(fname);
-            m_entity->m_load_status = BaseEntity::LoadStatus::NotLoaded;
+void BaseEntityLoadTask::localFileRead()
+{
+    // aborted while the file was read
+    if (!isRunning() || m_localRead.isCanceled()) {
+        return;
+    }
+    applyLocalFile(m_localRead.result());
+}
+
+void BaseEntityLoadTask::applyLocalFile(const LocalFile& local)
+{
+    auto hashMatches = false;
+    try {
+        if (!local.error.isEmpty()) {
+            throw Exception(local.error);
         }
+        if (!local.sha256.isEmpty()) {
+            m_entity->m_file_sha256 = local.sha256;
+        }
+
+        // on online the hash needs to match
+        hashMatches = m_entity->m_sha256 == m_entity->m_file_sha256;
+        if (m_mode == Net::Mode::Online && !m_entity->m_sha256.isEmpty() && !hashMatches) {
+            throw Exception("mismatched checksum");
+        }
+
+        // load local file
+        if (m_entity->m_load_status == BaseEntity::LoadStatus::NotLoaded) {
+            m_entity->parse(local.object);
+            m_entity->m_load_status = BaseEntity::LoadStatus::Local;
+        }
+
+    } catch (const Exception& e) {
+        qDebug() << QString("Unable to parse file %1: %2").arg(m_fileName, e.cause());
+        // just make sure it's gone and we never consider it again.
+        FS::deletePath(m_fileName);
+        FS::deletePath(m_parsedFileName);
+        m_entity->m_load_status = BaseEntity::LoadStatus::NotLoaded;
     }
+    loadRemote(hashMatches);
+}
+
+void BaseEntityLoadTask::loadRemote(bool hashMatches)
+{
     // if we need remote update, run the update task
     auto wasLoadedOffline = m_entity->m_load_status != BaseEntity::LoadStatus::NotLoaded && m_mode == Net::Mode::Offline;
     // if has is not present allways fetch from remote(e.g. the main index file), else only fetch if hash doesn't match
@@ -183,7 +289,7 @@ void BaseEntityLoadTask::executeTask()
 
 bool BaseEntityLoadTask::canAbort() const
 {
-    return m_task ? m_task->canAbort() : false;
+    return m_task ? m_task->canAbort() : m_localRead.isRunning();
 }
 
 bool BaseEntityLoadTask::abort()
@@ -192,6 +298,8 @@ bool BaseEntityLoadTask::abort()
         Task::abort();
         return m_task->abort();
     }
+    // the read itself can't be stopped, but its result is dropped
+    m_localRead.cancel();
     return Task::abort();
 }
 
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <QFutureWatcher>
 #include <QJsonObject>
 #include <QObject>
 
@@ -65,9 +66,25 @@ class BaseEntityLoadTask : public Task {
     virtual bool canAbort() const override;
     virtual bool abort() override;
 
+   private:
+    // the local file as read on a worker thread
+    struct LocalFile {
+        QString sha256;
+        QJsonObject object;
+        QString error;
+    };
+
+    static LocalFile readLocalFile(const QString& fileName, const QString& parsedFileName, bool parse);
+    void localFileRead();
+    void applyLocalFile(const LocalFile& local);
+    void loadRemote(bool hashMatches);
+
    private:
     BaseEntity* m_entity;
     Net::Mode m_mode;
     NetJob::Ptr m_task;
+    QString m_fileName;
+    QString m_parsedFileName;
+    QFutureWatcher<LocalFile> m_localRead;
 };
 }  // namespace Meta
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "LaunchPlanCache.h"
+
+#include <QCborValue>
+#include <QDataStream>
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonDocument>
+
+#include "Exception.h"
+#include "FileSystem.h"
+#include "minecraft/OneSixVersionFormat.h"
+
+namespace LaunchPlanCache {
+
+static const quint32 PLAN_MAGIC = 0x4C504C4E;  // "LPLN"
+static const quint32 PLAN_VERSION = 1;
+
+bool load(const QString& path, Plan& plan)
+{
+    if (!QFileInfo::exists(path))
+        return false;
+
+    try {
+        auto data = FS::read(path);
+        QDataStream stream(data);
+        stream.setVersion(QDataStream::Qt_6_0);
+
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 count = 0;
+        Plan out;
+        stream >> magic >> version >> out.key >> out.created >> count;
+        if (stream.status() != QDataStream::Ok || magic != PLAN_MAGIC || version != PLAN_VERSION) {
+            qWarning() << "Ignoring launch plan" << path << "with unknown format";
+            return false;
+        }
+        out.files.reserve(count);
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+            QByteArray cbor;
+            stream >> cbor;
+            auto doc = QJsonDocument(QCborValue::fromCbor(cbor).toJsonValue().toObject());
+            out.files.append(OneSixVersionFormat::versionFileFromJson(doc, path, false));
+        }
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "Ignoring truncated launch plan" << path;
+            return false;
+        }
+        plan = std::move(out);
+        return true;
+    } catch (const Exception& e) {
+        qWarning() << "Failed to read launch plan" << path << ":" << e.cause();
+        return false;
+    }
+}
+
+bool save(const QString& path, const Plan& plan)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << PLAN_MAGIC << PLAN_VERSION << plan.key << plan.created << quint32(plan.files.size());
+    for (auto& file : plan.files) {
+        stream << QCborValue::fromJsonValue(OneSixVersionFormat::versionFileToJson(file).object()).toCbor();
+    }
+
+    try {
+        FS::write(path, data);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write launch plan" << path << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace LaunchPlanCache
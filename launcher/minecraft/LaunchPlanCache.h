@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "minecraft/VersionFile.h"
+
+/**
+ * The resolved components of an instance, kept on disk between launches.
+ *
+ * A plan holds the version files that make up the launch profile, in the order they are applied, as they were after
+ * the last successful resolution. Its key covers everything the resolution was made from, so an instance whose
+ * components did not change can be launched without loading metadata or resolving dependencies again.
+ */
+namespace LaunchPlanCache {
+
+struct Plan {
+    QByteArray key;
+    qint64 created = 0;  ///< ms since epoch
+    QList<VersionFilePtr> files;
+};
+
+bool load(const QString& path, Plan& plan);
+
+bool save(const QString& path, const Plan& plan);
+
+}  // namespace LaunchPlanCache
@@ -8,6 +8,10 @@ void MinecraftLoadAndCheck::executeTask()
 {
     // add offline metadata load task
     auto components = m_inst->getPackProfile();
+    if (components->reloadFromLaunchPlan(m_netmode)) {
+        emitSucceeded();
+        return;
+    }
     if (auto result = components->reload(m_netmode); !result) {
         emitFailed(result.error);
         return;
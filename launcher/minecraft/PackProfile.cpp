@@ -39,9 +39,11 @@
 
 #include <Version.h>
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QSaveFile>
@@ -57,6 +59,7 @@
 #include "meta/Index.h"
 #include "meta/JsonFormat.h"
 #include "minecraft/Component.h"
+#include "minecraft/LaunchPlanCache.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/OneSixVersionFormat.h"
 #include "minecraft/ProfileUtils.h"
@@ -89,6 +92,8 @@ PackProfile::~PackProfile()
 // BEGIN: component file format
 
 static const int currentComponentsFileVersion = 1;
+// how old a launch plan may get before online launches resolve the components again, in ms
+static const qint64 launchPlanMaxAgeOnline = 24LL * 60 * 60 * 1000;
 
 static QJsonObject componentToJsonV1(ComponentPtr component)
 {
@@ -333,7 +338,7 @@ PackProfile::Result PackProfile::reload(Net::Mode netmode)
     saveNow();
 
     // FIXME: differentiate when a reapply is required by propagating state from components
-    invalidateLaunchProfile();
+    discardLaunchPlan();
 
     if (auto result = load(); !result) {
         return result;
@@ -342,6 +347,81 @@ PackProfile::Result PackProfile::reload(Net::Mode netmode)
     return Result::Success();
 }
 
+bool PackProfile::reloadFromLaunchPlan(Net::Mode netmode)
+{
+    if (d->m_updateTask) {
+        return false;
+    }
+    saveNow();
+    discardLaunchPlan();
+    if (auto result = load(); !result) {
+        return false;
+    }
+
+    LaunchPlanCache::Plan plan;
+    if (!LaunchPlanCache::load(launchPlanPath(), plan) || plan.key != launchPlanKey()) {
+        return false;
+    }
+    // online launches still pick up metadata updates now and then
+    auto age = QDateTime::currentMSecsSinceEpoch() - plan.created;
+    if (netmode == Net::Mode::Online && (age < 0 || age > launchPlanMaxAgeOnline)) {
+        return false;
+    }
+    qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Using the launch plan of the last resolution";
+    d->m_plannedFiles = plan.files;
+    return true;
+}
+
+QString PackProfile::launchPlanPath() const
+{
+    return QDir("cache/launchplans").absoluteFilePath(d->m_instance->id() + ".plan");
+}
+
+QByteArray PackProfile::launchPlanKey() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto addFile = [&hash](const QString& path) {
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            hash.addData(path.toUtf8());
+            hash.addData(&file);
+        }
+    };
+    addFile(componentsFilePath());
+    for (auto& component : d->components) {
+        addFile(patchFilePathForUid(component->getID()));
+        // metadata files are only replaced as a whole, their stamp is enough
+        QFileInfo meta(QDir("meta").absoluteFilePath(component->getID() + '/' + component->getVersion() + ".json"));
+        if (meta.exists()) {
+            hash.addData(meta.filePath().toUtf8());
+            hash.addData(QByteArray::number(meta.size()) + ':' + QByteArray::number(meta.lastModified().toMSecsSinceEpoch()));
+        }
+    }
+    return hash.result();
+}
+
+void PackProfile::saveLaunchPlan()
+{
+    LaunchPlanCache::Plan plan;
+    for (auto& component : d->components) {
+        if (!component->isEnabled()) {
+            continue;
+        }
+        auto file = component->getVersionFile();
+        // problems have to be found again on every launch
+        if (!file || component->getProblemSeverity() != ProblemSeverity::None) {
+            QFile::remove(launchPlanPath());
+            return;
+        }
+        plan.files.append(file);
+    }
+    // the resolution may have changed the components, they are part of the key
+    saveNow();
+    plan.key = launchPlanKey();
+    plan.created = QDateTime::currentMSecsSinceEpoch();
+    LaunchPlanCache::save(launchPlanPath(), plan);
+}
+
 Task::Ptr PackProfile::getCurrentTask()
 {
     return d->m_updateTask;
@@ -361,14 +441,15 @@ void PackProfile::updateSucceeded()
 {
     qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Component list update/resolve task succeeded";
     d->m_updateTask.reset();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
+    saveLaunchPlan();
 }
 
 void PackProfile::updateFailed(const QString& error)
 {
     qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Component list update/resolve task failed. Reason:" << error;
     d->m_updateTask.reset();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
 }
 
 // END: save/load
@@ -438,7 +519,7 @@ bool PackProfile::remove(const int index)
     d->components.removeAt(index);
     d->componentIndex.remove(patch->getID());
     endRemoveRows();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     scheduleSave();
     return true;
 }
@@ -466,7 +547,7 @@ bool PackProfile::customize(int index)
         qCCritical(instanceProfileC) << d->m_instance->name() << "|" << "Patch" << patch->getID() << "could not be customized";
         return false;
     }
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     scheduleSave();
     return true;
 }
@@ -482,7 +563,7 @@ bool PackProfile::revertToBase(int index)
         qCCritical(instanceProfileC) << d->m_instance->name() << "|" << "Patch" << patch->getID() << "could not be reverted";
         return false;
     }
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     scheduleSave();
     return true;
 }
@@ -649,7 +730,7 @@ void PackProfile::move(const int index, const MoveDirection direction)
     beginMoveRows(QModelIndex(), index, index, QModelIndex(), togap);
     d->components.swapItemsAt(index, theirIndex);
     endMoveRows();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     scheduleSave();
 }
 
@@ -658,6 +739,12 @@ void PackProfile::invalidateLaunchProfile()
     d->m_profile.reset();
 }
 
+void PackProfile::discardLaunchPlan()
+{
+    d->m_plannedFiles.clear();
+    invalidateLaunchProfile();
+}
+
 void PackProfile::installJarMods(QStringList selectedFiles)
 {
     // FIXME: get rid of _internal
@@ -694,7 +781,7 @@ bool PackProfile::installComponents(QStringList selectedFiles)
     }
 
     scheduleSave();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
 
     return result;
 }
@@ -727,7 +814,7 @@ bool PackProfile::installEmpty(const QString& uid, const QString& name)
 
     appendComponent(makeShared<Component>(this, f->uid, f));
     scheduleSave();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     return true;
 }
 
@@ -824,7 +911,7 @@ bool PackProfile::installJarMods_internal(QStringList filepaths)
         appendComponent(makeShared<Component>(this, f->uid, f));
     }
     scheduleSave();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     return true;
 }
 
@@ -879,7 +966,7 @@ bool PackProfile::installCustomJar_internal(QString filepath)
     appendComponent(makeShared<Component>(this, f->uid, f));
 
     scheduleSave();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
     return true;
 }
 
@@ -937,7 +1024,7 @@ bool PackProfile::installAgents_internal(QStringList filepaths)
     }
 
     scheduleSave();
-    invalidateLaunchProfile();
+    discardLaunchPlan();
 
     return true;
 }
@@ -947,6 +1034,13 @@ std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
     if (!d->m_profile) {
         try {
             auto profile = std::make_shared<LaunchProfile>();
+            if (!d->m_plannedFiles.isEmpty()) {
+                for (auto& file : d->m_plannedFiles) {
+                    file->applyTo(profile.get(), d->m_instance->runtimeContext());
+                }
+                d->m_profile = profile;
+                return d->m_profile;
+            }
             for (auto file : d->components) {
                 qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Applying" << file->getID()
                                           << (file->getProblemSeverity() == ProblemSeverity::Error ? "ERROR" : "GOOD");
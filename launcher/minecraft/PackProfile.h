@@ -117,6 +117,12 @@ class PackProfile : public QAbstractListModel {
     /// reload the list, reload all components, resolve dependencies
     Result reload(Net::Mode netmode);
 
+    /**
+     * Reload the list and take the launch profile from the launch plan of the last resolution, if nothing it was made
+     * from changed since. Returns false if the plan can't be used and a reload() is needed.
+     */
+    bool reloadFromLaunchPlan(Net::Mode netmode);
+
     // reload all components, resolve dependencies
     void resolve(Net::Mode netmode);
 
@@ -162,8 +168,12 @@ class PackProfile : public QAbstractListModel {
     QList<ModPlatform::ModLoaderType> getModLoadersList();
 
     /// apply the component patches. Catches all the errors and returns true/false for success/failure
+    /// The launch plan, if one is used, stays: this is only about the runtime context the patches are applied with
     void invalidateLaunchProfile();
 
+    /// The key the launch plan of the current components is stored with
+    QByteArray launchPlanKey() const;
+
    private:
     void scheduleSave();
     bool saveIsScheduled() const;
@@ -173,6 +183,10 @@ class PackProfile : public QAbstractListModel {
 
     QString componentsFilePath() const;
     QString patchesPattern() const;
+    QString launchPlanPath() const;
+    void saveLaunchPlan();
+    /// the components changed, the launch plan doesn't describe them anymore
+    void discardLaunchPlan();
 
    private slots:
     bool save_internal();
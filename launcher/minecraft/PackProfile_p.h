@@ -4,6 +4,7 @@
 #include <QMap>
 #include <QTimer>
 #include "Component.h"
+#include "VersionFile.h"
 #include "tasks/Task.h"
 
 class MinecraftInstance;
@@ -16,6 +17,8 @@ struct PackProfileData {
 
     // the launch profile (volatile, temporary thing created on demand)
     std::shared_ptr<LaunchProfile> m_profile;
+    // version files of a cached launch plan, used instead of the components while set
+    QList<VersionFilePtr> m_plannedFiles;
 
     // persistent list of components and related machinery
     ComponentContainer components;
@@ -21,13 +21,14 @@
 #include <QDebug>
 #include <algorithm>
 #include <memory>
+#include "Application.h"
 #include "Json.h"
 #include "QObjectPtr.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/mod/MetadataHandler.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceAPI.h"
-#include "tasks/SequentialTask.h"
+#include "tasks/ConcurrentTask.h"
 #include "ui/pages/modplatform/ModModel.h"
 
 static Version mcVersion(BaseInstance* inst)
@@ -51,7 +52,10 @@ static bool checkDependencies(std::shared_ptr<GetModDependenciesTask::PackDepend
 GetModDependenciesTask::GetModDependenciesTask(BaseInstance* instance,
                                                ModFolderModel* folder,
                                                QList<std::shared_ptr<PackDependency>> selected)
-    : SequentialTask(tr("Get dependencies")), m_selected(selected), m_version(mcVersion(instance)), m_loaderType(mcLoaders(instance))
+    : m_selected(selected)
+    , m_version(mcVersion(instance))
+    , m_loaderType(mcLoaders(instance))
+    , m_maxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt())
 {
     for (auto mod : folder->allMods()) {
         m_mods_file_names << mod->fileinfo().fileName();
@@ -61,12 +65,22 @@ GetModDependenciesTask::GetModDependenciesTask(BaseInstance* instance,
     prepare();
 }
 
+GetModDependenciesTask::GetModDependenciesTask(Version version,
+                                               ModPlatform::ModLoaderTypes loaders,
+                                               QList<std::shared_ptr<Metadata::ModStruct>> mods,
+                                               QStringList modFileNames,
+                                               QList<std::shared_ptr<PackDependency>> selected)
+    : m_mods(mods), m_selected(selected), m_mods_file_names(modFileNames), m_version(version), m_loaderType(loaders)
+{
+    prepare();
+}
+
 void GetModDependenciesTask::prepare()
 {
     for (auto sel : m_selected) {
         if (checkDependencies(sel, m_version, m_loaderType))
             for (auto dep : getDependenciesForVersion(sel->version, sel->pack->provider)) {
-                addTask(prepareDependencyTask(dep, sel->pack->provider, 20));
+                addDependency(dep, sel->pack->provider, 20);
             }
     }
 }
@@ -131,122 +145,245 @@ QList<ModPlatform::Dependency> GetModDependenciesTask::getDependenciesForVersion
     return c_dependencies;
 }
 
-Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDependency> pDep)
+void GetModDependenciesTask::addDependency(const ModPlatform::Dependency& dep, const ModPlatform::ResourceProvider providerName, int level)
+{
+    auto id = dep.addonId.toString().isEmpty() ? "version/" + dep.version : dep.addonId.toString();
+    auto key = QString("%1:%2:%3:%4")
+                   .arg(ModPlatform::ProviderCapabilities::name(providerName), id, QString::number(m_loaderType), m_version.toString());
+    if (m_visited.contains(key))
+        return;  // another mod depends on it too
+    m_visited.insert(key);
+
+    auto pDep = std::make_shared<PackDependency>();
+    pDep->dependency = dep;
+    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
+    pDep->pack->addonId = dep.addonId;
+    pDep->pack->provider = providerName;
+
+    m_pack_dependencies.append(pDep);
+    m_frontier.append({ pDep, level });
+}
+
+void GetModDependenciesTask::executeTask()
+{
+    resolveLevel();
+}
+
+bool GetModDependenciesTask::abort()
+{
+    m_frontier.clear();
+    if (m_levelTask && m_levelTask->isRunning())
+        return m_levelTask->abort();
+    emitAborted();
+    return true;
+}
+
+// Every round looks up all the dependencies found in the previous one at once, so resolving takes a round trip per level of
+// the dependency tree instead of two per dependency.
+void GetModDependenciesTask::resolveLevel()
+{
+    m_missingInfo.removeIf([this](const std::shared_ptr<PackDependency>& pDep) { return !m_pack_dependencies.contains(pDep); });
+    if (m_frontier.isEmpty() && m_missingInfo.isEmpty()) {
+        m_levelTask.reset();
+        emitSucceeded();
+        return;
+    }
+
+    m_resolving = std::exchange(m_frontier, {});
+    auto infos = std::exchange(m_missingInfo, {});
+
+    auto levelTask = makeShared<ConcurrentTask>(tr("Get dependencies"), m_maxConcurrent);
+
+    QList<std::shared_ptr<PackDependency>> versionOnly;
+    for (auto& pending : m_resolving) {
+        auto pDep = pending.pDep;
+        if (!pDep->dependency.addonId.toString().isEmpty()) {
+            infos.append(pDep);
+        } else if (pDep->pack->provider == ModPlatform::ResourceProvider::MODRINTH) {
+            versionOnly.append(pDep);
+            continue;
+        }
+        if (auto task = getDependencyVersionTask(pDep))
+            levelTask->addTask(task);
+    }
+    if (!versionOnly.isEmpty())
+        levelTask->addTask(getVersionsTask(versionOnly));
+
+    for (auto provider : { ModPlatform::ResourceProvider::MODRINTH, ModPlatform::ResourceProvider::FLAME }) {
+        QList<std::shared_ptr<PackDependency>> pDeps;
+        for (auto& pDep : infos) {
+            if (pDep->pack->provider == provider)
+                pDeps.append(pDep);
+        }
+        if (!pDeps.isEmpty())
+            levelTask->addTask(getProjectsInfoTask(provider, pDeps));
+    }
+
+    m_levelTask = levelTask;
+    connect(levelTask.get(), &Task::succeeded, this, &GetModDependenciesTask::levelResolved);
+    connect(levelTask.get(), &Task::failed, this, &GetModDependenciesTask::emitFailed);
+    connect(levelTask.get(), &Task::aborted, this, &GetModDependenciesTask::emitAborted);
+    propagateFromOther(levelTask.get());
+    levelTask->start();
+}
+
+void GetModDependenciesTask::levelResolved()
 {
+    for (auto& pending : std::exchange(m_resolving, {})) {
+        processDependency(pending);
+    }
+    resolveLevel();
+}
+
+void GetModDependenciesTask::processDependency(const PendingDependency& pending)
+{
+    auto pDep = pending.pDep;
+    if (!m_pack_dependencies.contains(pDep))
+        return;  // its project could not be loaded
+
+    auto dep = pDep->dependency;
     auto provider = pDep->pack->provider;
+    if (!pDep->version.addonId.isValid()) {
+        m_pack_dependencies.removeAll(pDep);
+        if (m_loaderType & ModPlatform::Quilt) {  // falback for quilt
+            auto overide = ModPlatform::getOverrideDeps();
+            auto over = std::find_if(overide.cbegin(), overide.cend(),
+                                     [dep, provider](auto o) { return o.provider == provider && dep.addonId == o.quilt; });
+            if (over != overide.cend())
+                addDependency({ over->fabric, dep.type }, provider, pending.level);
+        }
+        return;
+    }
+    pDep->version.is_currently_selected = true;
+    pDep->pack->versions = { pDep->version };
+    pDep->pack->versionsLoaded = true;
+
+    if (pending.level == 0) {
+        m_pack_dependencies.removeAll(pDep);
+        qWarning() << "Dependency cycle exceeded";
+        return;
+    }
+    if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
+        pDep->pack->addonId = pDep->version.addonId;
+        auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider);
+        if (dep_.addonId != pDep->version.addonId) {
+            m_pack_dependencies.removeAll(pDep);
+            addDependency(dep_, provider, pending.level);
+            return;
+        }
+        m_missingInfo.append(pDep);
+    }
+    if (isLocalyInstalled(pDep)) {
+        m_pack_dependencies.removeAll(pDep);
+        return;
+    }
+    for (auto dep_ : getDependenciesForVersion(pDep->version, provider)) {
+        addDependency(dep_, provider, pending.level - 1);
+    }
+}
+
+Task::Ptr GetModDependenciesTask::getProjectsInfoTask(const ModPlatform::ResourceProvider providerName,
+                                                      QList<std::shared_ptr<PackDependency>> pDeps)
+{
+    QStringList addonIds;
+    for (auto& pDep : pDeps) {
+        addonIds.append(pDep->pack->addonId.toString());
+    }
+
     auto responseInfo = std::make_shared<QByteArray>();
-    auto info = getAPI(provider)->getProject(pDep->pack->addonId.toString(), responseInfo.get());
-    connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDep] {
+    auto info = getAPI(providerName)->getProjects(addonIds, responseInfo.get());
+    connect(info.get(), &Task::succeeded, this, [this, responseInfo, providerName, pDeps] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*responseInfo, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
-            removePack(pDep->pack->addonId);
+            for (auto& pDep : pDeps) {
+                m_pack_dependencies.removeAll(pDep);
+            }
             qWarning() << "Error while parsing JSON response for mod info at" << parse_error.offset
                        << "reason:" << parse_error.errorString();
             qDebug() << *responseInfo;
             return;
         }
-        try {
-            auto obj = provider == ModPlatform::ResourceProvider::FLAME ? Json::requireObject(Json::requireObject(doc), "data")
-                                                                        : Json::requireObject(doc);
 
-            getAPI(provider)->loadIndexedPack(*pDep->pack, obj);
+        QHash<QString, QJsonObject> projects;
+        try {
+            auto arr = providerName == ModPlatform::ResourceProvider::FLAME ? Json::requireArray(Json::requireObject(doc), "data")
+                                                                            : Json::requireArray(doc);
+            for (auto project : arr) {
+                auto obj = Json::requireObject(project);
+                auto id = obj.value("id");
+                projects.insert(id.isString() ? id.toString() : QString::number(id.toInteger()), obj);
+            }
         } catch (const JSONValidationError& e) {
-            removePack(pDep->pack->addonId);
             qDebug() << doc;
             qWarning() << "Error while reading mod info:" << e.cause();
         }
+
+        for (auto& pDep : pDeps) {
+            auto project = projects.find(pDep->pack->addonId.toString());
+            if (project == projects.end()) {
+                qWarning() << "Missing mod info for" << pDep->pack->addonId.toString();
+                m_pack_dependencies.removeAll(pDep);
+                continue;
+            }
+            try {
+                getAPI(providerName)->loadIndexedPack(*pDep->pack, *project);
+            } catch (const JSONValidationError& e) {
+                m_pack_dependencies.removeAll(pDep);
+                qWarning() << "Error while reading mod info:" << e.cause();
+            }
+        }
     });
     return info;
 }
 
-Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Dependency& dep,
-                                                        const ModPlatform::ResourceProvider providerName,
-                                                        int level)
+Task::Ptr GetModDependenciesTask::getVersionsTask(QList<std::shared_ptr<PackDependency>> pDeps)
 {
-    auto pDep = std::make_shared<PackDependency>();
-    pDep->dependency = dep;
-    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
-    pDep->pack->addonId = dep.addonId;
-    pDep->pack->provider = providerName;
-
-    m_pack_dependencies.append(pDep);
-
-    auto provider = providerName;
-
-    auto tasks = makeShared<SequentialTask>(
-        QString("DependencyInfo: %1").arg(dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString()));
-
-    if (!dep.addonId.toString().isEmpty()) {
-        tasks->addTask(getProjectInfoTask(pDep));
+    QStringList versionIds;
+    for (auto& pDep : pDeps) {
+        versionIds.append(pDep->dependency.version);
     }
 
-    ResourceAPI::DependencySearchArgs args = { dep, m_version, m_loaderType };
-    ResourceAPI::Callback<ModPlatform::IndexedVersion> callbacks;
-    callbacks.on_fail = [](QString reason, int) {
-        qCritical() << tr("A network error occurred. Could not load project dependencies:%1").arg(reason);
-    };
-    callbacks.on_succeed = [dep, provider, pDep, level, this](auto& pack) {
-        pDep->version = pack;
-        if (!pDep->version.addonId.isValid()) {
-            if (m_loaderType & ModPlatform::Quilt) {  // falback for quilt
-                auto overide = ModPlatform::getOverrideDeps();
-                auto over = std::find_if(overide.cbegin(), overide.cend(),
-                                         [dep, provider](auto o) { return o.provider == provider && dep.addonId == o.quilt; });
-                if (over != overide.cend()) {
-                    removePack(dep.addonId);
-                    addTask(prepareDependencyTask({ over->fabric, dep.type }, provider, level));
-                    return;
-                }
-            }
-            removePack(dep.addonId);
+    auto response = std::make_shared<QByteArray>();
+    auto task = m_modrinthAPI.getVersions(versionIds, response.get());
+    connect(task.get(), &Task::succeeded, this, [this, response, pDeps] {
+        QJsonParseError parse_error{};
+        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            qWarning() << "Error while parsing JSON response for getting dependency versions at" << parse_error.offset
+                       << "reason:" << parse_error.errorString();
+            qWarning() << *response;
             return;
         }
-        pDep->version.is_currently_selected = true;
-        pDep->pack->versions = { pDep->version };
-        pDep->pack->versionsLoaded = true;
 
-        if (level == 0) {
-            removePack(dep.addonId);
-            qWarning() << "Dependency cycle exceeded";
-            return;
-        }
-        if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
-            pDep->pack->addonId = pDep->version.addonId;
-            auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider);
-            if (dep_.addonId != pDep->version.addonId) {
-                removePack(pDep->version.addonId);
-                addTask(prepareDependencyTask(dep_, provider, level));
-            } else {
-                addTask(getProjectInfoTask(pDep));
+        QHash<QString, ModPlatform::IndexedVersion> versions;
+        for (auto version : doc.array()) {
+            auto obj = version.toObject();
+            try {
+                auto file = m_modrinthAPI.loadIndexedPackVersion(obj, ModPlatform::ResourceType::Mod);
+                if (!file.loaders || m_loaderType & file.loaders)  // Heuristic to check if the returned value is valid
+                    versions.insert(file.fileId.toString(), file);
+            } catch (const JSONValidationError& e) {
+                qWarning() << "Error while reading dependency version:" << e.cause();
             }
         }
-        if (isLocalyInstalled(pDep)) {
-            removePack(pDep->version.addonId);
-            return;
-        }
-        for (auto dep_ : getDependenciesForVersion(pDep->version, provider)) {
-            addTask(prepareDependencyTask(dep_, provider, level - 1));
+        for (auto& pDep : pDeps) {
+            pDep->version = versions.value(pDep->dependency.version);
         }
-    };
-
-    auto version = getAPI(provider)->getDependencyVersion(std::move(args), std::move(callbacks));
-    tasks->addTask(version);
-    return tasks;
+    });
+    return task;
 }
 
-void GetModDependenciesTask::removePack(const QVariant& addonId)
+Task::Ptr GetModDependenciesTask::getDependencyVersionTask(std::shared_ptr<PackDependency> pDep)
 {
-    auto pred = [addonId](const std::shared_ptr<PackDependency>& v) { return v->pack->addonId == addonId; };
-#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
-    m_pack_dependencies.removeIf(pred);
-#else
-    for (auto it = m_pack_dependencies.begin(); it != m_pack_dependencies.end();)
-        if (pred(*it))
-            it = m_pack_dependencies.erase(it);
-        else
-            ++it;
-#endif
+    ResourceAPI::DependencySearchArgs args = { pDep->dependency, m_version, m_loaderType };
+    ResourceAPI::Callback<ModPlatform::IndexedVersion> callbacks;
+    callbacks.on_fail = [](QString reason, int) {
+        qCritical() << tr("A network error occurred. Could not load project dependencies:%1").arg(reason);
+    };
+    callbacks.on_succeed = [pDep](auto& version) { pDep->version = version; };
+
+    return getAPI(pDep->pack->provider)->getDependencyVersion(std::move(args), std::move(callbacks));
 }
 
 auto GetModDependenciesTask::getExtraInfo() -> QHash<QString, PackDependencyExtraInfo>
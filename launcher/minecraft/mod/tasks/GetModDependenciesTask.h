@@ -20,6 +20,7 @@
 
 #include <QDir>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 #include <functional>
 #include <memory>
@@ -30,11 +31,10 @@
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
-#include "tasks/SequentialTask.h"
 #include "tasks/Task.h"
 #include "ui/pages/modplatform/ModModel.h"
 
-class GetModDependenciesTask : public SequentialTask {
+class GetModDependenciesTask : public Task {
     Q_OBJECT
    public:
     using Ptr = shared_qobject_ptr<GetModDependenciesTask>;
@@ -57,11 +57,37 @@ class GetModDependenciesTask : public SequentialTask {
     };
 
     explicit GetModDependenciesTask(BaseInstance* instance, ModFolderModel* folder, QList<std::shared_ptr<PackDependency>> selected);
+    /** Resolves for the given Minecraft version and mod loaders, next to the installed mods given by their metadata and file names. */
+    GetModDependenciesTask(Version version,
+                           ModPlatform::ModLoaderTypes loaders,
+                           QList<std::shared_ptr<Metadata::ModStruct>> mods,
+                           QStringList modFileNames,
+                           QList<std::shared_ptr<PackDependency>> selected);
 
     auto getDependecies() const -> QList<std::shared_ptr<PackDependency>> { return m_pack_dependencies; }
     QHash<QString, PackDependencyExtraInfo> getExtraInfo();
 
+    bool canAbort() const override { return true; }
+
+   public slots:
+    bool abort() override;
+
+   protected slots:
+    void executeTask() override;
+
+   protected:
+    // the lookups of a round, each one fills in the dependencies it is given when it succeeds
+    virtual Task::Ptr getProjectsInfoTask(ModPlatform::ResourceProvider providerName, QList<std::shared_ptr<PackDependency>> pDeps);
+    virtual Task::Ptr getVersionsTask(QList<std::shared_ptr<PackDependency>> pDeps);
+    virtual Task::Ptr getDependencyVersionTask(std::shared_ptr<PackDependency> pDep);
+
    private:
+    // a dependency to look up, 'level' being how many more levels of dependencies may follow it
+    struct PendingDependency {
+        std::shared_ptr<PackDependency> pDep;
+        int level;
+    };
+
     inline ResourceAPI* getAPI(ModPlatform::ResourceProvider provider)
     {
         if (provider == ModPlatform::ResourceProvider::FLAME)
@@ -70,14 +96,16 @@ class GetModDependenciesTask : public SequentialTask {
             return &m_modrinthAPI;
     }
 
-   protected slots:
-    Task::Ptr prepareDependencyTask(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
     QList<ModPlatform::Dependency> getDependenciesForVersion(const ModPlatform::IndexedVersion&,
                                                              ModPlatform::ResourceProvider providerName);
     void prepare();
-    Task::Ptr getProjectInfoTask(std::shared_ptr<PackDependency> pDep);
     ModPlatform::Dependency getOverride(const ModPlatform::Dependency&, ModPlatform::ResourceProvider providerName);
-    void removePack(const QVariant& addonId);
+
+    /** Queues 'dep' for the next round of lookups, unless it was looked up already. */
+    void addDependency(const ModPlatform::Dependency& dep, ModPlatform::ResourceProvider providerName, int level);
+    void resolveLevel();
+    void levelResolved();
+    void processDependency(const PendingDependency& pending);
 
     bool isLocalyInstalled(std::shared_ptr<PackDependency> pDep);
     bool maybeInstalled(std::shared_ptr<PackDependency> pDep);
@@ -90,6 +118,18 @@ class GetModDependenciesTask : public SequentialTask {
 
     Version m_version;
     ModPlatform::ModLoaderTypes m_loaderType;
+    int m_maxConcurrent = 6;
+
+    // dependencies looked up in the next round
+    QList<PendingDependency> m_frontier;
+    // dependencies looked up in the current round
+    QList<PendingDependency> m_resolving;
+    // dependencies whose project was only known after finding their version
+    QList<std::shared_ptr<PackDependency>> m_missingInfo;
+    // every dependency looked up so far, by provider, project, mod loader and Minecraft version
+    QSet<QString> m_visited;
+
+    Task::Ptr m_levelTask;
 
     ModrinthAPI m_modrinthAPI;
     FlameAPI m_flameAPI;
@@ -0,0 +1,413 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ModpackUpdatePrefetcher.h"
+
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+#include "Application.h"
+#include "BaseInstance.h"
+#include "FileSystem.h"
+#include "InstanceList.h"
+#include "Json.h"
+#include "archive/ArchiveReader.h"
+#include "modplatform/flame/FlameModIndex.h"
+#include "net/ApiDownload.h"
+#include "net/ChecksumValidator.h"
+#include "net/NetJob.h"
+#include "settings/SettingsObject.h"
+
+namespace {
+const QString s_cacheBase = "ModpackUpdates";
+constexpr int s_firstCheckDelay = 5 * 60 * 1000;  // msecs, so the launcher gets started first
+constexpr int s_minimumInterval = 15;             // minutes
+constexpr int s_maxConcurrentDownloads = 2;
+
+QByteArray readInstalled(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll();
+}
+
+QByteArray readFromPack(const QString& packPath, const QString& fileName)
+{
+    MMCZip::ArchiveReader pack(packPath);
+    auto file = pack.goToFile(fileName);
+    if (!file)
+        return {};
+    return file->readAll();
+}
+}  // namespace
+
+ModpackUpdatePrefetcher::ModpackUpdatePrefetcher(QObject* parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ModpackUpdatePrefetcher::checkAll);
+    connect(APPLICATION->settings()->getSetting("ModpackUpdatePrefetch").get(), &Setting::SettingChanged, this,
+            &ModpackUpdatePrefetcher::updateTimer);
+    connect(APPLICATION->settings()->getSetting("ModpackUpdatePrefetchInterval").get(), &Setting::SettingChanged, this,
+            &ModpackUpdatePrefetcher::rescheduleTimer);
+    updateTimer();
+}
+
+ModpackUpdatePrefetcher::~ModpackUpdatePrefetcher()
+{
+    m_queue.clear();
+    if (m_task) {
+        // the API callbacks are connected without a context, they must not be called anymore
+        disconnect(m_task.get(), nullptr, nullptr, nullptr);
+        m_task->abort();
+    }
+}
+
+QString ModpackUpdatePrefetcher::modrinthKey(const QByteArray& sha512)
+{
+    return "modrinth/" + QString::fromLatin1(sha512.toHex());
+}
+
+QString ModpackUpdatePrefetcher::flameKey(int fileId)
+{
+    return "flame/" + QString::number(fileId);
+}
+
+bool ModpackUpdatePrefetcher::takePrefetched(const QString& key, const QString& targetPath)
+{
+    auto path = FS::PathCombine(APPLICATION->metacache()->getBasePath(s_cacheBase), key);
+    if (!QFileInfo::exists(path))
+        return false;
+    if (!FS::ensureFilePathExists(targetPath) || !FS::move(path, targetPath))
+        return false;
+
+    APPLICATION->metacache()->evictEntry(APPLICATION->metacache()->getEntry(s_cacheBase, key));
+    return true;
+}
+
+QList<ModpackUpdatePrefetcher::File> ModpackUpdatePrefetcher::modrinthFiles(const QByteArray& index)
+{
+    QList<File> files;
+    for (auto value : QJsonDocument::fromJson(index).object()["files"].toArray()) {
+        auto file = value.toObject();
+
+        // same as ModrinthCreationTask, files the client doesn't support are never downloaded
+        auto env = file["env"].toObject();
+        if (!env.isEmpty() && env["client"].toString("unsupported") == "unsupported")
+            continue;
+
+        auto sha512 = QByteArray::fromHex(file["hashes"].toObject()["sha512"].toString().toLatin1());
+        auto downloads = file["downloads"].toArray();
+        if (sha512.isEmpty() || downloads.isEmpty())
+            continue;
+        QUrl url(downloads.first().toString(), QUrl::StrictMode);
+        if (!url.isValid())
+            continue;
+
+        files.append({ modrinthKey(sha512), url, QCryptographicHash::Sha512, sha512 });
+    }
+    return files;
+}
+
+QList<int> ModpackUpdatePrefetcher::flameFiles(const QByteArray& manifest)
+{
+    QList<int> fileIds;
+    for (auto value : QJsonDocument::fromJson(manifest).object()["files"].toArray()) {
+        auto fileId = value.toObject()["fileID"].toInt();
+        if (fileId > 0)
+            fileIds.append(fileId);
+    }
+    return fileIds;
+}
+
+void ModpackUpdatePrefetcher::updateTimer()
+{
+    if (!APPLICATION->settings()->get("ModpackUpdatePrefetch").toBool()) {
+        m_timer.stop();
+        m_queue.clear();
+        // nothing is pruned after a round that was cut short
+        m_roundComplete = false;
+        if (m_task)
+            m_task->abort();
+        return;
+    }
+
+    if (!m_timer.isActive() && m_queue.isEmpty() && !m_task)
+        m_timer.start(s_firstCheckDelay);
+}
+
+int ModpackUpdatePrefetcher::interval() const
+{
+    return std::max(APPLICATION->settings()->get("ModpackUpdatePrefetchInterval").toInt(), s_minimumInterval) * 60 * 1000;
+}
+
+void ModpackUpdatePrefetcher::rescheduleTimer()
+{
+    // only the wait for the next round changes, the first check and a running round are left alone
+    if (!m_timer.isActive() || !m_sinceRound.isValid())
+        return;
+    m_timer.start(static_cast<int>(std::max<qint64>(interval() - m_sinceRound.elapsed(), 0)));
+}
+
+void ModpackUpdatePrefetcher::checkAll()
+{
+    // a round is still going
+    if (!m_queue.isEmpty() || m_task)
+        return;
+
+    m_wanted.clear();
+    m_roundComplete = true;
+
+    auto instances = APPLICATION->instances();
+    for (int i = 0; i < instances->count(); i++) {
+        auto instance = instances->at(i);
+        if (!instance->isManagedPack() || instance->getManagedPackID().isEmpty())
+            continue;
+        auto type = instance->getManagedPackType();
+        if (type == "modrinth" || type == "flame")
+            m_queue.append(instance->id());
+    }
+
+    qDebug() << "Looking for modpack updates to prefetch for" << m_queue.size() << "instances";
+    checkNext();
+}
+
+void ModpackUpdatePrefetcher::checkNext()
+{
+    m_task.reset();
+
+    while (!m_queue.isEmpty()) {
+        if (auto instance = APPLICATION->instances()->getInstanceById(m_queue.takeFirst())) {
+            checkInstance(instance);
+            return;
+        }
+    }
+
+    // the round is over
+    if (m_roundComplete)
+        pruneUnwanted();
+
+    m_sinceRound.start();
+    if (APPLICATION->settings()->get("ModpackUpdatePrefetch").toBool())
+        m_timer.start(interval());
+}
+
+void ModpackUpdatePrefetcher::instanceDone(bool checked)
+{
+    if (!checked)
+        m_roundComplete = false;
+    checkNext();
+}
+
+void ModpackUpdatePrefetcher::checkInstance(BaseInstance* instance)
+{
+    auto id = instance->id();
+
+    ResourceAPI::Callback<QVector<ModPlatform::IndexedVersion>> callbacks{};
+    callbacks.on_succeed = [this, id](auto& versions) {
+        auto instance = APPLICATION->instances()->getInstanceById(id);
+        // versions are sorted newest first, that one is suggested when updating
+        if (!instance || versions.isEmpty() || versions.first().fileId.toString() == instance->getManagedPackVersionID() ||
+            versions.first().downloadUrl.isEmpty()) {
+            instanceDone(true);
+            return;
+        }
+        fetchPack(id, versions.first());
+    };
+    callbacks.on_fail = [this, id](QString reason, int) {
+        qWarning() << "Failed to look for an update of the modpack of" << id << ":" << reason;
+        instanceDone(false);
+    };
+    callbacks.on_abort = [this] { instanceDone(false); };
+
+    ModPlatform::IndexedPack pack{ instance->getManagedPackID() };
+    ResourceAPI::VersionSearchArgs args{ std::make_shared<ModPlatform::IndexedPack>(pack), {}, {}, ModPlatform::ResourceType::Modpack };
+    if (instance->getManagedPackType() == "modrinth")
+        m_task = m_modrinthApi.getProjectVersions(std::move(args), std::move(callbacks));
+    else
+        m_task = m_flameApi.getProjectVersions(std::move(args), std::move(callbacks));
+    m_task->start();
+}
+
+void ModpackUpdatePrefetcher::fetchPack(const QString& instanceId, const ModPlatform::IndexedVersion& version)
+{
+    qDebug() << "Prefetching version" << version.version << "of the modpack of" << instanceId;
+
+    // the entry InstanceImportTask downloads the pack into, so updating only has to check it is still current
+    QUrl url(version.downloadUrl);
+    auto entry = APPLICATION->metacache()->resolveEntry("general", url.host() + '/' + url.path());
+    entry->setStale(true);
+
+    auto job = makeShared<NetJob>(tr("Modpack update prefetch"), APPLICATION->network(), 1);
+    job->setAskRetry(false);
+    auto dl = Net::ApiDownload::makeCached(url, entry);
+    dl->setPriority(QNetworkRequest::LowPriority);
+    job->addNetAction(dl);
+
+    connect(job.get(), &Task::succeeded, this, [this, instanceId, path = entry->getFullPath()] { findChangedFiles(instanceId, path); });
+    connect(job.get(), &Task::failed, this, [this, instanceId](QString reason) {
+        qWarning() << "Failed to prefetch the modpack update of" << instanceId << ":" << reason;
+        instanceDone(false);
+    });
+    connect(job.get(), &Task::aborted, this, [this] { instanceDone(false); });
+
+    m_task = job;
+    m_task->start();
+}
+
+QList<ModpackUpdatePrefetcher::File> ModpackUpdatePrefetcher::changedModrinthFiles(const QString& instanceRoot, const QString& packPath)
+{
+    QSet<QString> installed;
+    for (const auto& file : modrinthFiles(readInstalled(FS::PathCombine(instanceRoot, "mrpack", "modrinth.index.json"))))
+        installed.insert(file.key);
+
+    QList<File> changed;
+    for (const auto& file : modrinthFiles(readFromPack(packPath, "modrinth.index.json"))) {
+        if (!installed.contains(file.key))
+            changed.append(file);
+    }
+    return changed;
+}
+
+QList<int> ModpackUpdatePrefetcher::changedFlameFiles(const QString& instanceRoot, const QString& packPath)
+{
+    auto installed = flameFiles(readInstalled(FS::PathCombine(instanceRoot, "flame", "manifest.json")));
+
+    QList<int> changed;
+    for (auto fileId : flameFiles(readFromPack(packPath, "manifest.json"))) {
+        if (!installed.contains(fileId))
+            changed.append(fileId);
+    }
+    return changed;
+}
+
+void ModpackUpdatePrefetcher::findChangedFiles(const QString& instanceId, const QString& packPath)
+{
+    auto instance = APPLICATION->instances()->getInstanceById(instanceId);
+    if (!instance) {
+        instanceDone(true);
+        return;
+    }
+
+    if (instance->getManagedPackType() == "modrinth")
+        prefetch(changedModrinthFiles(instance->instanceRoot(), packPath));
+    else
+        resolveFlameFiles(changedFlameFiles(instance->instanceRoot(), packPath));
+}
+
+void ModpackUpdatePrefetcher::resolveFlameFiles(const QList<int>& fileIds)
+{
+    if (fileIds.isEmpty()) {
+        prefetch({});
+        return;
+    }
+
+    QStringList ids;
+    for (auto fileId : fileIds)
+        ids.append(QString::number(fileId));
+
+    auto response = std::make_shared<QByteArray>();
+    m_task = m_flameApi.getFiles(ids, response.get());
+
+    connect(m_task.get(), &Task::succeeded, this, [this, response, single = ids.size() == 1] {
+        QList<File> files;
+        try {
+            auto doc = Json::requireDocument(*response);
+            QJsonArray entries;
+            if (single)
+                entries = { Json::requireObject(Json::requireObject(doc), "data") };
+            else
+                entries = Json::requireArray(Json::requireObject(doc), "data");
+
+            for (auto entry : entries) {
+                auto entry_obj = Json::requireObject(entry);
+                auto version = FlameMod::loadIndexedPackVersion(entry_obj);
+                // blocked mods can't be downloaded by the launcher
+                if (version.downloadUrl.isEmpty())
+                    continue;
+
+                File file{ flameKey(version.fileId.toInt()), QUrl(version.downloadUrl) };
+                if (version.hash_type == "sha1") {
+                    file.hash = QByteArray::fromHex(version.hash.toLatin1());
+                } else if (version.hash_type == "md5") {
+                    file.algorithm = QCryptographicHash::Md5;
+                    file.hash = QByteArray::fromHex(version.hash.toLatin1());
+                }
+                files.append(file);
+            }
+        } catch (Json::JsonException& e) {
+            qWarning() << "Failed to parse the files of a CurseForge modpack update:" << e.cause();
+            instanceDone(false);
+            return;
+        }
+        prefetch(files);
+    });
+    connect(m_task.get(), &Task::failed, this, [this](QString reason) {
+        qWarning() << "Failed to get the files of a CurseForge modpack update:" << reason;
+        instanceDone(false);
+    });
+    connect(m_task.get(), &Task::aborted, this, [this] { instanceDone(false); });
+
+    m_task->start();
+}
+
+void ModpackUpdatePrefetcher::prefetch(const QList<File>& files)
+{
+    auto job = makeShared<NetJob>(tr("Modpack update prefetch"), APPLICATION->network(), s_maxConcurrentDownloads);
+    job->setAskRetry(false);
+
+    for (const auto& file : files) {
+        m_wanted.insert(file.key);
+
+        auto entry = APPLICATION->metacache()->resolveEntry(s_cacheBase, file.key);
+        // prefetched in an earlier round
+        if (QFileInfo::exists(entry->getFullPath()))
+            continue;
+
+        auto dl = Net::ApiDownload::makeCached(file.url, entry);
+        dl->setPriority(QNetworkRequest::LowPriority);
+        if (!file.hash.isEmpty())
+            dl->addValidator(new Net::ChecksumValidator(file.algorithm, file.hash));
+        job->addNetAction(dl);
+    }
+
+    if (job->size() == 0) {
+        instanceDone(true);
+        return;
+    }
+
+    qDebug() << "Prefetching" << job->size() << "files of a modpack update";
+    // files that failed are downloaded when updating, like before
+    connect(job.get(), &Task::finished, this, [this] { instanceDone(true); });
+    m_task = job;
+    m_task->start();
+}
+
+QStringList ModpackUpdatePrefetcher::pruneFiles(const QString& basePath, const QSet<QString>& wanted)
+{
+    QStringList pruned;
+    QDir base(basePath);
+    QDirIterator it(base.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        auto path = it.next();
+        auto key = base.relativeFilePath(path);
+        if (wanted.contains(key))
+            continue;
+        if (QFile::remove(path))
+            pruned.append(key);
+    }
+    return pruned;
+}
+
+void ModpackUpdatePrefetcher::pruneUnwanted()
+{
+    // files of versions that were installed or replaced by a newer one since
+    auto metacache = APPLICATION->metacache();
+    for (const auto& key : pruneFiles(metacache->getBasePath(s_cacheBase), m_wanted))
+        metacache->evictEntry(metacache->getEntry(s_cacheBase, key));
+}
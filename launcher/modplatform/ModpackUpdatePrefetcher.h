@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+#include "modplatform/ModIndex.h"
+#include "modplatform/flame/FlameAPI.h"
+#include "modplatform/modrinth/ModrinthAPI.h"
+#include "tasks/Task.h"
+
+class BaseInstance;
+
+/**
+ * Downloads the files of new versions of the modpacks of managed instances before the user asks for them.
+ *
+ * Every few hours, the newest version of each Modrinth and CurseForge pack is looked up. When it is not the installed one, the
+ * pack itself is downloaded into the same cache entry an update would use, and the files it has that the installed version does
+ * not are downloaded in the background. Updating then takes those files instead of downloading them.
+ *
+ * This is off unless the ModpackUpdatePrefetch setting is enabled. ModpackUpdatePrefetchInterval is the time between two checks,
+ * in minutes.
+ */
+class ModpackUpdatePrefetcher : public QObject {
+    Q_OBJECT
+   public:
+    struct File {
+        QString key;
+        QUrl url;
+        QCryptographicHash::Algorithm algorithm = QCryptographicHash::Sha1;
+        QByteArray hash;  ///< empty when it is not known
+    };
+
+    explicit ModpackUpdatePrefetcher(QObject* parent = nullptr);
+    ~ModpackUpdatePrefetcher() override;
+
+    /** The key of a file of a Modrinth pack, from its SHA-512. */
+    static QString modrinthKey(const QByteArray& sha512);
+    /** The key of a file of a CurseForge pack, from its file id. */
+    static QString flameKey(int fileId);
+
+    /** Moves the file prefetched as 'key' to 'targetPath'. Returns false if there is none. */
+    static bool takePrefetched(const QString& key, const QString& targetPath);
+
+    /** The client files of a modrinth.index.json. */
+    static QList<File> modrinthFiles(const QByteArray& index);
+    /** The file ids of the mods of a CurseForge manifest.json. */
+    static QList<int> flameFiles(const QByteArray& manifest);
+
+    /** The files of the Modrinth pack at 'packPath' that the instance at 'instanceRoot' doesn't have. */
+    static QList<File> changedModrinthFiles(const QString& instanceRoot, const QString& packPath);
+    /** The file ids of the CurseForge pack at 'packPath' that the instance at 'instanceRoot' doesn't have. */
+    static QList<int> changedFlameFiles(const QString& instanceRoot, const QString& packPath);
+    /** Deletes the files under 'basePath' whose keys are not in 'wanted'. Returns the keys of the deleted files. */
+    static QStringList pruneFiles(const QString& basePath, const QSet<QString>& wanted);
+
+   public slots:
+    /** Checks every managed instance now. */
+    void checkAll();
+
+   private:
+    void updateTimer();
+    void rescheduleTimer();
+    int interval() const;
+    void checkNext();
+    void checkInstance(BaseInstance* instance);
+    void fetchPack(const QString& instanceId, const ModPlatform::IndexedVersion& version);
+    void findChangedFiles(const QString& instanceId, const QString& packPath);
+    void resolveFlameFiles(const QList<int>& fileIds);
+    void prefetch(const QList<File>& files);
+    void instanceDone(bool checked);
+    void pruneUnwanted();
+
+   private:
+    QTimer m_timer;
+    // since the end of the last round, invalid until there was one
+    QElapsedTimer m_sinceRound;
+
+    ModrinthAPI m_modrinthApi;
+    FlameAPI m_flameApi;
+
+    QStringList m_queue;
+    Task::Ptr m_task;
+
+    // the keys of the files prefetched for the instances checked so far, the others are deleted after a complete round
+    QSet<QString> m_wanted;
+    bool m_roundComplete = true;
+};
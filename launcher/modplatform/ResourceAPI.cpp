@@ -8,6 +8,11 @@
 
 #include "net/ApiDownload.h"
 
+Net::Download::Ptr ResourceAPI::makeCachedRequest(QUrl url, QByteArray* response) const
+{
+    return Net::ApiDownload::makeCached(url, response, ModPlatform::ProviderCapabilities::name(provider()));
+}
+
 Task::Ptr ResourceAPI::searchProjects(SearchArgs&& args, Callback<QList<ModPlatform::IndexedPack::Ptr>>&& callbacks) const
 {
     auto search_url_optional = getSearchURL(args);
@@ -21,7 +26,7 @@ Task::Ptr ResourceAPI::searchProjects(SearchArgs&& args, Callback<QList<ModPlatf
     auto response = std::make_shared<QByteArray>();
     auto netJob = makeShared<NetJob>(QString("%1::Search").arg(debugName()), APPLICATION->network());
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(search_url), response.get()));
+    netJob->addNetAction(makeCachedRequest(QUrl(search_url), response.get()));
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks] {
         QJsonParseError parse_error{};
@@ -86,7 +91,7 @@ Task::Ptr ResourceAPI::getProjectVersions(VersionSearchArgs&& args, Callback<QVe
     auto netJob = makeShared<NetJob>(QString("%1::Versions").arg(args.pack->name), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response.get()));
+    netJob->addNetAction(makeCachedRequest(versions_url, response.get()));
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks, args] {
         QJsonParseError parse_error{};
@@ -206,7 +211,7 @@ Task::Ptr ResourceAPI::getDependencyVersion(DependencySearchArgs&& args, Callbac
     auto netJob = makeShared<NetJob>(QString("%1::Dependency").arg(args.dependency.addonId.toString()), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response.get()));
+    netJob->addNetAction(makeCachedRequest(versions_url, response.get()));
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks, args] {
         QJsonParseError parse_error{};
@@ -294,7 +299,7 @@ Task::Ptr ResourceAPI::getProject(QString addonId, QByteArray* response) const
 
     auto netJob = makeShared<NetJob>(QString("%1::GetProject").arg(addonId), APPLICATION->network());
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(project_url), response));
+    netJob->addNetAction(makeCachedRequest(QUrl(project_url), response));
 
     return netJob;
 }
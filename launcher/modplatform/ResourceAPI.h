@@ -49,6 +49,7 @@
 
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceType.h"
+#include "net/Download.h"
 #include "tasks/Task.h"
 
 /* Simple class with a common interface for interacting with APIs */
@@ -122,6 +123,12 @@ class ResourceAPI {
    protected:
     inline QString debugName() const { return "External resource API"; }
 
+    /** The platform this API belongs to. */
+    virtual ModPlatform::ResourceProvider provider() const = 0;
+
+    /** A GET request to the API, answered from the API response cache while the cached response is fresh. */
+    Net::Download::Ptr makeCachedRequest(QUrl url, QByteArray* response) const;
+
     QString mapMCVersionToModrinth(Version v) const;
 
     QString getGameVersionsString(std::vector<Version> mcVersions) const;
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ATLModLayers.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+#include "FileSystem.h"
+#include "MMCZip.h"
+
+namespace ATLauncher {
+
+ModLayers::ModLayers(QString stagingPath) : m_stagingPath(std::move(stagingPath)) {}
+
+ModLayers::~ModLayers()
+{
+    stop();
+    for (auto& future : m_futures)
+        future.waitForFinished();
+}
+
+void ModLayers::clear()
+{
+    stop();
+    m_layers.clear();
+    m_bySource.clear();
+    m_futures.clear();
+    // the layers still running keep the old flag
+    m_stopped = std::make_shared<std::atomic_bool>(false);
+}
+
+void ModLayers::add(Layer layer)
+{
+    m_bySource[layer.source].append(m_layers.size());
+    m_layers.append(std::move(layer));
+}
+
+void ModLayers::start(const QString& source)
+{
+    for (auto index : m_bySource.value(source)) {
+        if (m_futures.contains(index))
+            continue;
+        auto layer = m_layers[index];
+        auto path = layerPath(index);
+        auto stopped = m_stopped;
+        m_futures.insert(index,
+                         QtConcurrent::run(QThreadPool::globalInstance(), [layer, path, stopped] { return make(layer, path, *stopped); }));
+    }
+}
+
+void ModLayers::startAll()
+{
+    for (auto iter = m_bySource.cbegin(); iter != m_bySource.cend(); iter++)
+        start(iter.key());
+}
+
+QString ModLayers::layerPath(int index) const
+{
+    return FS::PathCombine(m_stagingPath, "modlayers", QString::number(index));
+}
+
+bool ModLayers::make(const Layer& layer, const QString& path, const std::atomic_bool& stopped)
+{
+    if (stopped)
+        return false;
+
+    auto targetPath = FS::PathCombine(path, layer.target);
+    switch (layer.kind) {
+        case Layer::Kind::Extract:
+            qDebug() << "Extracting " + layer.source + " to " + layer.target;
+            if (!MMCZip::extractDir(layer.source, layer.entry, targetPath)) {
+                // assume error
+                return false;
+            }
+            return true;
+        case Layer::Kind::Decomp:
+            qDebug() << "Extracting " + layer.entry + " to " + layer.target;
+            if (!MMCZip::extractFile(layer.source, layer.entry, targetPath)) {
+                qWarning() << "Failed to extract" << layer.entry;
+                return false;
+            }
+            return true;
+        case Layer::Kind::Copy: {
+            FS::copy fileCopyOperation(layer.source, targetPath);
+            if (!fileCopyOperation()) {
+                qWarning() << "Failed to copy" << layer.source << "to" << layer.target;
+                return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ModLayers::apply()
+{
+    // each layer replaces the files of those before it
+    auto minecraftPath = FS::PathCombine(m_stagingPath, "minecraft");
+    for (int i = 0; i < m_layers.size(); i++) {
+        // a layer that was never started has no result
+        auto future = m_futures.value(i);
+        future.waitForFinished();
+        if (*m_stopped || future.resultCount() == 0 || !future.result())
+            return false;
+
+        auto path = layerPath(i);
+        if (QFileInfo::exists(path) && !FS::mergeFolder(minecraftPath, path, true)) {
+            qWarning() << "Failed to put" << m_layers[i].source << "into the instance";
+            return false;
+        }
+    }
+    return FS::deletePath(FS::PathCombine(m_stagingPath, "modlayers"));
+}
+
+void ModLayers::stop()
+{
+    *m_stopped = true;
+}
+
+QList<QFuture<void>> ModLayers::pending() const
+{
+    QList<QFuture<void>> pending;
+    for (auto& future : m_futures) {
+        if (!future.isFinished())
+            pending.append(QFuture<void>(future));
+    }
+    return pending;
+}
+
+}  // namespace ATLauncher
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+namespace ATLauncher {
+
+/**
+ * The files the mods of a pack put into the instance: a folder extracted from a mod, a file decompressed from it, or the mod itself.
+ *
+ * Each layer is made in a folder of its own on the thread pool as soon as its mod is downloaded. apply() then puts the layers over
+ * the minecraft folder in the order they were added, the order the original installation extracted them in, so the result is the
+ * same no matter which download finished first.
+ */
+class ModLayers {
+   public:
+    struct Layer {
+        enum class Kind { Extract, Decomp, Copy } kind;
+        QString source;  ///< the downloaded file
+        QString entry;   ///< the folder (Extract) or the file (Decomp) to take out of the source
+        QString target;  ///< relative to the minecraft folder
+    };
+
+    /// the layers are made under `stagingPath`, and put into its minecraft folder
+    explicit ModLayers(QString stagingPath);
+    /// waits for the layers still being made, they write into the staging folder
+    ~ModLayers();
+
+    void clear();
+    void add(Layer layer);
+
+    /// starts making the layers of a file that is there now
+    void start(const QString& source);
+    /// starts making the layers that weren't started yet
+    void startAll();
+
+    /// waits for all the layers and puts them over the minecraft folder. blocks, so it has to run on a worker thread
+    bool apply();
+
+    /// makes the layers that didn't start yet do nothing. the ones already running are not waited for, see pending()
+    void stop();
+    /// the layers that are still being made
+    QList<QFuture<void>> pending() const;
+
+   private:
+    QString layerPath(int index) const;
+    static bool make(const Layer& layer, const QString& path, const std::atomic_bool& stopped);
+
+   private:
+    QString m_stagingPath;
+    QList<Layer> m_layers;
+    QHash<QString, QList<int>> m_bySource;
+    QHash<int, QFuture<bool>> m_futures;
+    std::shared_ptr<std::atomic_bool> m_stopped = std::make_shared<std::atomic_bool>(false);
+};
+
+}  // namespace ATLauncher
@@ -73,6 +73,17 @@ PackInstallTask::PackInstallTask(UserInteractionSupport* support, QString packNa
     m_install_mode = installMode;
 }
 
+PackInstallTask::~PackInstallTask()
+{
+    // the workers use the task, they have to be done before it goes away
+    if (m_modLayers)
+        m_modLayers->stop();
+    m_extractFuture.waitForFinished();
+    m_modExtractFuture.waitForFinished();
+    m_modLayers.reset();
+    delete m_support;
+}
+
 bool PackInstallTask::abort()
 {
     if (abortable) {
@@ -647,6 +658,7 @@ void PackInstallTask::installConfigs()
         abortable = false;
         jobPtr.reset();
         extractConfigs();
+        downloadMods();
     });
     connect(jobPtr.get(), &NetJob::failed, [this](QString reason) {
         abortable = false;
@@ -672,12 +684,10 @@ void PackInstallTask::extractConfigs()
     qDebug() << "PackInstallTask::extractConfigs:" << QThread::currentThreadId();
     setStatus(tr("Extracting configs..."));
 
+    // the mods are downloaded meanwhile, they are only put over the configs once these are extracted
     QDir extractDir(m_stagingPath);
     m_extractFuture = QtConcurrent::run(QThreadPool::globalInstance(), QOverload<QString, QString>::of(MMCZip::extractDir), archivePath,
                                         extractDir.absolutePath() + "/minecraft");
-    connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, [this]() { downloadMods(); });
-    connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, [this]() { emitAborted(); });
-    m_extractFutureWatcher.setFuture(m_extractFuture);
 }
 
 void PackInstallTask::downloadMods()
@@ -697,7 +707,7 @@ void PackInstallTask::downloadMods()
         setStatus(tr("Selecting optional mods..."));
         auto mods = m_support->chooseOptionalMods(m_version, optionalMods);
         if (!mods.has_value()) {
-            emitAborted();
+            abortAfterExtraction();
             return;
         }
         selectedMods = mods.value();
@@ -709,6 +719,7 @@ void PackInstallTask::downloadMods()
     jobPtr.reset(new NetJob(tr("Mod download"), APPLICATION->network()));
 
     QList<VersionMod> blocked_mods;
+    QStringList local_files;
     for (const auto& mod : m_version.mods) {
         // skip non-client mods
         if (!mod.client)
@@ -731,7 +742,7 @@ void PackInstallTask::downloadMods()
                 url = mod.url;
                 break;
             case DownloadType::Unknown:
-                emitFailed(tr("Unknown download type: %1").arg(mod.download_raw));
+                failAfterExtraction(tr("Unknown download type: %1").arg(mod.download_raw));
                 return;
         }
 
@@ -747,6 +758,7 @@ void PackInstallTask::downloadMods()
             if (!mod.md5.isEmpty()) {
                 dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Md5, mod.md5));
             }
+            connect(dl.get(), &Task::succeeded, this, [this, path = entry->getFullPath()] { startModLayers(path); });
             jobPtr->addNetAction(dl);
         } else if (mod.type == ModType::Decomp) {
             auto entry = APPLICATION->metacache()->resolveEntry("ATLauncherPacks", cacheName);
@@ -757,6 +769,7 @@ void PackInstallTask::downloadMods()
             if (!mod.md5.isEmpty()) {
                 dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Md5, mod.md5));
             }
+            connect(dl.get(), &Task::succeeded, this, [this, path = entry->getFullPath()] { startModLayers(path); });
             jobPtr->addNetAction(dl);
         } else {
             auto relpath = getDirForModType(mod.type, mod.type_raw);
@@ -770,6 +783,7 @@ void PackInstallTask::downloadMods()
             if (!mod.md5.isEmpty()) {
                 dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Md5, mod.md5));
             }
+            connect(dl.get(), &Task::succeeded, this, [this, path = entry->getFullPath()] { startModLayers(path); });
             jobPtr->addNetAction(dl);
 
             auto path = FS::PathCombine(m_stagingPath, "minecraft", relpath, mod.file);
@@ -830,6 +844,7 @@ void PackInstallTask::downloadMods()
                 if (modIter == blocked_mods.end())
                     continue;
                 auto mod = *modIter;
+                local_files.append(blocked.localPath);
                 if (mod.type == ModType::Extract || mod.type == ModType::TexturePackExtract || mod.type == ModType::ResourcePackExtract) {
                     modsToExtract.insert(blocked.localPath, mod);
                 } else if (mod.type == ModType::Decomp) {
@@ -861,11 +876,17 @@ void PackInstallTask::downloadMods()
                 }
             }
         } else {
-            emitFailed(tr("Unknown download type: %1").arg("browser"));
+            failAfterExtraction(tr("Unknown download type: %1").arg("browser"));
             return;
         }
     }
 
+    if (!prepareModLayers())
+        return;
+    // the files picked by the user are already there
+    for (const auto& file : local_files)
+        startModLayers(file);
+
     connect(jobPtr.get(), &NetJob::succeeded, this, &PackInstallTask::onModsDownloaded);
     connect(jobPtr.get(), &NetJob::progress, [this](qint64 current, qint64 total) {
         setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
@@ -873,53 +894,32 @@ void PackInstallTask::downloadMods()
         setProgress(current, total);
     });
     connect(jobPtr.get(), &NetJob::stepProgress, this, &PackInstallTask::propagateStepProgress);
-    connect(jobPtr.get(), &NetJob::aborted, &PackInstallTask::emitAborted);
-    connect(jobPtr.get(), &NetJob::failed, &PackInstallTask::emitFailed);
+    connect(jobPtr.get(), &NetJob::aborted, this, [this] {
+        abortable = false;
+        abortAfterExtraction();
+    });
+    connect(jobPtr.get(), &NetJob::failed, this, [this](QString reason) {
+        abortable = false;
+        failAfterExtraction(reason);
+    });
 
     jobPtr->start();
 }
 
-void PackInstallTask::onModsDownloaded()
+bool PackInstallTask::prepareModLayers()
 {
-    abortable = false;
-
-    qDebug() << "PackInstallTask::onModsDownloaded:" << QThread::currentThreadId();
-    jobPtr.reset();
+    m_modLayers = std::make_unique<ModLayers>(m_stagingPath);
+    auto addLayer = [this](ModLayers::Layer layer) { m_modLayers->add(std::move(layer)); };
 
-    if (!modsToExtract.empty() || !modsToDecomp.empty() || !modsToCopy.empty()) {
-        m_modExtractFuture =
-            QtConcurrent::run(QThreadPool::globalInstance(), &PackInstallTask::extractMods, this, modsToExtract, modsToDecomp, modsToCopy);
-        connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &PackInstallTask::onModsExtracted);
-        connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &PackInstallTask::emitAborted);
-        m_modExtractFutureWatcher.setFuture(m_modExtractFuture);
-    } else {
-        install();
-    }
-}
-
-void PackInstallTask::onModsExtracted()
-{
-    qDebug() << "PackInstallTask::onModsExtracted:" << QThread::currentThreadId();
-    if (m_modExtractFuture.result()) {
-        install();
-    } else {
-        emitFailed(tr("Failed to extract mods..."));
-    }
-}
-
-bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
-                                  const QMap<QString, VersionMod>& toDecomp,
-                                  const QMap<QString, QString>& toCopy)
-{
-    qDebug() << "PackInstallTask::extractMods:" << QThread::currentThreadId();
-
-    setStatus(tr("Extracting mods..."));
-    for (auto iter = toExtract.begin(); iter != toExtract.end(); iter++) {
-        auto& modPath = iter.key();
+    for (auto iter = modsToExtract.begin(); iter != modsToExtract.end(); iter++) {
         auto& mod = iter.value();
 
         QString extractToDir;
         if (mod.type == ModType::Extract) {
+            if (mod.extractTo == ModType::Unknown) {
+                failAfterExtraction(tr("Unknown mod type: %1").arg(mod.extractTo_raw));
+                return false;
+            }
             extractToDir = getDirForModType(mod.extractTo, mod.extractTo_raw);
         } else if (mod.type == ModType::TexturePackExtract) {
             extractToDir = FS::PathCombine("texturepacks", "extracted");
@@ -927,9 +927,6 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
             extractToDir = FS::PathCombine("resourcepacks", "extracted");
         }
 
-        QDir extractDir(m_stagingPath);
-        auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir);
-
         QString folderToExtract = "";
         if (mod.type == ModType::Extract) {
             folderToExtract = mod.extractFolder;
@@ -937,49 +934,104 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
             folderToExtract.remove(s_regex);
         }
 
-        qDebug() << "Extracting " + mod.file + " to " + extractToDir;
-        if (!MMCZip::extractDir(modPath, folderToExtract, extractToPath)) {
-            // assume error
-            return false;
-        }
+        addLayer({ ModLayers::Layer::Kind::Extract, iter.key(), folderToExtract, extractToDir });
     }
 
-    for (auto iter = toDecomp.begin(); iter != toDecomp.end(); iter++) {
-        auto& modPath = iter.key();
+    for (auto iter = modsToDecomp.begin(); iter != modsToDecomp.end(); iter++) {
         auto& mod = iter.value();
+        if (mod.decompType == ModType::Unknown) {
+            failAfterExtraction(tr("Unknown mod type: %1").arg(mod.decompType_raw));
+            return false;
+        }
         auto extractToDir = getDirForModType(mod.decompType, mod.decompType_raw);
+        addLayer({ ModLayers::Layer::Kind::Decomp, iter.key(), mod.decompFile, FS::PathCombine(extractToDir, mod.decompFile) });
+    }
 
-        QDir extractDir(m_stagingPath);
-        auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir, mod.decompFile);
+    QDir minecraftDir(FS::PathCombine(m_stagingPath, "minecraft"));
+    for (auto iter = modsToCopy.begin(); iter != modsToCopy.end(); iter++) {
+        addLayer({ ModLayers::Layer::Kind::Copy, iter.key(), {}, minecraftDir.relativeFilePath(iter.value()) });
+    }
+    return true;
+}
 
-        qDebug() << "Extracting " + mod.decompFile + " to " + extractToDir;
-        if (!MMCZip::extractFile(modPath, mod.decompFile, extractToPath)) {
-            qWarning() << "Failed to extract" << mod.decompFile;
-            return false;
-        }
+void PackInstallTask::startModLayers(const QString& source)
+{
+    if (m_modLayers && !m_extractionStopping)
+        m_modLayers->start(source);
+}
+
+void PackInstallTask::onModsDownloaded()
+{
+    abortable = false;
+
+    qDebug() << "PackInstallTask::onModsDownloaded:" << QThread::currentThreadId();
+    jobPtr.reset();
+
+    setStatus(tr("Extracting mods..."));
+    // in case a download did not tell it was done
+    m_modLayers->startAll();
+
+    m_modExtractFuture = QtConcurrent::run(QThreadPool::globalInstance(), &PackInstallTask::applyModLayers, this);
+    connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &PackInstallTask::onModsExtracted);
+    connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &PackInstallTask::emitAborted);
+    m_modExtractFutureWatcher.setFuture(m_modExtractFuture);
+}
+
+void PackInstallTask::onModsExtracted()
+{
+    qDebug() << "PackInstallTask::onModsExtracted:" << QThread::currentThreadId();
+    if (!m_version.noConfigs && !m_extractFuture.result().has_value()) {
+        failAfterExtraction(tr("Failed to extract configs..."));
+    } else if (m_modExtractFuture.result()) {
+        install();
+    } else {
+        failAfterExtraction(tr("Failed to extract mods..."));
     }
+}
 
-    for (auto iter = toCopy.begin(); iter != toCopy.end(); iter++) {
-        auto& from = iter.key();
-        auto& to = iter.value();
+bool PackInstallTask::applyModLayers()
+{
+    qDebug() << "PackInstallTask::applyModLayers:" << QThread::currentThreadId();
 
-        // If the file already exists, assume the mod is the correct copy - and remove
-        // the copy from the Configs.zip
-        QFileInfo fileInfo(to);
-        if (fileInfo.exists()) {
-            if (!FS::deletePath(to)) {
-                qWarning() << "Failed to delete" << to;
-                return false;
-            }
-        }
+    // the configs go first, then the layers
+    m_extractFuture.waitForFinished();
+    if (!m_version.noConfigs && !m_extractFuture.result().has_value()) {
+        qWarning() << "Failed to extract the configs of" << m_pack_name;
+        return false;
+    }
+    return m_modLayers->apply();
+}
 
-        FS::copy fileCopyOperation(from, to);
-        if (!fileCopyOperation()) {
-            qWarning() << "Failed to copy" << from << "to" << to;
-            return false;
-        }
+void PackInstallTask::stopExtraction(std::function<void()> then)
+{
+    // the staging folder goes away once the task is over, nothing may still be writing to it then.
+    // what is still running is left to notice it should stop, instead of waiting for it here on the GUI thread
+    m_extractionStopping = true;
+    QList<QFuture<void>> pending;
+    if (m_modLayers) {
+        m_modLayers->stop();
+        pending = m_modLayers->pending();
     }
-    return true;
+    for (auto future : { QFuture<void>(m_extractFuture), QFuture<void>(m_modExtractFuture) }) {
+        if (!future.isFinished())
+            pending.append(future);
+    }
+
+    if (pending.isEmpty()) {
+        then();
+        return;
+    }
+    QtFuture::whenAll(pending.begin(), pending.end()).then(this, [then](const QList<QFuture<void>>&) { then(); });
+}
+
+void PackInstallTask::failAfterExtraction(const QString& reason)
+{
+    stopExtraction([this, reason] { emitFailed(reason); });
+}
+
+void PackInstallTask::abortAfterExtraction()
+{
+    stopExtraction([this] { emitAborted(); });
 }
 
 void PackInstallTask::install()
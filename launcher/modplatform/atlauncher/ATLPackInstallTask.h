@@ -37,6 +37,7 @@
 #pragma once
 
 #include <meta/VersionList.h>
+#include "ATLModLayers.h"
 #include "ATLPackManifest.h"
 
 #include "InstanceTask.h"
@@ -46,6 +47,7 @@
 #include "net/NetJob.h"
 #include "settings/INISettingsObject.h"
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -86,7 +88,7 @@ class PackInstallTask : public InstanceTask {
                              QString packName,
                              QString version,
                              InstallMode installMode = InstallMode::Install);
-    virtual ~PackInstallTask() { delete m_support; }
+    virtual ~PackInstallTask();
 
     bool canAbort() const override { return true; }
     bool abort() override;
@@ -114,9 +116,13 @@ class PackInstallTask : public InstanceTask {
     void installConfigs();
     void extractConfigs();
     void downloadMods();
-    bool extractMods(const QMap<QString, VersionMod>& toExtract,
-                     const QMap<QString, VersionMod>& toDecomp,
-                     const QMap<QString, QString>& toCopy);
+    bool prepareModLayers();
+    void startModLayers(const QString& source);
+    bool applyModLayers();
+    /// stops extracting, then calls `then` once nothing writes into the staging folder anymore
+    void stopExtraction(std::function<void()> then);
+    void failAfterExtraction(const QString& reason);
+    void abortAfterExtraction();
     void install();
 
    private:
@@ -143,7 +149,9 @@ class PackInstallTask : public InstanceTask {
     QMap<QString, Meta::Version::Ptr> componentsToInstall;
 
     QFuture<std::optional<QStringList>> m_extractFuture;
-    QFutureWatcher<std::optional<QStringList>> m_extractFutureWatcher;
+
+    std::unique_ptr<ModLayers> m_modLayers;
+    bool m_extractionStopping = false;
 
     QFuture<bool> m_modExtractFuture;
     QFutureWatcher<bool> m_modExtractFutureWatcher;
@@ -42,10 +42,7 @@ QString FlameAPI::getModFileChangelog(int modId, int fileId)
 
     auto netJob = makeShared<NetJob>(QString("Flame::FileChangelog"), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(
-        QString(BuildConfig.FLAME_BASE_URL + "/mods/%1/files/%2/changelog")
-            .arg(QString::fromStdString(std::to_string(modId)), QString::fromStdString(std::to_string(fileId))),
-        response.get()));
+    netJob->addNetAction(getFileChangelog(QString::number(modId), QString::number(fileId), response.get()));
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [&netJob, response, &changelog] {
         QJsonParseError parse_error{};
@@ -77,7 +74,7 @@ QString FlameAPI::getModDescription(int modId)
 
     auto netJob = makeShared<NetJob>(QString("Flame::ModDescription"), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(
+    netJob->addNetAction(makeCachedRequest(
         QString(BuildConfig.FLAME_BASE_URL + "/mods/%1/description").arg(QString::number(modId)), response.get()));
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [&netJob, response, &description] {
@@ -150,14 +147,18 @@ Task::Ptr FlameAPI::getFiles(const QStringList& fileIds, QByteArray* response) c
 Task::Ptr FlameAPI::getFile(const QString& addonId, const QString& fileId, QByteArray* response) const
 {
     auto netJob = makeShared<NetJob>(QString("Flame::GetFile"), APPLICATION->network());
-    netJob->addNetAction(
-        Net::ApiDownload::makeByteArray(QUrl(QString(BuildConfig.FLAME_BASE_URL + "/mods/%1/files/%2").arg(addonId, fileId)), response));
+    netJob->addNetAction(makeCachedRequest(QUrl(QString(BuildConfig.FLAME_BASE_URL + "/mods/%1/files/%2").arg(addonId, fileId)), response));
 
     QObject::connect(netJob.get(), &NetJob::failed, [addonId, fileId] { qDebug() << "Flame API file failure" << addonId << fileId; });
 
     return netJob;
 }
 
+Net::Download::Ptr FlameAPI::getFileChangelog(const QString& addonId, const QString& fileId, QByteArray* response) const
+{
+    return makeCachedRequest(QUrl(QString(BuildConfig.FLAME_BASE_URL + "/mods/%1/files/%2/changelog").arg(addonId, fileId)), response);
+}
+
 QList<ResourceAPI::SortingMethod> FlameAPI::getSortingMethods() const
 {
     // https://docs.curseforge.com/?python#tocS_ModsSearchSortField
@@ -27,6 +27,8 @@ class FlameAPI : public ResourceAPI {
     Task::Ptr matchFingerprints(const QList<uint>& fingerprints, QByteArray* response);
     Task::Ptr getFiles(const QStringList& fileIds, QByteArray* response) const;
     Task::Ptr getFile(const QString& addonId, const QString& fileId, QByteArray* response) const;
+    /** The request for the changelog of a file, to be added to a NetJob. Answered from the API response cache when it can be. */
+    Net::Download::Ptr getFileChangelog(const QString& addonId, const QString& fileId, QByteArray* response) const;
 
     static Task::Ptr getCategories(QByteArray* response, ModPlatform::ResourceType type);
     static Task::Ptr getModCategories(QByteArray* response);
@@ -39,6 +41,9 @@ class FlameAPI : public ResourceAPI {
         return loaders & (ModPlatform::NeoForge | ModPlatform::Forge | ModPlatform::Fabric | ModPlatform::Quilt);
     }
 
+   protected:
+    ModPlatform::ResourceProvider provider() const override { return ModPlatform::ResourceProvider::FLAME; }
+
    private:
     static int getClassId(ModPlatform::ResourceType type)
     {
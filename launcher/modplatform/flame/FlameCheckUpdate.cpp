@@ -4,6 +4,7 @@
 #include "FlameModIndex.h"
 
 #include <QHash>
+#include <algorithm>
 #include <memory>
 
 #include "Json.h"
@@ -31,7 +32,9 @@ bool FlameCheckUpdate::abort()
 }
 
 /* Check for update:
- * - Get latest version available
+ * - Get the newest files of all the projects in one request, from their latestFilesIndexes
+ * - Get the details of those files in a second request
+ * - Pick the latest version of each resource from them
  * - Compare hash of the latest version with the current hash
  * - If equal, no updates, else, there's updates, so add to the list
  * */
@@ -39,59 +42,147 @@ void FlameCheckUpdate::executeTask()
 {
     setStatus(tr("Preparing resources for CurseForge..."));
 
-    auto netJob = new NetJob("Get latest versions", APPLICATION->network());
-    connect(netJob, &Task::finished, this, &FlameCheckUpdate::collectBlockedMods);
-
-    connect(netJob, &Task::progress, this, &FlameCheckUpdate::setProgress);
-    connect(netJob, &Task::stepProgress, this, &FlameCheckUpdate::propagateStepProgress);
-    connect(netJob, &Task::details, this, &FlameCheckUpdate::setDetails);
     for (auto* resource : m_resources) {
-        auto project = std::make_shared<ModPlatform::IndexedPack>();
-        project->addonId = resource->metadata()->project_id.toString();
-        auto versionsUrlOptional = api.getVersionsURL({ project, m_gameVersions });
-        if (!versionsUrlOptional.has_value())
-            continue;
+        m_resourcesByProject[resource->metadata()->project_id.toString()].append(resource);
+    }
+    if (m_resourcesByProject.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
 
-        auto response = std::make_shared<QByteArray>();
-        auto task = Net::ApiDownload::makeByteArray(versionsUrlOptional.value(), response.get());
+    auto response = std::make_shared<QByteArray>();
+    auto task = api.getProjects(m_resourcesByProject.keys(), response.get());
+    connect(task.get(), &Task::succeeded, this, [this, response] { getProjectsCallback(response.get()); });
+    connect(task.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(task.get(), &Task::progress, this, &FlameCheckUpdate::setProgress);
+    connect(task.get(), &Task::stepProgress, this, &FlameCheckUpdate::propagateStepProgress);
+    connect(task.get(), &Task::details, this, &FlameCheckUpdate::setDetails);
+    m_task.reset(task);
+    m_task->start();
+}
 
-        connect(task.get(), &Task::succeeded, this, [this, resource, response] { getLatestVersionCallback(resource, response.get()); });
-        netJob->addNetAction(task);
+QHash<QString, QStringList> FlameCheckUpdate::latestFileIds(const QJsonArray& projects, const QString& gameVersion)
+{
+    QHash<QString, QStringList> fileIds;
+    for (auto project : projects) {
+        auto obj = project.toObject();
+        auto& ids = fileIds[QString::number(obj["id"].toInteger())];
+        for (auto index : obj["latestFilesIndexes"].toArray()) {
+            auto indexObj = index.toObject();
+            if (!gameVersion.isEmpty() && indexObj["gameVersion"].toString() != gameVersion)
+                continue;
+            auto fileId = QString::number(indexObj["fileId"].toInteger());
+            if (!ids.contains(fileId))
+                ids.append(fileId);
+        }
     }
-    m_task.reset(netJob);
-    m_task->start();
+    return fileIds;
+}
+
+QHash<QString, QList<ModPlatform::IndexedVersion>> FlameCheckUpdate::loadFiles(const QJsonArray& files)
+{
+    QHash<QString, QList<ModPlatform::IndexedVersion>> versions;
+    for (auto file : files) {
+        auto obj = file.toObject();
+        try {
+            auto version = FlameMod::loadIndexedPackVersion(obj);
+            versions[version.addonId.toString()].append(version);
+        } catch (Json::JsonException& e) {
+            qWarning() << "Failed to parse a file from CurseForge:" << e.cause();
+        }
+    }
+    for (auto& projectVersions : versions) {
+        // dates are in RFC 3339 format
+        std::sort(projectVersions.begin(), projectVersions.end(), [](auto& a, auto& b) { return a.date > b.date; });
+    }
+    return versions;
 }
 
-void FlameCheckUpdate::getLatestVersionCallback(Resource* resource, QByteArray* response)
+void FlameCheckUpdate::getProjectsCallback(QByteArray* response)
 {
+    setStatus(tr("Parsing the API response from CurseForge..."));
+
     QJsonParseError parse_error{};
-    QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+    auto doc = QJsonDocument::fromJson(*response, &parse_error);
     if (parse_error.error != QJsonParseError::NoError) {
-        qWarning() << "Error while parsing JSON response from latest mod version at" << parse_error.offset
+        qWarning() << "Error while parsing JSON response from Flame projects task at" << parse_error.offset
                    << "reason:" << parse_error.errorString();
         qWarning() << *response;
+        emitFailed(parse_error.errorString());
         return;
     }
 
-    // Fake pack with the necessary info to pass to the download task :)
-    auto pack = std::make_shared<ModPlatform::IndexedPack>();
-    pack->name = resource->name();
-    pack->slug = resource->metadata()->slug;
-    pack->addonId = resource->metadata()->project_id;
-    pack->provider = ModPlatform::ResourceProvider::FLAME;
-    try {
-        auto obj = Json::requireObject(doc);
-        auto arr = Json::requireArray(obj, "data");
+    auto projects = doc.object()["data"].toArray();
+    for (auto project : projects) {
+        auto obj = project.toObject();
+        ModPlatform::IndexedPack pack;
+        try {
+            FlameMod::loadIndexedPack(pack, obj);
+            m_projects.insert(pack.addonId.toString(), pack);
+        } catch (Json::JsonException& e) {
+            qWarning() << "Failed to parse a project from CurseForge:" << e.cause();
+        }
+    }
 
-        FlameMod::loadIndexedPackVersions(*pack.get(), arr);
-    } catch (Json::JsonException& e) {
-        qCritical() << "Failed to parse response from a version request.";
-        qCritical() << e.what();
-        qDebug() << doc;
+    // the old per-project requests only asked for the files of the first game version
+    auto gameVersion = m_gameVersions.empty() ? QString() : m_gameVersions.front().toString();
+    QStringList fileIds;
+    for (auto& ids : latestFileIds(projects, gameVersion)) {
+        fileIds << ids;
+    }
+    if (fileIds.isEmpty()) {
+        getFilesCallback(nullptr);
+        return;
     }
-    auto latest_ver = api.getLatestVersion(pack->versions, m_loadersList, resource->metadata()->loaders, !m_loadersList.isEmpty());
 
-    setStatus(tr("Parsing the API response from CurseForge for '%1'...").arg(resource->name()));
+    auto filesResponse = std::make_shared<QByteArray>();
+    auto task = api.getFiles(fileIds, filesResponse.get());
+    connect(task.get(), &Task::succeeded, this, [this, filesResponse] { getFilesCallback(filesResponse.get()); });
+    connect(task.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(task.get(), &Task::progress, this, &FlameCheckUpdate::setProgress);
+    connect(task.get(), &Task::stepProgress, this, &FlameCheckUpdate::propagateStepProgress);
+    connect(task.get(), &Task::details, this, &FlameCheckUpdate::setDetails);
+    m_task.reset(task);
+    m_task->start();
+}
+
+void FlameCheckUpdate::getFilesCallback(QByteArray* response)
+{
+    QHash<QString, QList<ModPlatform::IndexedVersion>> versions;
+    if (response) {
+        QJsonParseError parse_error{};
+        auto doc = QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            qWarning() << "Error while parsing JSON response from Flame files task at" << parse_error.offset
+                       << "reason:" << parse_error.errorString();
+            qWarning() << *response;
+            emitFailed(parse_error.errorString());
+            return;
+        }
+        versions = loadFiles(doc.object()["data"].toArray());
+    }
+
+    for (auto it = m_resourcesByProject.constBegin(); it != m_resourcesByProject.constEnd(); ++it) {
+        for (auto* resource : it.value()) {
+            // Fake pack with the necessary info to pass to the download task :)
+            auto pack = std::make_shared<ModPlatform::IndexedPack>();
+            pack->name = resource->name();
+            pack->slug = resource->metadata()->slug;
+            pack->addonId = resource->metadata()->project_id;
+            pack->provider = ModPlatform::ResourceProvider::FLAME;
+            pack->websiteUrl = m_projects.value(it.key()).websiteUrl;
+            pack->versions = versions.value(it.key());
+            pack->versionsLoaded = true;
+            checkResource(resource, pack);
+        }
+    }
+
+    getChangelogs();
+}
+
+void FlameCheckUpdate::checkResource(Resource* resource, ModPlatform::IndexedPack::Ptr pack)
+{
+    auto latest_ver = api.getLatestVersion(pack->versions, m_loadersList, resource->metadata()->loaders, !m_loadersList.isEmpty());
 
     if (!latest_ver.has_value() || !latest_ver->addonId.isValid()) {
         QString reason;
@@ -107,7 +198,8 @@ void FlameCheckUpdate::getLatestVersionCallback(Resource* resource, QByteArray*
     }
 
     if (latest_ver->downloadUrl.isEmpty() && latest_ver->fileId != resource->metadata()->file_id) {
-        m_blocked[resource] = latest_ver->fileId.toString();
+        auto recover_url = QString("%1/download/%2").arg(pack->websiteUrl, latest_ver->fileId.toString());
+        emit checkFailed(resource, tr("Resource has a new update available, but is not downloadable using CurseForge."), recover_url);
         return;
     }
 
@@ -122,82 +214,40 @@ void FlameCheckUpdate::getLatestVersionCallback(Resource* resource, QByteArray*
         }
 
         auto download_task = makeShared<ResourceDownloadTask>(pack, latest_ver.value(), m_resourceModel);
-        m_updates.emplace_back(pack->name, resource->metadata()->hash, old_version, latest_ver->version, latest_ver->version_type,
-                               api.getModFileChangelog(latest_ver->addonId.toInt(), latest_ver->fileId.toInt()),
+        m_changelogs.insert(m_updates.size(), latest_ver.value());
+        m_updates.emplace_back(pack->name, resource->metadata()->hash, old_version, latest_ver->version, latest_ver->version_type, QString(),
                                ModPlatform::ResourceProvider::FLAME, download_task, resource->enabled());
     }
     m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, latest_ver.value()));
 }
 
-void FlameCheckUpdate::collectBlockedMods()
+void FlameCheckUpdate::getChangelogs()
 {
-    QStringList addonIds;
-    QHash<QString, Resource*> quickSearch;
-    for (auto const& resource : m_blocked.keys()) {
-        auto addonId = resource->metadata()->project_id.toString();
-        addonIds.append(addonId);
-        quickSearch[addonId] = resource;
-    }
-
-    auto response = std::make_shared<QByteArray>();
-    Task::Ptr projTask;
-
-    if (addonIds.isEmpty()) {
+    if (m_changelogs.isEmpty()) {
         emitSucceeded();
         return;
-    } else if (addonIds.size() == 1) {
-        projTask = api.getProject(*addonIds.begin(), response.get());
-    } else {
-        projTask = api.getProjects(addonIds, response.get());
     }
 
-    connect(projTask.get(), &Task::succeeded, this, [this, response, addonIds, quickSearch] {
-        QJsonParseError parse_error{};
-        auto doc = QJsonDocument::fromJson(*response, &parse_error);
-        if (parse_error.error != QJsonParseError::NoError) {
-            qWarning() << "Error while parsing JSON response from Flame projects task at" << parse_error.offset
-                       << "reason:" << parse_error.errorString();
-            qWarning() << *response;
-            return;
-        }
-
-        try {
-            QJsonArray entries;
-            if (addonIds.size() == 1)
-                entries = { Json::requireObject(Json::requireObject(doc), "data") };
-            else
-                entries = Json::requireArray(Json::requireObject(doc), "data");
-
-            for (auto entry : entries) {
-                auto entry_obj = Json::requireObject(entry);
-
-                auto id = QString::number(Json::requireInteger(entry_obj, "id"));
-
-                auto resource = quickSearch.find(id).value();
-
-                ModPlatform::IndexedPack pack;
-                try {
-                    setStatus(tr("Parsing API response from CurseForge for '%1'...").arg(resource->name()));
+    setStatus(tr("Getting the changelogs from CurseForge..."));
+    auto netJob = makeShared<NetJob>("Get changelogs", APPLICATION->network());
+    for (auto it = m_changelogs.constBegin(); it != m_changelogs.constEnd(); ++it) {
+        auto response = std::make_shared<QByteArray>();
+        auto task = api.getFileChangelog(it->addonId.toString(), it->fileId.toString(), response.get());
+        connect(task.get(), &Task::succeeded, this, [this, index = it.key(), response] {
+            auto doc = QJsonDocument::fromJson(*response);
+            m_updates[index].changelog = doc.object()["data"].toString();
+        });
+        netJob->addNetAction(task);
+    }
 
-                    FlameMod::loadIndexedPack(pack, entry_obj);
-                    auto recover_url = QString("%1/download/%2").arg(pack.websiteUrl, m_blocked[resource]);
-                    emit checkFailed(resource, tr("Resource has a new update available, but is not downloadable using CurseForge."),
-                                     recover_url);
-                } catch (Json::JsonException& e) {
-                    qDebug() << e.cause();
-                    qDebug() << entries;
-                }
-            }
-        } catch (Json::JsonException& e) {
-            qDebug() << e.cause();
-            qDebug() << doc;
-        }
+    // a missing changelog is no reason to fail the update check
+    connect(netJob.get(), &Task::finished, this, [this] {
+        if (isRunning())
+            emitSucceeded();
     });
-
-    connect(projTask.get(), &Task::finished, this, &FlameCheckUpdate::emitSucceeded);  // do not care much about error
-    connect(projTask.get(), &Task::progress, this, &FlameCheckUpdate::setProgress);
-    connect(projTask.get(), &Task::stepProgress, this, &FlameCheckUpdate::propagateStepProgress);
-    connect(projTask.get(), &Task::details, this, &FlameCheckUpdate::setDetails);
-    m_task.reset(projTask);
+    connect(netJob.get(), &Task::progress, this, &FlameCheckUpdate::setProgress);
+    connect(netJob.get(), &Task::stepProgress, this, &FlameCheckUpdate::propagateStepProgress);
+    connect(netJob.get(), &Task::details, this, &FlameCheckUpdate::setDetails);
+    m_task.reset(netJob);
     m_task->start();
 }
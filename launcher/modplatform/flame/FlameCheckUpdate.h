@@ -1,5 +1,8 @@
 #pragma once
 
+#include <QHash>
+#include <QJsonArray>
+
 #include "modplatform/CheckUpdateTask.h"
 
 class FlameCheckUpdate : public CheckUpdateTask {
@@ -13,17 +16,35 @@ class FlameCheckUpdate : public CheckUpdateTask {
         : CheckUpdateTask(resources, mcVersions, std::move(loadersList), resourceModel)
     {}
 
+    /**
+     * The ids of the newest files of each project in a /mods response, by project id.
+     *
+     * Those are taken from the projects' latestFilesIndexes, which lists the newest file of every release type and mod loader
+     * for each game version. Only the entries for 'gameVersion' are used, unless it is empty.
+     */
+    static QHash<QString, QStringList> latestFileIds(const QJsonArray& projects, const QString& gameVersion);
+
+    /** Parses a /mods/files response into the versions of each project, newest first. */
+    static QHash<QString, QList<ModPlatform::IndexedVersion>> loadFiles(const QJsonArray& files);
+
    public slots:
     bool abort() override;
 
    protected slots:
     void executeTask() override;
    private slots:
-    void getLatestVersionCallback(Resource* resource, QByteArray* response);
-    void collectBlockedMods();
+    void getProjectsCallback(QByteArray* response);
+    void getFilesCallback(QByteArray* response);
+    void getChangelogs();
+
+   private:
+    void checkResource(Resource* resource, ModPlatform::IndexedPack::Ptr pack);
 
    private:
     Task::Ptr m_task = nullptr;
 
-    QHash<Resource*, QString> m_blocked;
+    QHash<QString, QList<Resource*>> m_resourcesByProject;
+    QHash<QString, ModPlatform::IndexedPack> m_projects;
+    // updates whose changelog still has to be fetched, by their index in m_updates
+    QHash<qsizetype, ModPlatform::IndexedVersion> m_changelogs;
 };
@@ -50,6 +50,7 @@
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
 
+#include "modplatform/ModpackUpdatePrefetcher.h"
 #include "modplatform/helpers/OverrideUtils.h"
 
 #include "settings/INISettingsObject.h"
@@ -337,23 +338,6 @@ bool FlameCreationTask::createInstance()
         return false;
     }
 
-    if (!m_pack.overrides.isEmpty()) {
-        QString overridePath = FS::PathCombine(m_stagingPath, m_pack.overrides);
-        if (QFile::exists(overridePath)) {
-            // Create a list of overrides in "overrides.txt" inside flame/
-            Override::createOverrides("overrides", parent_folder, overridePath);
-
-            QString mcPath = FS::PathCombine(m_stagingPath, "minecraft");
-            if (!FS::move(overridePath, mcPath)) {
-                setError(tr("Could not rename the overrides folder:\n") + m_pack.overrides);
-                return false;
-            }
-        } else {
-            logWarning(
-                tr("The specified overrides folder (%1) is missing. Maybe the modpack was already used before?").arg(m_pack.overrides));
-        }
-    }
-
     QString loaderType;
     QString loaderUid;
     QString loaderVersion;
@@ -437,23 +421,6 @@ bool FlameCreationTask::createInstance()
         instance.settings()->set("MaxMemAlloc", recommendedRAM);
     }
 
-    QString jarmodsPath = FS::PathCombine(m_stagingPath, "minecraft", "jarmods");
-    QFileInfo jarmodsInfo(jarmodsPath);
-    if (jarmodsInfo.isDir()) {
-        // install all the jar mods
-        qDebug() << "Found jarmods:";
-        QDir jarmodsDir(jarmodsPath);
-        QStringList jarMods;
-        for (const auto& info : jarmodsDir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files)) {
-            qDebug() << info.fileName();
-            jarMods.push_back(info.absoluteFilePath());
-        }
-        auto profile = instance.getPackProfile();
-        profile->installJarMods(jarMods);
-        // nuke the original files
-        FS::deletePath(jarmodsPath);
-    }
-
     // Don't add managed info to packs without an ID (most likely imported from ZIP)
     if (!m_managedId.isEmpty())
         instance.setManagedPack("flame", m_managedId, m_pack.name, m_managedVersionId, m_pack.version);
@@ -478,8 +445,17 @@ bool FlameCreationTask::createInstance()
 
     loop.exec();
 
+    // aborted while the mods were resolved or downloaded
+    if (m_abort || !isRunning())
+        return false;
+
     bool did_succeed = getError().isEmpty();
 
+    // The overrides may still be extracting while the files download. Downloaded files replaced the overrides before,
+    // so the overrides are merged in without replacing what is already there.
+    if (did_succeed)
+        did_succeed = waitForExtraction() && applyOverrides(instance, parent_folder);
+
     // Update information of the already installed instance, if any.
     if (m_instance && did_succeed) {
         setAbortable(false);
@@ -491,6 +467,44 @@ bool FlameCreationTask::createInstance()
     return did_succeed;
 }
 
+bool FlameCreationTask::applyOverrides(MinecraftInstance& instance, const QString& parent_folder)
+{
+    if (!m_pack.overrides.isEmpty()) {
+        QString overridePath = FS::PathCombine(m_stagingPath, m_pack.overrides);
+        if (QFile::exists(overridePath)) {
+            // Create a list of overrides in "overrides.txt" inside flame/
+            Override::createOverrides("overrides", parent_folder, overridePath);
+
+            QString mcPath = FS::PathCombine(m_stagingPath, "minecraft");
+            if (!FS::mergeFolder(mcPath, overridePath)) {
+                setError(tr("Could not rename the overrides folder:\n") + m_pack.overrides);
+                return false;
+            }
+        } else {
+            logWarning(
+                tr("The specified overrides folder (%1) is missing. Maybe the modpack was already used before?").arg(m_pack.overrides));
+        }
+    }
+
+    QString jarmodsPath = FS::PathCombine(m_stagingPath, "minecraft", "jarmods");
+    QFileInfo jarmodsInfo(jarmodsPath);
+    if (jarmodsInfo.isDir()) {
+        // install all the jar mods
+        qDebug() << "Found jarmods:";
+        QDir jarmodsDir(jarmodsPath);
+        QStringList jarMods;
+        for (const auto& info : jarmodsDir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files)) {
+            qDebug() << info.fileName();
+            jarMods.push_back(info.absoluteFilePath());
+        }
+        auto profile = instance.getPackProfile();
+        profile->installJarMods(jarMods);
+        // nuke the original files
+        FS::deletePath(jarmodsPath);
+    }
+    return true;
+}
+
 void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
 {
     auto results = m_modIdResolver->getResults().files;
@@ -581,6 +595,10 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
         relpath = FS::PathCombine("minecraft", relpath);
         auto path = FS::PathCombine(m_stagingPath, relpath);
 
+        if (ModpackUpdatePrefetcher::takePrefetched(ModpackUpdatePrefetcher::flameKey(result.fileId), path)) {
+            qDebug() << "Using the prefetched" << relpath;
+            continue;
+        }
         if (!result.version.downloadUrl.isEmpty()) {
             qDebug() << "Will download" << result.version.downloadUrl << "to" << path;
             auto dl = Net::ApiDownload::makeFile(result.version.downloadUrl, path);
@@ -77,6 +77,9 @@ class FlameCreationTask final : public InstanceCreationTask {
     void validateOtherResources(QEventLoop& loop);
     QString getVersionForLoader(QString uid, QString loaderType, QString version, QString mcVersion);
 
+   private:
+    bool applyOverrides(MinecraftInstance& instance, const QString& parent_folder);
+
    private:
     QWidget* m_parent = nullptr;
 
@@ -55,11 +55,24 @@ void FlamePackExportTask::executeTask()
 
 bool FlamePackExportTask::abort()
 {
-    if (task) {
+    if (!zipTask)
+        return false;
+    if (task)
         task->abort();
-        return true;
-    }
-    return false;
+    // the zip task removes what it has written, and reports when it stopped
+    return zipTask->abort();
+}
+
+void FlamePackExportTask::fail(const QString& reason)
+{
+    if (!isRunning())
+        return;
+    emitFailed(reason);
+
+    if (task)
+        task->abort();
+    if (zipTask)
+        zipTask->abort();
 }
 
 void FlamePackExportTask::collectFiles()
@@ -82,10 +95,14 @@ void FlamePackExportTask::collectFiles()
 
 void FlamePackExportTask::collectHashes()
 {
+    disconnect(m_options.instance->loaderModList(), &ModFolderModel::updateFinished, this, &FlamePackExportTask::collectHashes);
     setAbortable(true);
     setStatus(tr("Finding file hashes..."));
     setProgress(1, 5);
-    auto allMods = m_options.instance->loaderModList()->allMods();
+    QHash<QString, Mod*> modsByPath;
+    for (auto mod : m_options.instance->loaderModList()->allMods())
+        modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    QStringList candidates;
     ConcurrentTask::Ptr hashingTask(new ConcurrentTask("MakeHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
     task.reset(hashingTask);
     for (const QFileInfo& file : files) {
@@ -104,17 +121,17 @@ void FlamePackExportTask::collectHashes()
                     pendingHashes.insert(hash, { relative, file.absoluteFilePath(), relative.endsWith(".zip") });
                 }
             });
-            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
+            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::fail);
             hashingTask->addTask(hashTask);
+            candidates << relative;
             continue;
         }
 
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (!mod || mod->type() == ResourceType::FOLDER) {
+        if (const Mod* mod = modsByPath.value(file.absoluteFilePath())) {
+            if (mod->type() == ResourceType::FOLDER) {
                 continue;
             }
+            candidates << relative;
             if (mod->metadata() && mod->metadata()->provider == ModPlatform::ResourceProvider::FLAME) {
                 resolvedFiles.insert(mod->fileinfo().absoluteFilePath(),
                                      { mod->metadata()->project_id.toInt(), mod->metadata()->file_id.toInt(), mod->enabled(), true,
@@ -128,10 +145,14 @@ void FlamePackExportTask::collectHashes()
                     pendingHashes.insert(hash, { mod->name(), mod->fileinfo().absoluteFilePath(), mod->enabled(), true });
                 }
             });
-            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
+            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::fail);
             hashingTask->addTask(hashTask);
         }
     }
+
+    // everything but the candidates goes to the overrides, which can be written while those are looked up
+    startZip(candidates);
+
     auto progressStep = std::make_shared<TaskStepProgress>();
     connect(hashingTask.get(), &Task::finished, this, [this, progressStep] {
         progressStep->state = TaskStepState::Succeeded;
@@ -142,7 +163,7 @@ void FlamePackExportTask::collectHashes()
     connect(hashingTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
         stepProgress(*progressStep);
-        emitFailed(reason);
+        fail(reason);
     });
     connect(hashingTask.get(), &Task::stepProgress, this, &FlamePackExportTask::propagateStepProgress);
 
@@ -154,14 +175,14 @@ void FlamePackExportTask::collectHashes()
         progressStep->status = status;
         stepProgress(*progressStep);
     });
-    connect(hashingTask.get(), &Task::aborted, this, &FlamePackExportTask::emitAborted);
+    connect(hashingTask.get(), &Task::aborted, this, [this] { zipTask->abort(); });
     hashingTask->start();
 }
 
 void FlamePackExportTask::makeApiRequest()
 {
     if (pendingHashes.isEmpty()) {
-        buildZip();
+        completeZip();
         return;
     }
 
@@ -184,7 +205,7 @@ void FlamePackExportTask::makeApiRequest()
                        << "reason:" << parseError.errorString();
             qWarning() << *response;
 
-            emitFailed(parseError.errorString());
+            fail(parseError.errorString());
             return;
         }
 
@@ -230,7 +251,7 @@ void FlamePackExportTask::makeApiRequest()
         getProjectsInfo();
     });
     connect(task.get(), &Task::failed, this, &FlamePackExportTask::getProjectsInfo);
-    connect(task.get(), &Task::aborted, this, &FlamePackExportTask::emitAborted);
+    connect(task.get(), &Task::aborted, this, [this] { zipTask->abort(); });
     task->start();
 }
 
@@ -249,7 +270,7 @@ void FlamePackExportTask::getProjectsInfo()
     Task::Ptr projTask;
 
     if (addonIds.isEmpty()) {
-        buildZip();
+        completeZip();
         return;
     } else if (addonIds.size() == 1) {
         projTask = api.getProject(*addonIds.begin(), response.get());
@@ -264,7 +285,7 @@ void FlamePackExportTask::getProjectsInfo()
             qWarning() << "Error while parsing JSON response from CurseForge projects task at" << parseError.offset
                        << "reason:" << parseError.errorString();
             qWarning() << *response;
-            emitFailed(parseError.errorString());
+            fail(parseError.errorString());
             return;
         }
 
@@ -306,27 +327,18 @@ void FlamePackExportTask::getProjectsInfo()
             qDebug() << e.cause();
             qDebug() << doc;
         }
-        buildZip();
+        completeZip();
     });
-    connect(projTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
-    connect(projTask.get(), &Task::aborted, this, &FlamePackExportTask::emitAborted);
+    connect(projTask.get(), &Task::failed, this, &FlamePackExportTask::fail);
+    connect(projTask.get(), &Task::aborted, this, [this] { zipTask->abort(); });
     task.reset(projTask);
     task->start();
 }
 
-void FlamePackExportTask::buildZip()
+void FlamePackExportTask::startZip(const QStringList& candidates)
 {
-    setStatus(tr("Adding files..."));
-    setProgress(4, 5);
-
-    auto zipTask = makeShared<MMCZip::ExportToZipTask>(m_options.output, m_gameRoot, files, "overrides/", true);
-    zipTask->addExtraFile("manifest.json", generateIndex());
-    zipTask->addExtraFile("modlist.html", generateHTML());
-
-    QStringList exclude;
-    std::transform(resolvedFiles.keyBegin(), resolvedFiles.keyEnd(), std::back_insert_iterator(exclude),
-                   [this](QString file) { return m_gameRoot.relativeFilePath(file); });
-    zipTask->setExcludeFiles(exclude);
+    zipTask = makeShared<MMCZip::ExportToZipTask>(m_options.output, m_gameRoot, files, "overrides/", true);
+    zipTask->setDeferredFiles(candidates);
 
     auto progressStep = std::make_shared<TaskStepProgress>();
     connect(zipTask.get(), &Task::finished, this, [this, progressStep] {
@@ -335,11 +347,14 @@ void FlamePackExportTask::buildZip()
     });
 
     connect(zipTask.get(), &Task::succeeded, this, &FlamePackExportTask::emitSucceeded);
-    connect(zipTask.get(), &Task::aborted, this, &FlamePackExportTask::emitAborted);
+    connect(zipTask.get(), &Task::aborted, this, [this] {
+        if (isRunning())
+            emitAborted();
+    });
     connect(zipTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
         stepProgress(*progressStep);
-        emitFailed(reason);
+        fail(reason);
     });
     connect(zipTask.get(), &Task::stepProgress, this, &FlamePackExportTask::propagateStepProgress);
 
@@ -351,10 +366,20 @@ void FlamePackExportTask::buildZip()
         progressStep->status = status;
         stepProgress(*progressStep);
     });
-    task.reset(zipTask);
     zipTask->start();
 }
 
+void FlamePackExportTask::completeZip()
+{
+    setStatus(tr("Adding files..."));
+    setProgress(4, 5);
+
+    QStringList exclude;
+    std::transform(resolvedFiles.keyBegin(), resolvedFiles.keyEnd(), std::back_insert_iterator(exclude),
+                   [this](QString file) { return m_gameRoot.relativeFilePath(file); });
+    zipTask->complete(exclude, { { "manifest.json", generateIndex() }, { "modlist.html", generateHTML() } });
+}
+
 QByteArray FlamePackExportTask::generateIndex()
 {
     QJsonObject obj;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "MMCZip.h"
+#include "archive/ExportToZipTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "tasks/Task.h"
@@ -76,12 +77,15 @@ class FlamePackExportTask : public Task {
     QMap<QString, HashInfo> pendingHashes{};
     QMap<QString, ResolvedFile> resolvedFiles{};
     Task::Ptr task;
+    shared_qobject_ptr<MMCZip::ExportToZipTask> zipTask;
 
     void collectFiles();
     void collectHashes();
     void makeApiRequest();
     void getProjectsInfo();
-    void buildZip();
+    void startZip(const QStringList& candidates);
+    void completeZip();
+    void fail(const QString& reason);
 
     QByteArray generateIndex();
     QByteArray generateHTML();
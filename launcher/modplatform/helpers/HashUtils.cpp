@@ -5,6 +5,9 @@
 #include <QFile>
 #include <QtConcurrentRun>
 
+#include <memory>
+#include <optional>
+
 #include <MurmurHash2.h>
 
 namespace Hashing {
@@ -80,44 +83,46 @@ Algorithm algorithmFromString(QString type)
     return Algorithm::Unknown;
 }
 
-QString hash(QIODevice* device, Algorithm type)
+static std::optional<QCryptographicHash::Algorithm> cryptographicAlgorithm(Algorithm type)
 {
-    if (!device->isOpen() && !device->open(QFile::ReadOnly))
-        return "";
-    QCryptographicHash::Algorithm alg = QCryptographicHash::Sha1;
     switch (type) {
         case Algorithm::Md4:
-            alg = QCryptographicHash::Algorithm::Md4;
-            break;
+            return QCryptographicHash::Algorithm::Md4;
         case Algorithm::Md5:
-            alg = QCryptographicHash::Algorithm::Md5;
-            break;
+            return QCryptographicHash::Algorithm::Md5;
         case Algorithm::Sha1:
-            alg = QCryptographicHash::Algorithm::Sha1;
-            break;
+            return QCryptographicHash::Algorithm::Sha1;
         case Algorithm::Sha256:
-            alg = QCryptographicHash::Algorithm::Sha256;
-            break;
+            return QCryptographicHash::Algorithm::Sha256;
         case Algorithm::Sha512:
-            alg = QCryptographicHash::Algorithm::Sha512;
-            break;
-        case Algorithm::Murmur2: {  // CF-specific
-            auto should_filter_out = [](char c) { return (c == 9 || c == 10 || c == 13 || c == 32); };
-            auto reader = std::make_unique<QIODeviceReader>(device);
-            auto result = QString::number(Murmur2::hash(reader.get(), 4 * MiB, should_filter_out));
-            device->close();
-            return result;
-        }
-        case Algorithm::Unknown:
-            device->close();
-            return "";
+            return QCryptographicHash::Algorithm::Sha512;
+        default:
+            return {};
+    }
+}
+
+QString hash(QIODevice* device, Algorithm type)
+{
+    if (!device->isOpen() && !device->open(QFile::ReadOnly))
+        return "";
+    if (type == Algorithm::Murmur2) {  // CF-specific
+        auto should_filter_out = [](char c) { return (c == 9 || c == 10 || c == 13 || c == 32); };
+        auto reader = std::make_unique<QIODeviceReader>(device);
+        auto result = QString::number(Murmur2::hash(reader.get(), 4 * MiB, should_filter_out));
+        device->close();
+        return result;
+    }
+    auto alg = cryptographicAlgorithm(type);
+    if (!alg) {
+        device->close();
+        return "";
     }
 
-    QCryptographicHash hash(alg);
+    QCryptographicHash hash(*alg);
     if (!hash.addData(device))
         qCritical() << "Failed to read JAR to create hash!";
 
-    Q_ASSERT(hash.result().length() == hash.hashLength(alg));
+    Q_ASSERT(hash.result().length() == hash.hashLength(*alg));
     auto result = hash.result().toHex();
     device->close();
     return result;
@@ -135,6 +140,46 @@ QString hash(QByteArray data, Algorithm type)
     return hash(&buff, type);
 }
 
+QStringList hash(QString fileName, QList<Algorithm> types)
+{
+    QStringList results;
+    std::vector<std::unique_ptr<QCryptographicHash>> hashes;
+    for (auto type : types) {
+        // murmur2 filters what it reads, so it can't share the reads of the others
+        if (type == Algorithm::Murmur2) {
+            results << hash(fileName, type);
+            hashes.push_back(nullptr);
+        } else if (auto alg = cryptographicAlgorithm(type)) {
+            results << QString();
+            hashes.push_back(std::make_unique<QCryptographicHash>(*alg));
+        } else {
+            results << QString();
+            hashes.push_back(nullptr);
+        }
+    }
+
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return QStringList(types.size(), QString());
+
+    QByteArray buffer(1 * MiB, Qt::Uninitialized);
+    while (!file.atEnd()) {
+        auto read = file.read(buffer.data(), buffer.size());
+        if (read < 0)
+            return QStringList(types.size(), QString());
+        for (auto& hash : hashes) {
+            if (hash)
+                hash->addData(QByteArrayView(buffer.constData(), read));
+        }
+    }
+
+    for (qsizetype i = 0; i < types.size(); i++) {
+        if (hashes[i])
+            results[i] = hashes[i]->result().toHex();
+    }
+    return results;
+}
+
 void Hasher::executeTask()
 {
     m_future = QtConcurrent::run(
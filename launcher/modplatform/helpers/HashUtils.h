@@ -17,6 +17,8 @@ Algorithm algorithmFromString(QString type);
 QString hash(QIODevice* device, Algorithm type);
 QString hash(QString fileName, Algorithm type);
 QString hash(QByteArray data, Algorithm type);
+/** Hashes the file at 'fileName' with each of 'types', reading it only once. The hashes are empty if the file can't be read. */
+QStringList hash(QString fileName, QList<Algorithm> types);
 
 class Hasher : public Task {
     Q_OBJECT
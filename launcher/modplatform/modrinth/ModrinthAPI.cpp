@@ -15,8 +15,8 @@ Task::Ptr ModrinthAPI::currentVersion(QString hash, QString hash_format, QByteAr
 {
     auto netJob = makeShared<NetJob>(QString("Modrinth::GetCurrentVersion"), APPLICATION->network());
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(
-        QString(BuildConfig.MODRINTH_PROD_URL + "/version_file/%1?algorithm=%2").arg(hash, hash_format), response));
+    netJob->addNetAction(
+        makeCachedRequest(QString(BuildConfig.MODRINTH_PROD_URL + "/version_file/%1?algorithm=%2").arg(hash, hash_format), response));
 
     return netJob;
 }
@@ -106,7 +106,17 @@ Task::Ptr ModrinthAPI::getProjects(QStringList addonIds, QByteArray* response) c
     auto netJob = makeShared<NetJob>(QString("Modrinth::GetProjects"), APPLICATION->network());
     auto searchUrl = getMultipleModInfoURL(addonIds);
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(searchUrl), response));
+    netJob->addNetAction(makeCachedRequest(QUrl(searchUrl), response));
+
+    return netJob;
+}
+
+Task::Ptr ModrinthAPI::getVersions(const QStringList& versionIds, QByteArray* response) const
+{
+    auto netJob = makeShared<NetJob>(QString("Modrinth::GetVersions"), APPLICATION->network());
+    auto url = BuildConfig.MODRINTH_PROD_URL + QString("/versions?ids=[\"%1\"]").arg(versionIds.join("\",\""));
+
+    netJob->addNetAction(makeCachedRequest(QUrl(url), response));
 
     return netJob;
 }
@@ -31,6 +31,7 @@ class ModrinthAPI : public ResourceAPI {
                              QByteArray* response);
 
     Task::Ptr getProjects(QStringList addonIds, QByteArray* response) const override;
+    Task::Ptr getVersions(const QStringList& versionIds, QByteArray* response) const;
 
     static Task::Ptr getModCategories(QByteArray* response);
     static QList<ModPlatform::Category> loadCategories(QByteArray* response, QString projectType);
@@ -39,6 +40,10 @@ class ModrinthAPI : public ResourceAPI {
    public:
     auto getSortingMethods() const -> QList<ResourceAPI::SortingMethod> override;
 
+   protected:
+    auto provider() const -> ModPlatform::ResourceProvider override { return ModPlatform::ResourceProvider::MODRINTH; }
+
+   public:
     inline auto getAuthorURL(const QString& name) const -> QString { return "https://modrinth.com/user/" + name; };
 
     static auto getModLoaderStrings(const ModPlatform::ModLoaderTypes types) -> const QStringList
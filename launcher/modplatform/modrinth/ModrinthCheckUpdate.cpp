@@ -5,6 +5,8 @@
 
 #include "Json.h"
 
+#include <QtConcurrentRun>
+
 #include "QObjectPtr.h"
 #include "ResourceDownloadTask.h"
 
@@ -37,8 +39,11 @@ ModrinthCheckUpdate::ModrinthCheckUpdate(QList<Resource*>& resources,
 
 bool ModrinthCheckUpdate::abort()
 {
+    m_aborted = true;
     if (m_job)
         return m_job->abort();
+    if (isRunning())
+        emitAborted();
     return true;
 }
 
@@ -49,8 +54,9 @@ bool ModrinthCheckUpdate::abort()
  * */
 void ModrinthCheckUpdate::executeTask()
 {
+    m_aborted = false;
     setStatus(tr("Preparing resources for Modrinth..."));
-    setProgress(0, (m_loadersList.isEmpty() ? 1 : m_loadersList.length()) * 2 + 1);
+    setProgress(0, 3);
 
     auto hashing_task =
         makeShared<ConcurrentTask>("MakeModrinthHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
@@ -73,160 +79,213 @@ void ModrinthCheckUpdate::executeTask()
     }
 
     if (startHasing) {
-        connect(hashing_task.get(), &Task::finished, this, &ModrinthCheckUpdate::checkNextLoader);
+        connect(hashing_task.get(), &Task::finished, this, &ModrinthCheckUpdate::checkLoaders);
         m_job = hashing_task;
         hashing_task->start();
     } else {
-        checkNextLoader();
+        checkLoaders();
     }
 }
 
-void ModrinthCheckUpdate::getUpdateModsForLoader(std::optional<ModPlatform::ModLoaderTypes> loader, bool forceModLoaderCheck)
+/* The loaders are tried in order, a resource being updated to the version found with the first loader that has one.
+ * The versions for all of them are requested at once, as the API can't be asked for several loaders in order of preference.
+ * */
+void ModrinthCheckUpdate::checkLoaders()
 {
-    m_loaderIdx++;
-
-    setStatus(tr("Waiting for the API response from Modrinth..."));
-    setProgress(m_progress + 1, m_progressTotal);
-
-    auto response = std::make_shared<QByteArray>();
-    QStringList hashes;
-    if (forceModLoaderCheck && loader.has_value()) {
-        for (auto hash : m_mappings.keys()) {
-            if (m_mappings.value(hash)->metadata()->loaders & loader.value()) {
-                hashes.append(hash);
-            }
-        }
-    } else {
-        hashes = m_mappings.keys();
+    if (m_aborted) {
+        if (isRunning())
+            emitAborted();
+        return;
     }
-
-    if (hashes.isEmpty()) {
-        checkNextLoader();
+    if (m_mappings.isEmpty()) {
+        emitSucceeded();
         return;
     }
 
-    auto job = api.latestVersions(hashes, m_hashType, m_gameVersions, loader, response.get());
+    setStatus(tr("Waiting for the API response from Modrinth..."));
+    setProgress(1, 3);
+
+    m_requests.clear();
+    if (m_loadersList.isEmpty()) {  // this are other resources no need to check more than once with empty loader
+        m_requests.append({});
+    } else {  // this are mods so check with loades
+        for (auto loader : m_loadersList)
+            m_requests.append({ ModPlatform::ModLoaderTypes(loader) });
+    }
 
-    connect(job.get(), &Task::succeeded, this, [this, response, loader] { checkVersionsResponse(response.get(), loader); });
+    auto job = makeShared<ConcurrentTask>("ModrinthCheckUpdateLoaders", m_requests.size());
+    for (qsizetype i = 0; i < m_requests.size(); i++) {
+        auto loader = m_requests[i].loader;
 
-    connect(job.get(), &Task::failed, this, &ModrinthCheckUpdate::checkNextLoader);
+        // the loaders added for the mods' own loaders are only asked about those mods
+        QStringList hashes;
+        if (i > m_initialSize && loader.has_value()) {
+            for (auto it = m_mappings.constBegin(); it != m_mappings.constEnd(); it++) {
+                if (it.value()->metadata()->loaders & loader.value())
+                    hashes.append(it.key());
+            }
+        } else {
+            hashes = m_mappings.keys();
+        }
+        if (hashes.isEmpty())
+            continue;
 
+        auto request = api.latestVersions(hashes, m_hashType, m_gameVersions, loader, m_requests[i].response.get());
+        connect(request.get(), &Task::succeeded, this, [this, i] { m_requests[i].succeeded = true; });
+        job->addTask(request);
+    }
+
+    connect(job.get(), &Task::aborted, this, &ModrinthCheckUpdate::emitAborted);
+    connect(job.get(), &Task::finished, this, [this] {
+        if (isRunning() && !m_aborted)
+            checkVersionsResponses();
+    });
     m_job = job;
     job->start();
 }
 
-void ModrinthCheckUpdate::checkVersionsResponse(QByteArray* response, std::optional<ModPlatform::ModLoaderTypes> loader)
+void ModrinthCheckUpdate::checkVersionsResponses()
 {
+    m_job.reset();
     setStatus(tr("Parsing the API response from Modrinth..."));
-    setProgress(m_progress + 1, m_progressTotal);
-
-    QJsonParseError parse_error{};
-    QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError) {
-        qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at" << parse_error.offset
-                   << "reason:" << parse_error.errorString();
-        qWarning() << *response;
+    setProgress(2, 3);
+
+    connect(&m_parseWatcher, &QFutureWatcher<ParsedResponses>::finished, this, [this] {
+        if (isRunning() && !m_aborted)
+            checkVersions(m_parseFuture.result());
+    });
+    m_parseFuture = QtConcurrent::run(QThreadPool::globalInstance(), &ModrinthCheckUpdate::parseResponses, m_requests, m_hashType);
+    m_parseWatcher.setFuture(m_parseFuture);
+}
 
-        emitFailed(parse_error.errorString());
-        return;
+QHash<QString, ModPlatform::IndexedVersion> ModrinthCheckUpdate::loadVersions(const QJsonObject& response,
+                                                                              const QString& hashType,
+                                                                              const QString& loaderFilter)
+{
+    QHash<QString, ModPlatform::IndexedVersion> versions;
+    for (auto it = response.constBegin(); it != response.constEnd(); it++) {
+        auto project_obj = it.value().toObject();
+        // If the returned project is empty, but we have Modrinth metadata,
+        // it means this specific version is not available
+        if (project_obj.isEmpty())
+            continue;
+
+        auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, hashType, loaderFilter);
+        if (project_ver.downloadUrl.isEmpty()) {
+            qCritical() << "Modrinth mod without download url!" << project_ver.fileName;
+            continue;
+        }
+        versions.insert(it.key(), project_ver);
     }
+    return versions;
+}
 
-    try {
-        auto iter = m_mappings.begin();
-
-        while (iter != m_mappings.end()) {
-            const QString hash = iter.key();
-            Resource* resource = iter.value();
-
-            auto project_obj = doc[hash].toObject();
-
-            // If the returned project is empty, but we have Modrinth metadata,
-            // it means this specific version is not available
-            if (project_obj.isEmpty()) {
-                qDebug() << "Mod" << m_mappings.find(hash).value()->name() << "got an empty response. Hash:" << hash;
-                ++iter;
-                continue;
-            }
-
-            // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
-            // so we may want to filter it
-            QString loader_filter;
-            if (loader.has_value()) {
-                for (auto flag : ModPlatform::modLoaderTypesToList(*loader)) {
-                    loader_filter = ModPlatform::getModLoaderAsString(flag);
-                    break;
-                }
-            }
+auto ModrinthCheckUpdate::parseResponses(const QList<LoaderRequest>& requests, const QString& hashType) -> ParsedResponses
+{
+    ParsedResponses parsed;
+    for (auto& request : requests) {
+        if (!request.succeeded) {
+            parsed.versions.append({});
+            continue;
+        }
 
-            // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
-            // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
-            // loader_filter
-            // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
-            // Such is the pain of having arbitrary files for a given version .-.
-
-            auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, m_hashType, loader_filter);
-            if (project_ver.downloadUrl.isEmpty()) {
-                qCritical() << "Modrinth mod without download url!" << project_ver.fileName;
-                ++iter;
-                continue;
-            }
+        QJsonParseError parse_error{};
+        QJsonDocument doc = QJsonDocument::fromJson(*request.response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at" << parse_error.offset
+                       << "reason:" << parse_error.errorString();
+            qWarning() << *request.response;
+            parsed.error = parse_error.errorString();
+            return parsed;
+        }
 
-            // Fake pack with the necessary info to pass to the download task :)
-            auto pack = std::make_shared<ModPlatform::IndexedPack>();
-            pack->name = resource->name();
-            pack->slug = resource->metadata()->slug;
-            pack->addonId = resource->metadata()->project_id;
-            pack->provider = ModPlatform::ResourceProvider::MODRINTH;
-            if ((project_ver.hash != hash && project_ver.is_preferred) || (resource->status() == ResourceStatus::NOT_INSTALLED)) {
-                auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_resourceModel);
-
-                QString old_version = resource->metadata()->version_number;
-                if (old_version.isEmpty()) {
-                    if (resource->status() == ResourceStatus::NOT_INSTALLED)
-                        old_version = tr("Not installed");
-                    else
-                        old_version = tr("Unknown");
-                }
-
-                m_updates.emplace_back(pack->name, hash, old_version, project_ver.version_number, project_ver.version_type,
-                                       project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task, resource->enabled());
+        // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
+        // so we may want to filter it
+        QString loader_filter;
+        if (request.loader.has_value()) {
+            for (auto flag : ModPlatform::modLoaderTypesToList(*request.loader)) {
+                loader_filter = ModPlatform::getModLoaderAsString(flag);
+                break;
             }
-            m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
+        }
 
-            iter = m_mappings.erase(iter);
+        try {
+            parsed.versions.append(loadVersions(doc.object(), hashType, loader_filter));
+        } catch (Json::JsonException& e) {
+            parsed.error = e.cause() + ": " + e.what();
+            return parsed;
         }
-    } catch (Json::JsonException& e) {
-        emitFailed(e.cause() + ": " + e.what());
-        return;
     }
-    checkNextLoader();
+    return parsed;
 }
 
-void ModrinthCheckUpdate::checkNextLoader()
+QHash<QString, ModPlatform::IndexedVersion> ModrinthCheckUpdate::firstVersions(const ParsedResponses& parsed)
 {
-    if (m_mappings.isEmpty()) {
-        emitSucceeded();
-        return;
+    QHash<QString, ModPlatform::IndexedVersion> first;
+    for (auto& versions : parsed.versions) {
+        for (auto it = versions.constBegin(); it != versions.constEnd(); it++) {
+            if (!first.contains(it.key()))
+                first.insert(it.key(), it.value());
+        }
     }
-    if (m_loaderIdx < m_loadersList.size()) {  // this are mods so check with loades
-        getUpdateModsForLoader(m_loadersList.at(m_loaderIdx), m_loaderIdx > m_initialSize);
-        return;
-    } else if (m_loadersList.isEmpty() && m_loaderIdx == 0) {  // this are other resources no need to check more than once with empty loader
-        getUpdateModsForLoader();
+    return first;
+}
+
+void ModrinthCheckUpdate::checkVersions(const ParsedResponses& parsed)
+{
+    if (!parsed.error.isEmpty()) {
+        emitFailed(parsed.error);
         return;
     }
 
-    for (auto resource : m_mappings) {
-        QString reason;
+    auto versions = firstVersions(parsed);
+    for (auto iter = m_mappings.constBegin(); iter != m_mappings.constEnd(); iter++) {
+        const QString hash = iter.key();
+        Resource* resource = iter.value();
+
+        auto version = versions.constFind(hash);
+        if (version == versions.constEnd()) {
+            QString reason;
+
+            if (dynamic_cast<Mod*>(resource) != nullptr)
+                reason =
+                    tr("No valid version found for this resource. It's probably unavailable for the current game "
+                       "version / mod loader.");
+            else
+                reason = tr("No valid version found for this resource. It's probably unavailable for the current game version.");
 
-        if (dynamic_cast<Mod*>(resource) != nullptr)
-            reason =
-                tr("No valid version found for this resource. It's probably unavailable for the current game "
-                   "version / mod loader.");
-        else
-            reason = tr("No valid version found for this resource. It's probably unavailable for the current game version.");
+            emit checkFailed(resource, reason);
+            continue;
+        }
+        auto project_ver = *version;
+
+        // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
+        // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
+        // loader_filter
+        // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
+        // Such is the pain of having arbitrary files for a given version .-.
+
+        // Fake pack with the necessary info to pass to the download task :)
+        auto pack = std::make_shared<ModPlatform::IndexedPack>();
+        pack->name = resource->name();
+        pack->slug = resource->metadata()->slug;
+        pack->addonId = resource->metadata()->project_id;
+        pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+        if ((project_ver.hash != hash && project_ver.is_preferred) || (resource->status() == ResourceStatus::NOT_INSTALLED)) {
+            auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_resourceModel);
+
+            QString old_version = resource->metadata()->version_number;
+            if (old_version.isEmpty()) {
+                if (resource->status() == ResourceStatus::NOT_INSTALLED)
+                    old_version = tr("Not installed");
+                else
+                    old_version = tr("Unknown");
+            }
 
-        emit checkFailed(resource, reason);
+            m_updates.emplace_back(pack->name, hash, old_version, project_ver.version_number, project_ver.version_type,
+                                   project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task, resource->enabled());
+        }
+        m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
     }
 
     emitSucceeded();
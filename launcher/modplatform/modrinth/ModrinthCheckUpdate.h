@@ -1,5 +1,9 @@
 #pragma once
 
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QJsonObject>
+
 #include "modplatform/CheckUpdateTask.h"
 
 class ModrinthCheckUpdate : public CheckUpdateTask {
@@ -11,19 +15,51 @@ class ModrinthCheckUpdate : public CheckUpdateTask {
                         QList<ModPlatform::ModLoaderType> loadersList,
                         ResourceFolderModel* resourceModel);
 
+    /**
+     * The latest versions in a /version_files/update response, by the hash of the file they update.
+     *
+     * Versions without a file to download are left out. Throws a Json::JsonException if the response is malformed.
+     */
+    static QHash<QString, ModPlatform::IndexedVersion> loadVersions(const QJsonObject& response,
+                                                                    const QString& hashType,
+                                                                    const QString& loaderFilter);
+
+    // a request for the latest versions of the resources for one of the loaders
+    struct LoaderRequest {
+        std::optional<ModPlatform::ModLoaderTypes> loader;
+        std::shared_ptr<QByteArray> response = std::make_shared<QByteArray>();
+        bool succeeded = false;
+    };
+    // the latest versions for each request, in the order the loaders are tried, or why they couldn't be read
+    struct ParsedResponses {
+        QList<QHash<QString, ModPlatform::IndexedVersion>> versions;
+        QString error;
+    };
+    /** Parses the responses of the requests. A request that failed or wasn't sent keeps its place, with no versions. */
+    static ParsedResponses parseResponses(const QList<LoaderRequest>& requests, const QString& hashType);
+    /** The version for each hash found with the first loader that has one. */
+    static QHash<QString, ModPlatform::IndexedVersion> firstVersions(const ParsedResponses& parsed);
+
    public slots:
     bool abort() override;
 
    protected slots:
     void executeTask() override;
-    void getUpdateModsForLoader(std::optional<ModPlatform::ModLoaderTypes> loader = {}, bool forceModLoaderCheck = false);
-    void checkVersionsResponse(QByteArray* response, std::optional<ModPlatform::ModLoaderTypes> loader);
-    void checkNextLoader();
+    void checkLoaders();
+    void checkVersionsResponses();
+
+   private:
+    void checkVersions(const ParsedResponses& parsed);
 
    private:
     Task::Ptr m_job = nullptr;
     QHash<QString, Resource*> m_mappings;
     QString m_hashType;
-    int m_loaderIdx = 0;
     int m_initialSize = 0;
+
+    QList<LoaderRequest> m_requests;
+    // the parsing can't be stopped, once aborted its result is thrown away
+    bool m_aborted = false;
+    QFuture<ParsedResponses> m_parseFuture;
+    QFutureWatcher<ParsedResponses> m_parseWatcher;
 };
@@ -11,6 +11,7 @@
 
 #include "minecraft/mod/Mod.h"
 #include "modplatform/EnsureMetadataTask.h"
+#include "modplatform/ModpackUpdatePrefetcher.h"
 #include "modplatform/helpers/OverrideUtils.h"
 
 #include "net/ChecksumValidator.h"
@@ -184,33 +185,6 @@ bool ModrinthCreationTask::createInstance()
     FS::ensureFilePathExists(new_index_place);
     FS::move(index_path, new_index_place);
 
-    auto mcPath = FS::PathCombine(m_stagingPath, m_root_path);
-
-    auto override_path = FS::PathCombine(m_stagingPath, "overrides");
-    if (QFile::exists(override_path)) {
-        // Create a list of overrides in "overrides.txt" inside mrpack/
-        Override::createOverrides("overrides", parent_folder, override_path);
-
-        // Apply the overrides
-        if (!FS::move(override_path, mcPath)) {
-            setError(tr("Could not rename the overrides folder:\n") + "overrides");
-            return false;
-        }
-    }
-
-    // Do client overrides
-    auto client_override_path = FS::PathCombine(m_stagingPath, "client-overrides");
-    if (QFile::exists(client_override_path)) {
-        // Create a list of overrides in "client-overrides.txt" inside mrpack/
-        Override::createOverrides("client-overrides", parent_folder, client_override_path);
-
-        // Apply the overrides
-        if (!FS::overrideFolder(mcPath, client_override_path)) {
-            setError(tr("Could not rename the client overrides folder:\n") + "client overrides");
-            return false;
-        }
-    }
-
     QString configPath = FS::PathCombine(m_stagingPath, "instance.cfg");
     auto instanceSettings = std::make_unique<INISettingsObject>(configPath);
     MinecraftInstance instance(m_globalSettings, std::move(instanceSettings), m_stagingPath);
@@ -270,6 +244,10 @@ bool ModrinthCreationTask::createInstance()
             setError(tr("The file '%1' is missing a download link. This is invalid in the pack format.").arg(fileName));
             return false;
         }
+        if (ModpackUpdatePrefetcher::takePrefetched(ModpackUpdatePrefetcher::modrinthKey(file.hash), file_path)) {
+            qDebug() << "Using the prefetched" << file.path;
+            continue;
+        }
         qDebug() << "Will try to download" << file.downloads.front() << "to" << file_path;
         auto dl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
         dl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
@@ -335,6 +313,37 @@ bool ModrinthCreationTask::createInstance()
     }
     resources.clear();
 
+    // The overrides may still be extracting while the files download. Downloaded files take precedence over client
+    // overrides, which take precedence over overrides, so each is merged in without replacing what is already there.
+    if (!ended_well || !waitForExtraction())
+        return false;
+
+    auto mcPath = FS::PathCombine(m_stagingPath, m_root_path);
+
+    auto client_override_path = FS::PathCombine(m_stagingPath, "client-overrides");
+    if (QFile::exists(client_override_path)) {
+        // Create a list of overrides in "client-overrides.txt" inside mrpack/
+        Override::createOverrides("client-overrides", parent_folder, client_override_path);
+
+        // Apply the overrides
+        if (!FS::mergeFolder(mcPath, client_override_path)) {
+            setError(tr("Could not rename the client overrides folder:\n") + "client overrides");
+            return false;
+        }
+    }
+
+    auto override_path = FS::PathCombine(m_stagingPath, "overrides");
+    if (QFile::exists(override_path)) {
+        // Create a list of overrides in "overrides.txt" inside mrpack/
+        Override::createOverrides("overrides", parent_folder, override_path);
+
+        // Apply the overrides
+        if (!FS::mergeFolder(mcPath, override_path)) {
+            setError(tr("Could not rename the overrides folder:\n") + "overrides");
+            return false;
+        }
+    }
+
     // Update information of the already installed instance, if any.
     if (m_instance && ended_well) {
         setAbortable(false);
@@ -22,6 +22,7 @@
 #include <QCryptographicHash>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include "Json.h"
 #include "MMCZip.h"
@@ -63,11 +64,26 @@ void ModrinthPackExportTask::executeTask()
 
 bool ModrinthPackExportTask::abort()
 {
-    if (task) {
+    if (!zipTask)
+        return false;
+    hashFuture.cancel();
+    if (task)
         task->abort();
-        return true;
-    }
-    return false;
+    // the zip task removes what it has written, and reports when it stopped
+    return zipTask->abort();
+}
+
+void ModrinthPackExportTask::fail(const QString& reason)
+{
+    if (!isRunning())
+        return;
+    emitFailed(reason);
+
+    hashFuture.cancel();
+    if (task)
+        task->abort();
+    if (zipTask)
+        zipTask->abort();
 }
 
 void ModrinthPackExportTask::collectFiles()
@@ -94,9 +110,17 @@ void ModrinthPackExportTask::collectFiles()
 void ModrinthPackExportTask::collectHashes()
 {
     setStatus(tr("Finding file hashes..."));
-    for (const QFileInfo& file : files) {
-        QCoreApplication::processEvents();
 
+    QHash<QString, const Mod*> modsByPath;
+    if (mcInstance) {
+        disconnect(mcInstance->loaderModList(), &ModFolderModel::updateFinished, this, &ModrinthPackExportTask::collectHashes);
+        for (const Mod* mod : mcInstance->loaderModList()->allMods())
+            modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    }
+
+    QList<Candidate> candidates;
+    QStringList candidatePaths;
+    for (const QFileInfo& file : files) {
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
         if (!std::any_of(PREFIXES.begin(), PREFIXES.end(), [&relative](const QString& prefix) { return relative.startsWith(prefix); }))
@@ -106,60 +130,86 @@ void ModrinthPackExportTask::collectHashes()
             }))
             continue;
 
-        QFile openFile(file.absoluteFilePath());
-        if (!openFile.open(QFile::ReadOnly)) {
-            qWarning() << "Could not open" << file << "for hashing";
-            continue;
+        Candidate candidate{ relative, file.absoluteFilePath() };
+        if (const Mod* mod = modsByPath.value(file.absoluteFilePath()); mod && mod->metadata() != nullptr) {
+            const QUrl& url = mod->metadata()->url;
+            // ensure the url is permitted on modrinth.com
+            if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
+                candidate.url = url;
+                candidate.side = mod->metadata()->side;
+            }
         }
+        candidates << candidate;
+        candidatePaths << relative;
+    }
+
+    // everything but the candidates goes to the overrides, which can be written while those are looked up
+    startZip(candidatePaths);
+
+    setAbortable(true);
+    connect(&hashWatcher, &QFutureWatcher<Candidate>::progressValueChanged, this,
+            [this](int value) { setProgress(value, hashWatcher.progressMaximum()); });
+    connect(&hashWatcher, &QFutureWatcher<Candidate>::finished, this, &ModrinthPackExportTask::hashesCollected);
+    hashFuture = QtConcurrent::mapped(QThreadPool::globalInstance(), candidates, &ModrinthPackExportTask::hashCandidate);
+    hashWatcher.setFuture(hashFuture);
+}
 
-        const QByteArray data = openFile.readAll();
-        if (openFile.error() != QFileDevice::NoError) {
-            qWarning() << "Could not read" << file;
+auto ModrinthPackExportTask::hashCandidate(const Candidate& candidate) -> Candidate
+{
+    Candidate hashed = candidate;
+
+    // both hashes come from the file itself, it may have changed since its metadata was written
+    QList<Hashing::Algorithm> algorithms{ Hashing::Algorithm::Sha512 };
+    if (!hashed.url.isEmpty())
+        algorithms << Hashing::Algorithm::Sha1;
+
+    auto hashes = Hashing::hash(hashed.path, algorithms);
+    for (qsizetype i = 0; i < algorithms.size(); i++) {
+        if (algorithms[i] == Hashing::Algorithm::Sha512)
+            hashed.sha512 = hashes[i];
+        else
+            hashed.sha1 = hashes[i];
+    }
+    hashed.size = QFileInfo(hashed.path).size();
+    return hashed;
+}
+
+void ModrinthPackExportTask::hashesCollected()
+{
+    if (hashFuture.isCanceled())
+        return;
+
+    for (const Candidate& candidate : hashFuture.results()) {
+        if (candidate.sha512.isEmpty() || (!candidate.url.isEmpty() && candidate.sha1.isEmpty())) {
+            qWarning() << "Could not read" << candidate.path << "for hashing";
             continue;
         }
-        auto sha512 = Hashing::hash(data, Hashing::Algorithm::Sha512);
-
-        auto allMods = mcInstance->loaderModList()->allMods();
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (mod->metadata() != nullptr) {
-                const QUrl& url = mod->metadata()->url;
-                // ensure the url is permitted on modrinth.com
-                if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
-                    qDebug() << "Resolving" << relative << "from index";
-
-                    auto sha1 = Hashing::hash(data, Hashing::Algorithm::Sha1);
-
-                    ResolvedFile resolvedFile{ sha1, sha512, url.toEncoded(), openFile.size(), mod->metadata()->side };
-                    resolvedFiles[relative] = resolvedFile;
-
-                    // nice! we've managed to resolve based on local metadata!
-                    // no need to enqueue it
-                    continue;
-                }
-            }
+
+        if (!candidate.url.isEmpty()) {
+            qDebug() << "Resolving" << candidate.relative << "from index";
+            resolvedFiles[candidate.relative] =
+                ResolvedFile{ candidate.sha1, candidate.sha512, candidate.url.toEncoded(), candidate.size, candidate.side };
+            continue;
         }
 
-        qDebug() << "Enqueueing" << relative << "for Modrinth query";
-        pendingHashes[relative] = sha512;
+        qDebug() << "Enqueueing" << candidate.relative << "for Modrinth query";
+        pendingHashes[candidate.relative] = candidate.sha512;
     }
 
-    setAbortable(true);
     makeApiRequest();
 }
 
 void ModrinthPackExportTask::makeApiRequest()
 {
     if (pendingHashes.isEmpty())
-        buildZip();
+        completeZip();
     else {
         setStatus(tr("Finding versions for hashes..."));
         auto response = std::make_shared<QByteArray>();
         task = api.currentVersions(pendingHashes.values(), "sha512", response.get());
         connect(task.get(), &Task::succeeded, [this, response]() { parseApiResponse(response.get()); });
-        connect(task.get(), &Task::failed, this, &ModrinthPackExportTask::emitFailed);
-        connect(task.get(), &Task::aborted, this, &ModrinthPackExportTask::emitAborted);
+        connect(task.get(), &Task::failed, this, &ModrinthPackExportTask::fail);
+        connect(task.get(), &Task::aborted, this, [this] { zipTask->abort(); });
         task->start();
     }
 }
@@ -190,21 +240,17 @@ void ModrinthPackExportTask::parseApiResponse(QByteArray* response)
             }
         }
     } catch (const Json::JsonException& e) {
-        emitFailed(tr("Failed to parse versions response: %1").arg(e.what()));
+        fail(tr("Failed to parse versions response: %1").arg(e.what()));
         return;
     }
     pendingHashes.clear();
-    buildZip();
+    completeZip();
 }
 
-void ModrinthPackExportTask::buildZip()
+void ModrinthPackExportTask::startZip(const QStringList& candidates)
 {
-    setStatus(tr("Adding files..."));
-
-    auto zipTask = makeShared<MMCZip::ExportToZipTask>(output, gameRoot, files, "overrides/", true);
-    zipTask->addExtraFile("modrinth.index.json", generateIndex());
-
-    zipTask->setExcludeFiles(resolvedFiles.keys());
+    zipTask = makeShared<MMCZip::ExportToZipTask>(output, gameRoot, files, "overrides/", true);
+    zipTask->setDeferredFiles(candidates);
 
     auto progressStep = std::make_shared<TaskStepProgress>();
     connect(zipTask.get(), &Task::finished, this, [this, progressStep] {
@@ -213,11 +259,14 @@ void ModrinthPackExportTask::buildZip()
     });
 
     connect(zipTask.get(), &Task::succeeded, this, &ModrinthPackExportTask::emitSucceeded);
-    connect(zipTask.get(), &Task::aborted, this, &ModrinthPackExportTask::emitAborted);
+    connect(zipTask.get(), &Task::aborted, this, [this] {
+        if (isRunning())
+            emitAborted();
+    });
     connect(zipTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
         stepProgress(*progressStep);
-        emitFailed(reason);
+        fail(reason);
     });
     connect(zipTask.get(), &Task::stepProgress, this, &ModrinthPackExportTask::propagateStepProgress);
 
@@ -229,10 +278,15 @@ void ModrinthPackExportTask::buildZip()
         progressStep->status = status;
         stepProgress(*progressStep);
     });
-    task.reset(zipTask);
     zipTask->start();
 }
 
+void ModrinthPackExportTask::completeZip()
+{
+    setStatus(tr("Adding files..."));
+    zipTask->complete(resolvedFiles.keys(), { { "modrinth.index.json", generateIndex() } });
+}
+
 QByteArray ModrinthPackExportTask::generateIndex()
 {
     QJsonObject out;
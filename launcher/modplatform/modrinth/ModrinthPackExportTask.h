@@ -22,6 +22,7 @@
 #include <QFutureWatcher>
 #include "BaseInstance.h"
 #include "MMCZip.h"
+#include "archive/ExportToZipTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
@@ -48,6 +49,16 @@ class ModrinthPackExportTask : public Task {
         qint64 size;
         ModPlatform::Side side;
     };
+    // a file that may be downloaded from Modrinth instead of being included
+    struct Candidate {
+        QString relative, path;
+        // set when the file is resolved from its metadata
+        QUrl url;
+        ModPlatform::Side side = ModPlatform::Side::UniversalSide;
+        QString sha1, sha512;
+        qint64 size = 0;
+    };
+    static Candidate hashCandidate(const Candidate& candidate);
 
     static const QStringList PREFIXES;
     static const QStringList FILE_EXTENSIONS;
@@ -66,12 +77,18 @@ class ModrinthPackExportTask : public Task {
     QMap<QString, QString> pendingHashes;
     QMap<QString, ResolvedFile> resolvedFiles;
     Task::Ptr task;
+    shared_qobject_ptr<MMCZip::ExportToZipTask> zipTask;
+    QFuture<Candidate> hashFuture;
+    QFutureWatcher<Candidate> hashWatcher;
 
     void collectFiles();
     void collectHashes();
+    void hashesCollected();
     void makeApiRequest();
     void parseApiResponse(QByteArray* response);
-    void buildZip();
+    void startZip(const QStringList& candidates);
+    void completeZip();
+    void fail(const QString& reason);
 
     QByteArray generateIndex();
 };
@@ -29,6 +29,13 @@ Download::Ptr ApiDownload::makeCached(QUrl url, MetaEntryPtr entry, Download::Op
     return dl;
 }
 
+Download::Ptr ApiDownload::makeCached(QUrl url, QByteArray* output, QString provider, Download::Options options)
+{
+    auto dl = Download::makeCached(url, output, provider, options);
+    dl->addHeaderProxy(std::make_unique<ApiHeaderProxy>());
+    return dl;
+}
+
 Download::Ptr ApiDownload::makeByteArray(QUrl url, QByteArray* output, Download::Options options)
 {
     auto dl = Download::makeByteArray(url, output, options);
@@ -25,6 +25,7 @@ namespace Net {
 
 namespace ApiDownload {
 Download::Ptr makeCached(QUrl url, MetaEntryPtr entry, Download::Options options = Download::Option::NoOptions);
+Download::Ptr makeCached(QUrl url, QByteArray* output, QString provider, Download::Options options = Download::Option::NoOptions);
 Download::Ptr makeByteArray(QUrl url, QByteArray* output, Download::Options options = Download::Option::NoOptions);
 Download::Ptr makeFile(QUrl url, QString path, Download::Options options = Download::Option::NoOptions);
 };  // namespace ApiDownload
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ApiResponseCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QUrlQuery>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+#include "FileSystem.h"
+#include "net/Logging.h"
+
+namespace Net {
+
+namespace {
+constexpr quint32 s_magic = 0x50524143;  // "PRAC"
+constexpr quint32 s_version = 1;
+}  // namespace
+
+ApiResponseCache::ApiResponseCache(QString path, qsizetype memoryLimit) : m_path(std::move(path)), m_memory(memoryLimit) {}
+
+ApiResponseCache::~ApiResponseCache()
+{
+    m_prune.waitForFinished();
+}
+
+QString ApiResponseCache::key(const QString& provider, const QUrl& url)
+{
+    auto normalized = url.adjusted(QUrl::NormalizePathSegments | QUrl::RemoveFragment | QUrl::StripTrailingSlash);
+    normalized.setScheme(normalized.scheme().toLower());
+    normalized.setHost(normalized.host().toLower());
+    if (normalized.port() == (normalized.scheme() == "https" ? 443 : 80))
+        normalized.setPort(-1);
+
+    if (normalized.hasQuery()) {
+        auto items = QUrlQuery(normalized).queryItems(QUrl::FullyEncoded);
+        std::stable_sort(items.begin(), items.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        QUrlQuery query;
+        query.setQueryItems(items);
+        normalized.setQuery(query);
+    }
+
+    return provider + ':' + normalized.toString(QUrl::FullyEncoded);
+}
+
+bool ApiResponseCache::isFresh(const Entry& entry, qint64 ttl, qint64 now)
+{
+    auto lifetime = entry.maxAge >= 0 ? std::min(entry.maxAge, ttl) : ttl;
+    auto age = now - entry.fetchedAt;
+    return age >= 0 && age < lifetime * 1000;
+}
+
+std::optional<ApiResponseCache::Entry> ApiResponseCache::get(const QString& key)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        if (auto entry = m_memory.object(key))
+            return *entry;
+    }
+
+    auto entry = load(key);
+    if (entry) {
+        QMutexLocker locker(&m_lock);
+        m_memory.insert(key, new Entry(*entry), entry->data.size());
+    }
+    return entry;
+}
+
+void ApiResponseCache::insert(const QString& key, Entry entry)
+{
+    save(key, entry);
+
+    QMutexLocker locker(&m_lock);
+    auto size = entry.data.size();
+    m_memory.insert(key, new Entry(std::move(entry)), size);
+}
+
+void ApiResponseCache::remove(const QString& key)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_memory.remove(key);
+    }
+    QFile::remove(filePath(key));
+}
+
+QString ApiResponseCache::filePath(const QString& key) const
+{
+    return FS::PathCombine(m_path, QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex()));
+}
+
+std::optional<ApiResponseCache::Entry> ApiResponseCache::load(const QString& key) const
+{
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic, version;
+    QString storedKey;
+    Entry entry;
+    in >> magic >> version;
+    if (magic != s_magic || version != s_version)
+        return {};
+    in >> storedKey >> entry.etag >> entry.fetchedAt >> entry.maxAge >> entry.data;
+    if (in.status() != QDataStream::Ok || storedKey != key)
+        return {};
+    return entry;
+}
+
+void ApiResponseCache::setDiskLimits(qint64 maxAge, qint64 maxSize)
+{
+    m_maxAge = maxAge;
+    m_maxSize = maxSize;
+    schedulePrune();
+}
+
+void ApiResponseCache::schedulePrune()
+{
+    if (m_maxSize < 0 || m_prune.isRunning())
+        return;
+    m_written = 0;
+    m_prune = QtConcurrent::run(QThreadPool::globalInstance(), [this, maxAge = m_maxAge, maxSize = m_maxSize] { prune(maxAge, maxSize); });
+}
+
+void ApiResponseCache::prune(qint64 maxAge, qint64 maxSize)
+{
+    struct File {
+        QString path;
+        qint64 size;
+        qint64 modified;
+    };
+    QList<File> files;
+    qint64 total = 0;
+    int removed = 0;
+    auto oldest = QDateTime::currentMSecsSinceEpoch() - maxAge * 1000;
+
+    QDirIterator it(m_path, QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden);
+    while (it.hasNext()) {
+        auto info = QFileInfo(it.next());
+        auto modified = info.lastModified().toMSecsSinceEpoch();
+        if (maxAge >= 0 && modified < oldest) {
+            removed += QFile::remove(info.filePath());
+            continue;
+        }
+        files.append({ info.filePath(), info.size(), modified });
+        total += info.size();
+    }
+
+    if (maxSize >= 0 && total > maxSize) {
+        std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.modified < b.modified; });
+        for (auto& file : files) {
+            if (total <= maxSize)
+                break;
+            if (QFile::remove(file.path)) {
+                total -= file.size;
+                removed++;
+            }
+        }
+    }
+    if (removed > 0)
+        qCDebug(taskNetLogC) << "Pruned" << removed << "API cache entries," << total << "bytes left";
+}
+
+void ApiResponseCache::save(const QString& key, const Entry& entry)
+{
+    QByteArray contents;
+    {
+        QDataStream out(&contents, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << s_magic << s_version << key << entry.etag << entry.fetchedAt << entry.maxAge << entry.data;
+    }
+
+    try {
+        FS::ensureFolderPathExists(m_path);
+        FS::write(filePath(key), contents);
+    } catch (const Exception& e) {
+        qCWarning(taskNetLogC) << "Failed to write API cache entry for" << key << ":" << e.cause();
+        return;
+    }
+
+    m_written += contents.size();
+    if (m_maxSize >= 0 && m_written > m_maxSize / 4)
+        schedulePrune();
+}
+
+auto ApiCacheSink::init(QNetworkRequest& request) -> Task::State
+{
+    if (!m_output)
+        return ByteArraySink::init(request);
+
+    m_cached = m_cache->get(m_key);
+    if (m_cached && ApiResponseCache::isFresh(*m_cached, m_ttl, QDateTime::currentMSecsSinceEpoch())) {
+        *m_output = m_cached->data;
+        return Task::State::Succeeded;
+    }
+
+    auto state = ByteArraySink::init(request);
+    if (state == Task::State::Running && m_cached && !m_cached->etag.isEmpty())
+        request.setRawHeader("If-None-Match", m_cached->etag);
+    return state;
+}
+
+auto ApiCacheSink::finalize(QNetworkReply& reply) -> Task::State
+{
+    auto state = ByteArraySink::finalize(reply);
+    if (state != Task::State::Succeeded || !m_output)
+        return state;
+
+    auto status = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    auto cacheControl = reply.rawHeader("Cache-Control").toLower();
+    if (cacheControl.contains("no-store")) {
+        m_cache->remove(m_key);
+        return state;
+    }
+
+    ApiResponseCache::Entry entry;
+    if (status == 304 && m_cached) {
+        qCDebug(taskNetLogC) << "API response not modified:" << m_key;
+        entry = std::move(*m_cached);
+        *m_output = entry.data;
+    } else if (status == 200) {
+        entry.data = *m_output;
+    } else {
+        return state;
+    }
+
+    if (reply.hasRawHeader("ETag"))
+        entry.etag = reply.rawHeader("ETag");
+    entry.fetchedAt = QDateTime::currentMSecsSinceEpoch();
+    entry.maxAge = -1;
+    if (cacheControl.contains("no-cache")) {
+        entry.maxAge = 0;
+    } else {
+        static const QRegularExpression s_maxAgeExpr("max-age=([0-9]+)");
+        auto match = s_maxAgeExpr.match(QString::fromLatin1(cacheControl));
+        if (match.hasMatch())
+            entry.maxAge = std::max<qint64>(0, match.captured(1).toLongLong() - reply.rawHeader("Age").toLongLong());
+    }
+
+    m_cache->insert(m_key, std::move(entry));
+    return state;
+}
+
+}  // namespace Net
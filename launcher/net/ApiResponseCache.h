@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QFuture>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QString>
+#include <QUrl>
+
+#include <optional>
+
+#include "ByteArraySink.h"
+
+namespace Net {
+
+/**
+ * Cache of the responses of modding platform APIs.
+ *
+ * Responses are kept in memory up to a size limit, least recently used first out, and on disk under the cache directory.
+ * An entry is fresh for the lifetime the server gave it, but never longer than the TTL the cache is asked for. Stale entries
+ * with an ETag are revalidated with a conditional request instead of being downloaded again.
+ */
+class ApiResponseCache {
+   public:
+    struct Entry {
+        QByteArray data;
+        QByteArray etag;
+        qint64 fetchedAt = 0;  ///< msecs since epoch
+        qint64 maxAge = -1;    ///< seconds, -1 when the server did not limit it
+    };
+
+    explicit ApiResponseCache(QString path, qsizetype memoryLimit = 32 * 1024 * 1024);
+    /** Waits for a running prune(). */
+    ~ApiResponseCache();
+
+    /** The key of a request: the provider and its URL, with the query items in a fixed order. */
+    static QString key(const QString& provider, const QUrl& url);
+
+    /** Whether 'entry' can be used without asking the server, given a TTL in seconds. */
+    static bool isFresh(const Entry& entry, qint64 ttl, qint64 now);
+
+    std::optional<Entry> get(const QString& key);
+    void insert(const QString& key, Entry entry);
+    void remove(const QString& key);
+
+    /**
+     * Limits what is kept on disk to entries written in the last 'maxAge' seconds, taking at most 'maxSize' bytes.
+     * Prunes in the background now, and again whenever about a quarter of 'maxSize' was written since.
+     */
+    void setDiskLimits(qint64 maxAge, qint64 maxSize);
+    /** Deletes the files of entries older than 'maxAge' seconds, then the oldest ones until the rest takes at most 'maxSize' bytes. */
+    void prune(qint64 maxAge, qint64 maxSize);
+
+   private:
+    QString filePath(const QString& key) const;
+    std::optional<Entry> load(const QString& key) const;
+    void save(const QString& key, const Entry& entry);
+    void schedulePrune();
+
+   private:
+    QString m_path;
+
+    qint64 m_maxAge = -1;
+    qint64 m_maxSize = -1;
+    // bytes written since the last prune
+    qint64 m_written = 0;
+    QFuture<void> m_prune;
+
+    QMutex m_lock;
+    QCache<QString, Entry> m_memory;
+};
+
+/*
+ * Sink for API requests that answers from an ApiResponseCache when it can, and fills it otherwise.
+ */
+class ApiCacheSink : public ByteArraySink {
+   public:
+    ApiCacheSink(ApiResponseCache* cache, QString key, qint64 ttl, QByteArray* output)
+        : ByteArraySink(output), m_cache(cache), m_key(std::move(key)), m_ttl(ttl)
+    {}
+
+    auto init(QNetworkRequest& request) -> Task::State override;
+    auto finalize(QNetworkReply& reply) -> Task::State override;
+
+   private:
+    ApiResponseCache* m_cache;
+    QString m_key;
+    qint64 m_ttl;
+
+    std::optional<ApiResponseCache::Entry> m_cached;
+};
+
+}  // namespace Net
@@ -47,6 +47,11 @@
 #include "ChecksumValidator.h"
 #include "MetaCacheSink.h"
 
+#if defined(LAUNCHER_APPLICATION)
+#include "Application.h"
+#include "ApiResponseCache.h"
+#endif
+
 namespace Net {
 
 #if defined(LAUNCHER_APPLICATION)
@@ -61,6 +66,18 @@ auto Download::makeCached(QUrl url, MetaEntryPtr entry, Options options) -> Down
     dl->m_sink.reset(cachedNode);
     return dl;
 }
+
+auto Download::makeCached(QUrl url, QByteArray* output, QString provider, Options options) -> Download::Ptr
+{
+    auto dl = makeShared<Download>();
+    dl->m_url = url;
+    dl->setObjectName(QString("API:") + url.toString());
+    dl->m_options = options;
+    auto key = ApiResponseCache::key(provider, url);
+    auto ttl = APPLICATION->settings()->get("ApiCacheTTL").toLongLong();
+    dl->m_sink.reset(new ApiCacheSink(APPLICATION->apiCache(), key, ttl, output));
+    return dl;
+}
 #endif
 
 auto Download::makeByteArray(QUrl url, QByteArray* output, Options options) -> Download::Ptr
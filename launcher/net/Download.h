@@ -52,6 +52,8 @@ class Download : public NetRequest {
 
 #if defined(LAUNCHER_APPLICATION)
     static auto makeCached(QUrl url, MetaEntryPtr entry, Options options = Option::NoOptions) -> Download::Ptr;
+    /** A download into 'output' that goes through the API response cache, with the responses of 'provider'. */
+    static auto makeCached(QUrl url, QByteArray* output, QString provider, Options options = Option::NoOptions) -> Download::Ptr;
 #endif
 
     static auto makeByteArray(QUrl url, QByteArray* output, Options options = Option::NoOptions) -> Download::Ptr;
@@ -79,6 +79,7 @@ void NetRequest::executeTask()
     }
 
     QNetworkRequest request(m_url);
+    request.setPriority(m_priority);
     m_state = m_sink->init(request);
     switch (m_state) {
         case State::Succeeded:
@@ -75,6 +75,9 @@ class NetRequest : public Task {
     // automatically handle HTTP 429 Too Many Requests errors and retry
     void enableAutoRetry(bool enable);
 
+    // lower it for requests nobody is waiting for, like background prefetches
+    void setPriority(QNetworkRequest::Priority priority) { m_priority = priority; }
+
     QUrl url() const;
     void setUrl(QUrl url) { m_url = url; }
     int replyStatusCode() const;
@@ -115,6 +118,8 @@ class NetRequest : public Task {
     QUrl m_url;
     std::vector<std::unique_ptr<Net::HeaderProxy>> m_headerProxies;
 
+    QNetworkRequest::Priority m_priority = QNetworkRequest::NormalPriority;
+
     int m_retryCount = 0;
     QTimer m_retryTimer;
 };
@@ -42,7 +42,6 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegularExpression>
-#include <QUrlQuery>
 #include "logs/AnonymizeLog.h"
 
 const std::array<PasteUpload::PasteTypeInfo, 4> PasteUpload::PasteTypes = { { { "0x0.st", "https://0x0.st", "" },
@@ -50,53 +49,82 @@ const std::array<PasteUpload::PasteTypeInfo, 4> PasteUpload::PasteTypes = { { {
                                                                               { "paste.gg", "https://paste.gg", "/api/v1/pastes" },
                                                                               { "mclo.gs", "https://api.mclo.gs", "/1/log" } } };
 
+bool PasteUpload::writeBody(const QByteArray& prefix, const std::function<QByteArray(const QString&)>& encode, const QByteArray& suffix)
+{
+    m_body = std::make_unique<QTemporaryFile>();
+    if (!m_body->open()) {
+        return false;
+    }
+    bool ok = m_body->write(prefix) == prefix.size();
+    LogAnonymizer anonymizer([this, &encode, &ok](const QString& line) {
+        auto data = encode(line);
+        ok = ok && m_body->write(data) == data.size();
+    });
+    m_log(anonymizer);
+    anonymizer.finish();
+    ok = ok && m_body->write(suffix) == suffix.size();
+    return ok && m_body->seek(0);
+}
+
 QNetworkReply* PasteUpload::getReply(QNetworkRequest& request)
 {
+    // every uploader gets the log through the same line by line anonymization, only the encoding of the body differs
+    auto utf8 = [](const QString& line) { return line.toUtf8(); };
+    bool written = false;
     switch (m_paste_type) {
-        case PasteUpload::NullPointer: {
-            QHttpMultiPart* multiPart = new QHttpMultiPart{ QHttpMultiPart::FormDataType, this };
-
-            QHttpPart filePart;
-            filePart.setBody(m_log.toUtf8());
-            filePart.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
-            filePart.setHeader(QNetworkRequest::ContentDispositionHeader, "form-data; name=\"file\"; filename=\"log.txt\"");
-            multiPart->append(filePart);
-
-            return m_network->post(request, multiPart);
-        }
-        case PasteUpload::Hastebin: {
-            return m_network->post(request, m_log.toUtf8());
-        }
-        case PasteUpload::Mclogs: {
-            QUrlQuery postData;
-            postData.addQueryItem("content", m_log);
+        case PasteUpload::NullPointer:
+        case PasteUpload::Hastebin:
+            written = writeBody({}, utf8, {});
+            break;
+        case PasteUpload::Mclogs:
             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
-            return m_network->post(request, postData.toString().toUtf8());
-        }
+            written = writeBody("content=", [](const QString& line) { return QUrl::toPercentEncoding(line.toUtf8()); }, {});
+            break;
         case PasteUpload::PasteGG: {
-            QJsonObject obj;
-            QJsonDocument doc;
             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
-            obj.insert("expires", QDateTime::currentDateTimeUtc().addDays(100).toString(Qt::DateFormat::ISODate));
-
-            QJsonArray files;
-            QJsonObject logFileInfo;
+            // the log goes where the placeholder is, escaped a line at a time
             QJsonObject logFileContentInfo;
             logFileContentInfo.insert("format", "text");
-            logFileContentInfo.insert("value", m_log);
+            logFileContentInfo.insert("value", "@LOG@");
+            QJsonObject logFileInfo;
             logFileInfo.insert("name", "log.txt");
             logFileInfo.insert("content", logFileContentInfo);
-            files.append(logFileInfo);
-
-            obj.insert("files", files);
-
-            doc.setObject(obj);
-            return m_network->post(request, doc.toJson());
+            QJsonObject obj;
+            obj.insert("expires", QDateTime::currentDateTimeUtc().addDays(100).toString(Qt::DateFormat::ISODate));
+            obj.insert("files", QJsonArray{ logFileInfo });
+
+            auto json = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+            auto placeholder = json.indexOf("@LOG@");
+            auto escape = [](const QString& line) {
+                auto quoted = QJsonDocument(QJsonArray{ line }).toJson(QJsonDocument::Compact);
+                // strip the ["..."] around the string
+                return quoted.mid(2, quoted.size() - 4);
+            };
+            written = writeBody(json.left(placeholder), escape, json.mid(placeholder + 5));
+            break;
         }
     }
+    if (!written) {
+        m_state = State::Failed;
+        m_failReason = tr("Failed to write the log to upload: %1").arg(m_body ? m_body->errorString() : QString());
+        emit failed(m_failReason);
+        emit finished();
+        return nullptr;
+    }
+
+    if (m_paste_type == PasteUpload::NullPointer) {
+        QHttpMultiPart* multiPart = new QHttpMultiPart{ QHttpMultiPart::FormDataType, this };
 
-    return nullptr;
+        QHttpPart filePart;
+        filePart.setBodyDevice(m_body.get());
+        filePart.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
+        filePart.setHeader(QNetworkRequest::ContentDispositionHeader, "form-data; name=\"file\"; filename=\"log.txt\"");
+        multiPart->append(filePart);
+
+        return m_network->post(request, multiPart);
+    }
+    return m_network->post(request, m_body.get());
 };
 
 auto PasteUpload::Sink::finalize(QNetworkReply& reply) -> Task::State
@@ -201,9 +229,14 @@ auto PasteUpload::Sink::finalize(QNetworkReply& reply) -> Task::State
     return Task::State::Succeeded;
 }
 
-PasteUpload::PasteUpload(const QString& log, QString url, PasteType pasteType) : m_log(log), m_baseUrl(url), m_paste_type(pasteType)
+PasteUpload::PasteUpload(const QString& log, QString url, PasteType pasteType)
+    : PasteUpload([log](LogAnonymizer& anonymizer) { anonymizer.write(log); }, std::move(url), pasteType)
+{}
+
+PasteUpload::PasteUpload(LogSource log, QString url, PasteType pasteType)
+    : m_log(std::move(log)), m_baseUrl(std::move(url)), m_paste_type(pasteType)
 {
-    anonymizeLog(m_log);
+    // the log is anonymized while the request body is built, see getReply()
     auto base = PasteUpload::PasteTypes.at(pasteType);
     if (m_baseUrl.isEmpty())
         m_baseUrl = base.defaultBase;
@@ -42,10 +42,14 @@
 #include <QNetworkReply>
 #include <QRegularExpression>
 #include <QString>
+#include <QTemporaryFile>
 
 #include <array>
+#include <functional>
 #include <memory>
 
+class LogAnonymizer;
+
 class PasteUpload : public Net::NetRequest {
    public:
     enum PasteType : int {
@@ -82,14 +86,22 @@ class PasteUpload : public Net::NetRequest {
     };
     friend Sink;
 
+    /// writes the log into the anonymizer, in pieces of any size. it may be called again when the request is retried
+    using LogSource = std::function<void(LogAnonymizer&)>;
+
     PasteUpload(const QString& log, QString url, PasteType pasteType);
+    PasteUpload(LogSource log, QString url, PasteType pasteType);
     virtual ~PasteUpload() = default;
 
     QString pasteLink() { return m_pasteLink; }
 
    private:
     virtual QNetworkReply* getReply(QNetworkRequest&) override;
-    QString m_log;
+    bool writeBody(const QByteArray& prefix, const std::function<QByteArray(const QString&)>& encode, const QByteArray& suffix);
+
+    LogSource m_log;
+    // the anonymized request body, spooled to disk instead of being held in memory
+    std::unique_ptr<QTemporaryFile> m_body;
     QString m_pasteLink;
     QString m_baseUrl;
     const PasteType m_paste_type;
@@ -37,6 +37,7 @@
 #include "settings/INIFile.h"
 #include <FileSystem.h>
 
+#include <QBuffer>
 #include <QDebug>
 #include <QFile>
 #include <QStringList>
@@ -45,18 +46,18 @@
 
 #include <QSettings>
 #include "Json.h"
+#include "settings/IniFormat.h"
 
 INIFile::INIFile() {}
 
-bool INIFile::saveFile(QString fileName)
+// QSettings can store any QVariant, the native writer only handles the types settings actually use
+static bool saveWithQSettings(const INIFile& ini, const QString& fileName)
 {
-    if (!contains("ConfigVersion"))
-        insert("ConfigVersion", "1.3");
     QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
     _settings_obj.setFallbacksEnabled(false);
     _settings_obj.clear();
 
-    for (Iterator iter = begin(); iter != end(); iter++)
+    for (auto iter = ini.begin(); iter != ini.end(); iter++)
         _settings_obj.setValue(iter.key(), iter.value());
 
     _settings_obj.sync();
@@ -74,6 +75,24 @@ bool INIFile::saveFile(QString fileName)
     return true;
 }
 
+bool INIFile::saveFile(QString fileName)
+{
+    if (!contains("ConfigVersion"))
+        insert("ConfigVersion", "1.3");
+
+    QByteArray data;
+    if (!IniFormat::write(*this, data))
+        return saveWithQSettings(*this, fileName);
+
+    try {
+        FS::write(fileName, data);
+    } catch (const FS::FileSystemException& e) {
+        qCritical() << "Failed to save" << fileName << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
+
 QString unescape(QString orig)
 {
     QString out;
@@ -171,7 +190,7 @@ QVariant migrateQByteArrayToBase64(QString key, QVariant value)
     return value;
 }
 
-bool INIFile::loadFile(QString fileName)
+static bool readWithQSettings(const QString& fileName, QVariantMap& values)
 {
     QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
     _settings_obj.setFallbacksEnabled(false);
@@ -183,55 +202,89 @@ bool INIFile::loadFile(QString fileName)
             qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
         return false;
     }
-    if (!_settings_obj.value("ConfigVersion").isValid()) {
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly))
+    for (auto&& key : _settings_obj.allKeys()) {
+        values.insert(key, _settings_obj.value(key));
+    }
+    return true;
+}
+
+// 'fileName' is only needed for the rare values only QSettings can decode, it may be empty
+static bool loadInto(INIFile& ini, const QByteArray& data, const QString& fileName)
+{
+    QVariantMap values;
+    switch (IniFormat::read(data, values)) {
+        case IniFormat::Status::Ok:
+            break;
+        case IniFormat::Status::FormatError:
+            qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
+            return false;
+        case IniFormat::Status::Unsupported: {
+            values.clear();
+            if (!fileName.isEmpty()) {
+                if (!readWithQSettings(fileName, values))
+                    return false;
+                break;
+            }
+            QTemporaryFile file;
+            if (!file.open())
+                return false;
+            file.write(data);
+            file.close();
+            if (!readWithQSettings(file.fileName(), values))
+                return false;
+            break;
+        }
+    }
+
+    if (!values.value("ConfigVersion").isValid()) {
+        QBuffer buffer;
+        buffer.setData(data);
+        if (!buffer.open(QIODevice::ReadOnly))
             return false;
         QSettings::SettingsMap map;
-        parseOldFileFormat(file, map);
-        file.close();
+        parseOldFileFormat(buffer, map);
         for (auto&& key : map.keys()) {
             auto value = migrateQByteArrayToBase64(key, map.value(key));
-            insert(key, value);
+            ini.insert(key, value);
         }
-        insert("ConfigVersion", "1.3");
-    } else if (_settings_obj.value("ConfigVersion").toString() == "1.1") {
-        for (auto&& key : _settings_obj.allKeys()) {
-            auto value = migrateQByteArrayToBase64(key, _settings_obj.value(key));
+        ini.insert("ConfigVersion", "1.3");
+    } else if (values.value("ConfigVersion").toString() == "1.1") {
+        for (auto iter = values.cbegin(); iter != values.cend(); iter++) {
+            auto value = migrateQByteArrayToBase64(iter.key(), iter.value());
             if (auto valueStr = value.toString();
                 (valueStr.contains(QChar(';')) || valueStr.contains(QChar('=')) || valueStr.contains(QChar(','))) &&
                 valueStr.endsWith("\"") && valueStr.startsWith("\"")) {
-                insert(key, unquote(valueStr));
+                ini.insert(iter.key(), unquote(valueStr));
             } else {
-                insert(key, value);
+                ini.insert(iter.key(), value);
             }
         }
-        insert("ConfigVersion", "1.3");
-    } else if (_settings_obj.value("ConfigVersion").toString() == "1.2") {
-        for (auto&& key : _settings_obj.allKeys()) {
-            auto value = migrateQByteArrayToBase64(key, _settings_obj.value(key));
-            insert(key, value);
+        ini.insert("ConfigVersion", "1.3");
+    } else if (values.value("ConfigVersion").toString() == "1.2") {
+        for (auto iter = values.cbegin(); iter != values.cend(); iter++) {
+            ini.insert(iter.key(), migrateQByteArrayToBase64(iter.key(), iter.value()));
         }
-        insert("ConfigVersion", "1.3");
+        ini.insert("ConfigVersion", "1.3");
     } else {
-        for (auto&& key : _settings_obj.allKeys()) {
-            insert(key, _settings_obj.value(key));
-        }
+        ini.insert(values);
     }
     return true;
 }
 
-bool INIFile::loadFile(QByteArray data)
+bool INIFile::loadFile(QString fileName)
 {
-    QTemporaryFile file;
-    if (!file.open())
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (file.exists())
+            qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
         return false;
-    file.write(data);
-    file.flush();
-    file.close();
-    auto loaded = loadFile(file.fileName());
-    file.remove();
-    return loaded;
+    }
+    return loadInto(*this, file.readAll(), fileName);
+}
+
+bool INIFile::loadFile(QByteArray data)
+{
+    return loadInto(*this, data, QString());
 }
 
 QVariant INIFile::get(QString key, QVariant def) const
@@ -17,7 +17,12 @@
 #include "Setting.h"
 
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+
+// how long changes have to be quiet before they are written in write-behind mode
+static const int WRITE_BEHIND_DELAY_MS = 250;
 
 INISettingsObject::INISettingsObject(QStringList paths, QObject* parent) : SettingsObject(parent)
 {
@@ -44,29 +49,85 @@ INISettingsObject::INISettingsObject(QString path, QObject* parent) : SettingsOb
     m_ini.loadFile(path);
 }
 
+INISettingsObject::INISettingsObject(QString path, INIFile contents, QObject* parent) : SettingsObject(parent), m_ini(std::move(contents))
+{
+    m_filePath = path;
+}
+
+INISettingsObject::~INISettingsObject()
+{
+    // whoever listens may be going away as well
+    blockSignals(true);
+    flush();
+}
+
+void INISettingsObject::setWriteBehind(bool enabled)
+{
+    if (m_writeBehind == enabled)
+        return;
+    m_writeBehind = enabled;
+    if (enabled) {
+        m_saveTimer.setSingleShot(true);
+        m_saveTimer.setInterval(WRITE_BEHIND_DELAY_MS);
+        connect(&m_saveTimer, &QTimer::timeout, this, &INISettingsObject::flush, Qt::UniqueConnection);
+    } else {
+        flush();
+    }
+}
+
+void INISettingsObject::flush()
+{
+    if (!m_saveTimer.isActive())
+        return;
+    m_saveTimer.stop();
+    // the folder went away (e.g. the instance was deleted) while the write was pending, don't bring it back
+    if (!QFileInfo(m_filePath).dir().exists()) {
+        qWarning() << "Dropping pending changes to" << m_filePath << "as its folder no longer exists";
+        return;
+    }
+    write();
+}
+
 void INISettingsObject::setFilePath(const QString& filePath)
 {
+    flush();
     m_filePath = filePath;
 }
 
 bool INISettingsObject::reload()
 {
+    flush();
     return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
 void INISettingsObject::suspendSave()
 {
     m_suspendSave = true;
+    // a pending write-behind is taken over by resumeSave()
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        m_doSave = true;
+    }
 }
 
 void INISettingsObject::resumeSave()
 {
     m_suspendSave = false;
     if (m_doSave) {
-        m_ini.saveFile(m_filePath);
+        m_doSave = false;
+        m_saveTimer.stop();
+        write();
     }
 }
 
+void INISettingsObject::resumeSave(const INIFile& written)
+{
+    if (m_ini == written) {
+        m_doSave = false;
+    }
+    resumeSave();
+}
+
 void INISettingsObject::changeSetting(const Setting& setting, QVariant value)
 {
     if (contains(setting.id())) {
@@ -90,8 +151,17 @@ void INISettingsObject::doSave()
 {
     if (m_suspendSave) {
         m_doSave = true;
+    } else if (m_writeBehind) {
+        m_saveTimer.start();
     } else {
-        m_ini.saveFile(m_filePath);
+        write();
+    }
+}
+
+void INISettingsObject::write()
+{
+    if (m_ini.saveFile(m_filePath)) {
+        emit saved();
     }
 }
 
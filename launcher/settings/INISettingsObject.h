@@ -16,6 +16,7 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 
 #include "settings/INIFile.h"
 
@@ -32,6 +33,12 @@ class INISettingsObject : public SettingsObject {
 
     explicit INISettingsObject(QString path, QObject* parent = nullptr);
 
+    /** Use already parsed contents of the INI file at 'path', e.g. read on a worker thread. */
+    INISettingsObject(QString path, INIFile contents, QObject* parent = nullptr);
+
+    /** Writes pending changes, see setWriteBehind(). */
+    ~INISettingsObject() override;
+
     /*!
      * \brief Gets the path to the INI file.
      * \return The path to the INI file.
@@ -44,10 +51,30 @@ class INISettingsObject : public SettingsObject {
      */
     virtual void setFilePath(const QString& filePath);
 
+    /** The values as they were last loaded from or written to the INI file. */
+    const INIFile& contents() const { return m_ini; }
+
     bool reload() override;
 
     void suspendSave() override;
     void resumeSave() override;
+    /*!
+     * \brief Resume saving after the contents were written by someone else, e.g. on a worker thread.
+     * \param written What was written. If the values changed since, they are saved as usual.
+     */
+    void resumeSave(const INIFile& written);
+    void flush() override;
+
+    /*!
+     * \brief Coalesce writes: save once changes have been quiet for a moment instead of on every change.
+     * Pending changes are written by flush(), reload(), resumeSave() and on destruction.
+     * Needs an event loop in the thread of this object.
+     */
+    void setWriteBehind(bool enabled);
+
+   signals:
+    /** The INI file was written. */
+    void saved();
 
    protected slots:
     virtual void changeSetting(const Setting& setting, QVariant value) override;
@@ -56,8 +83,11 @@ class INISettingsObject : public SettingsObject {
    protected:
     virtual QVariant retrieveValue(const Setting& setting) override;
     void doSave();
+    void write();
 
    protected:
     INIFile m_ini;
     QString m_filePath;
+    bool m_writeBehind = false;
+    QTimer m_saveTimer;
 };
@@ -0,0 +1,531 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "IniFormat.h"
+
+#include <QStringList>
+
+namespace IniFormat {
+
+#if defined(Q_OS_WIN)
+static const char s_eol[] = "\r\n";
+#else
+static const char s_eol[] = "\n";
+#endif
+
+static const char s_hexDigits[] = "0123456789ABCDEF";
+
+static bool isSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+static int fromHex(char16_t ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+static int fromOct(char16_t ch)
+{
+    return ch >= '0' && ch <= '7' ? ch - '0' : -1;
+}
+
+/*
+ * Reading
+ */
+
+// Finds the next logical line starting at 'pos'. Quoted values may span lines, ';' starts a comment.
+static bool readLine(QByteArrayView data, qsizetype& pos, qsizetype& lineStart, qsizetype& lineLen, qsizetype& equalsPos)
+{
+    const qsizetype size = data.size();
+    bool inQuotes = false;
+    equalsPos = -1;
+
+    lineStart = pos;
+    while (lineStart < size && isSpace(data[lineStart]))
+        ++lineStart;
+
+    qsizetype i = lineStart;
+    while (i < size) {
+        char ch = data[i++];
+        if (ch == '=') {
+            if (!inQuotes && equalsPos == -1)
+                equalsPos = i - 1;
+        } else if (ch == '\n' || ch == '\r') {
+            if (i == lineStart + 1) {
+                ++lineStart;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        } else if (ch == '\\') {
+            if (i < size) {
+                char escaped = data[i++];
+                // \n, \r, \r\n and \n\r are all line terminators
+                if (i < size && ((escaped == '\n' && data[i] == '\r') || (escaped == '\r' && data[i] == '\n')))
+                    ++i;
+            }
+        } else if (ch == '"') {
+            inQuotes = !inQuotes;
+        } else if (ch == ';') {
+            if (i == lineStart + 1) {
+                while (i < size && data[i] != '\n' && data[i] != '\r')
+                    ++i;
+                while (i < size && isSpace(data[i]))
+                    ++i;
+                lineStart = i;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        }
+    }
+
+    pos = i;
+    lineLen = i - lineStart;
+    return lineLen > 0;
+}
+
+static void unescapeKey(QByteArrayView key, QString& result)
+{
+    const QString decoded = QString::fromUtf8(key);
+    const qsizetype size = decoded.size();
+    result.reserve(result.size() + size);
+    qsizetype i = 0;
+    while (i < size) {
+        char16_t ch = decoded[i].unicode();
+        if (ch == '\\') {
+            result += '/';
+            ++i;
+            continue;
+        }
+        if (ch != '%' || i == size - 1) {
+            result += decoded[i];
+            ++i;
+            continue;
+        }
+
+        // %XX or %UXXXX
+        qsizetype firstDigit = i + 1;
+        int numDigits = 2;
+        if (decoded[firstDigit] == 'U') {
+            ++firstDigit;
+            numDigits = 4;
+        }
+        bool ok = firstDigit + numDigits <= size;
+        if (ok)
+            ch = QStringView(decoded).sliced(firstDigit, numDigits).toUShort(&ok, 16);
+        if (!ok) {
+            result += '%';
+            ++i;
+            continue;
+        }
+        result += QChar(ch);
+        i = firstDigit + numDigits;
+    }
+}
+
+static void chopTrailingSpaces(QString& str, qsizetype limit)
+{
+    while (str.size() > limit && (str.back() == ' ' || str.back() == '\t'))
+        str.chop(1);
+}
+
+// Decodes the raw value of a key. Returns true if it is a comma separated list, which then ends up in 'list'.
+static bool unescapeValue(QByteArrayView str, QString& result, QStringList& list)
+{
+    static const char escapeCodes[][2] = { { 'a', '\a' }, { 'b', '\b' }, { 'f', '\f' },  { 'n', '\n' },  { 'r', '\r' }, { 't', '\t' },
+                                           { 'v', '\v' }, { '"', '"' },  { '?', '?' },   { '\'', '\'' }, { '\\', '\\' } };
+
+    bool isList = false;
+    bool inQuotes = false;
+    bool quoted = false;
+    qsizetype i = 0;
+
+    auto skipSpaces = [&] {
+        while (i < str.size() && (str[i] == ' ' || str[i] == '\t'))
+            ++i;
+    };
+    // note that a value ending in the middle of an escape sequence is not trimmed
+    auto finish = [&](bool trim, qsizetype chopLimit) {
+        if (trim && !quoted)
+            chopTrailingSpaces(result, chopLimit);
+        if (isList)
+            list.append(result);
+        return isList;
+    };
+
+    skipSpaces();
+    // whatever came before this is kept, even if it is white space
+    qsizetype chopLimit = result.size();
+    while (i < str.size()) {
+        char ch = str[i];
+        if (ch == '\\') {
+            if (++i >= str.size())
+                return finish(false, chopLimit);
+            ch = str[i++];
+
+            bool known = false;
+            for (auto& code : escapeCodes) {
+                if (ch == code[0]) {
+                    result += QLatin1Char(code[1]);
+                    known = true;
+                    break;
+                }
+            }
+            if (!known && ch == 'x') {
+                if (i >= str.size())
+                    return finish(false, chopLimit);
+                if (fromHex(str[i]) != -1) {
+                    char16_t value = 0;
+                    while (i < str.size() && fromHex(str[i]) != -1)
+                        value = (value << 4) + fromHex(str[i++]);
+                    result += QChar(value);
+                    if (i >= str.size())
+                        return finish(false, chopLimit);
+                }
+            } else if (!known && fromOct(ch) != -1) {
+                char16_t value = fromOct(ch);
+                while (i < str.size() && fromOct(str[i]) != -1)
+                    value = (value << 3) + fromOct(str[i++]);
+                result += QChar(value);
+                if (i >= str.size())
+                    return finish(false, chopLimit);
+            } else if (!known && (ch == '\n' || ch == '\r')) {
+                // escaped line break, skip the other half of \r\n and \n\r too
+                if (i < str.size() && (str[i] == '\n' || str[i] == '\r') && str[i] != ch)
+                    ++i;
+            }
+            // unknown escapes are dropped
+            chopLimit = result.size();
+        } else if (ch == '"') {
+            ++i;
+            quoted = true;
+            inQuotes = !inQuotes;
+            if (!inQuotes) {
+                skipSpaces();
+                chopLimit = result.size();
+            }
+        } else if (ch == ',' && !inQuotes) {
+            if (!quoted)
+                chopTrailingSpaces(result, chopLimit);
+            isList = true;
+            list.append(result);
+            result.clear();
+            quoted = false;
+            ++i;
+            skipSpaces();
+            chopLimit = 0;
+        } else {
+            // plain run of text, up to the next character with a meaning
+            qsizetype end = i + 1;
+            while (end < str.size() && str[end] != '\\' && str[end] != '"' && str[end] != ',')
+                ++end;
+            result += QString::fromUtf8(str.sliced(i, end - i));
+            i = end;
+        }
+    }
+    return finish(true, chopLimit);
+}
+
+static bool stringToVariant(const QString& str, QVariant& value)
+{
+    if (str.startsWith('@')) {
+        if (str.endsWith(')')) {
+            if (str.startsWith("@ByteArray(")) {
+                value = QStringView(str).sliced(11).chopped(1).toLatin1();
+                return true;
+            }
+            if (str.startsWith("@String(")) {
+                value = QStringView(str).sliced(8).chopped(1).toString();
+                return true;
+            }
+            if (str == "@Invalid()") {
+                value = QVariant();
+                return true;
+            }
+            if (str.startsWith("@Variant(") || str.startsWith("@DateTime(") || str.startsWith("@Rect(") || str.startsWith("@Size(") ||
+                str.startsWith("@Point(")) {
+                return false;
+            }
+        }
+        if (str.startsWith("@@")) {
+            value = str.sliced(1);
+            return true;
+        }
+    }
+    value = str;
+    return true;
+}
+
+static bool listToVariant(QStringList list, QVariant& value)
+{
+    for (auto& str : list) {
+        if (!str.startsWith('@'))
+            continue;
+        if (str.size() >= 2 && str[1] == '@') {
+            str.remove(0, 1);
+            continue;
+        }
+        // some of the items are not plain strings
+        QVariantList variants;
+        variants.reserve(list.size());
+        for (auto& item : list) {
+            QVariant itemValue;
+            if (!stringToVariant(item, itemValue))
+                return false;
+            variants.append(itemValue);
+        }
+        value = variants;
+        return true;
+    }
+    value = list;
+    return true;
+}
+
+Status read(QByteArrayView data, QVariantMap& values)
+{
+    bool ok = true;
+    qsizetype pos = data.startsWith("\xef\xbb\xbf") ? 3 : 0;
+    qsizetype lineStart = 0;
+    qsizetype lineLen = 0;
+    qsizetype equalsPos = -1;
+    QString section;
+    QString str;
+    QStringList list;
+
+    while (readLine(data, pos, lineStart, lineLen, equalsPos)) {
+        auto line = data.sliced(lineStart, lineLen);
+        if (line.startsWith('[')) {
+            auto end = line.indexOf(']');
+            if (end == -1)
+                ok = false;
+            auto name = (end == -1 ? line.sliced(1) : line.sliced(1, end - 1)).trimmed();
+            section.clear();
+            if (name.compare("general", Qt::CaseInsensitive) == 0)
+                continue;
+            if (name.compare("%general", Qt::CaseInsensitive) == 0)
+                section = QString::fromLatin1(name.sliced(1));
+            else
+                unescapeKey(name, section);
+            section += '/';
+            continue;
+        }
+        if (equalsPos == -1) {
+            if (line[0] != ';')
+                ok = false;
+            continue;
+        }
+
+        qsizetype keyEnd = equalsPos;
+        while (keyEnd > lineStart && (data[keyEnd - 1] == ' ' || data[keyEnd - 1] == '\t'))
+            --keyEnd;
+        QString key = section;
+        unescapeKey(data.sliced(lineStart, keyEnd - lineStart), key);
+
+        str.clear();
+        list.clear();
+        QVariant value;
+        bool isList = unescapeValue(data.sliced(equalsPos + 1, lineStart + lineLen - equalsPos - 1), str, list);
+        if (!(isList ? listToVariant(list, value) : stringToVariant(str, value)))
+            return Status::Unsupported;
+        values.insert(key, value);
+    }
+    return ok ? Status::Ok : Status::FormatError;
+}
+
+/*
+ * Writing
+ */
+
+static void escapeKey(const QString& key, QByteArray& out)
+{
+    out.reserve(out.size() + key.size() * 3 / 2);
+    for (QChar qch : key) {
+        char16_t ch = qch.unicode();
+        if (ch == '/') {
+            out += '\\';
+        } else if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-' || ch == '.') {
+            out += char(ch);
+        } else if (ch <= 0xFF) {
+            out += '%';
+            out += s_hexDigits[ch / 16];
+            out += s_hexDigits[ch % 16];
+        } else {
+            out += "%U";
+            for (int shift = 12; shift >= 0; shift -= 4)
+                out += s_hexDigits[(ch >> shift) & 0xF];
+        }
+    }
+}
+
+static void escapeString(const QString& str, QByteArray& out)
+{
+    bool needsQuotes = false;
+    bool escapeNextIfDigit = false;
+    // byte arrays are kept in Latin-1, everything else is UTF-8
+    const bool utf8 = !(str.startsWith("@ByteArray(") || str.startsWith("@Variant("));
+    const qsizetype start = out.size();
+    out.reserve(start + str.size() * 3 / 2);
+
+    for (qsizetype i = 0; i < str.size(); i++) {
+        char16_t ch = str[i].unicode();
+        if (ch == ';' || ch == ',' || ch == '=')
+            needsQuotes = true;
+
+        if (escapeNextIfDigit && fromHex(ch) != -1) {
+            out += "\\x" + QByteArray::number(ch, 16);
+            continue;
+        }
+        escapeNextIfDigit = false;
+
+        switch (ch) {
+            case '\0':
+                out += "\\0";
+                escapeNextIfDigit = true;
+                break;
+            case '\a':
+                out += "\\a";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            case '\v':
+                out += "\\v";
+                break;
+            case '"':
+            case '\\':
+                out += '\\';
+                out += char(ch);
+                break;
+            default:
+                if (ch <= 0x1F || (ch >= 0x7F && !utf8)) {
+                    out += "\\x" + QByteArray::number(ch, 16);
+                    escapeNextIfDigit = true;
+                } else if (ch < 0x80) {
+                    out += char(ch);
+                } else {
+                    // copy the whole run of non-ASCII text, so surrogate pairs stay together
+                    qsizetype end = i + 1;
+                    while (end < str.size() && str[end].unicode() >= 0x80)
+                        ++end;
+                    out += QStringView(str).sliced(i, end - i).toUtf8();
+                    i = end - 1;
+                }
+        }
+    }
+
+    if (needsQuotes || (start < out.size() && (out[start] == ' ' || out.back() == ' '))) {
+        out.insert(start, '"');
+        out += '"';
+    }
+}
+
+static bool variantToString(const QVariant& value, QString& out)
+{
+    switch (value.typeId()) {
+        case QMetaType::UnknownType:
+            out = "@Invalid()";
+            return true;
+        case QMetaType::QByteArray:
+            out = "@ByteArray(" + QString::fromLatin1(value.toByteArray()) + ')';
+            return true;
+        case QMetaType::QString:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Bool:
+        case QMetaType::Float:
+        case QMetaType::Double:
+            out = value.toString();
+            if (out.contains(QChar::Null))
+                out = "@String(" + out + ')';
+            else if (out.startsWith('@'))
+                out.prepend('@');
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool writeValue(const QVariant& value, QByteArray& out)
+{
+    QString str;
+    const auto type = value.typeId();
+    if (type != QMetaType::QStringList && (type != QMetaType::QVariantList || value.toList().size() == 1)) {
+        if (!variantToString(value, str))
+            return false;
+        escapeString(str, out);
+        return true;
+    }
+
+    const auto items = value.toList();
+    if (items.isEmpty()) {
+        // an empty list reads back as an invalid value, which converts to an empty list again
+        out += "@Invalid()";
+        return true;
+    }
+    for (qsizetype i = 0; i < items.size(); i++) {
+        if (!variantToString(items[i], str))
+            return false;
+        if (i != 0)
+            out += ", ";
+        escapeString(str, out);
+    }
+    return true;
+}
+
+bool write(const QVariantMap& values, QByteArray& out)
+{
+    // everything before the first slash of a key is its section, keys without one go to [General]
+    QMap<QString, QList<QVariantMap::const_iterator>> sections;
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        auto slash = it.key().indexOf('/');
+        sections[slash == -1 ? QString() : it.key().left(slash)].append(it);
+    }
+
+    QByteArray result;
+    for (auto section = sections.constBegin(); section != sections.constEnd(); ++section) {
+        if (section != sections.constBegin())
+            result += s_eol;
+
+        QByteArray header;
+        escapeKey(section.key(), header);
+        if (header.isEmpty())
+            header = "General";
+        else if (header.compare("general", Qt::CaseInsensitive) == 0)
+            header.prepend('%');
+        result += '[' + header + ']' + s_eol;
+
+        const qsizetype prefix = section.key().isEmpty() ? 0 : section.key().size() + 1;
+        for (auto& it : section.value()) {
+            escapeKey(it.key().sliced(prefix), result);
+            result += '=';
+            if (!writeValue(it.value(), result))
+                return false;
+            result += s_eol;
+        }
+    }
+    out = std::move(result);
+    return true;
+}
+
+}  // namespace IniFormat
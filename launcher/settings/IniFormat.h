@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVariantMap>
+
+/**
+ * Reader and writer for the INI dialect of QSettings::IniFormat.
+ *
+ * Files written by either side read back the same on the other, but this works straight on the file contents
+ * instead of going through QSettings' file locking, caching and format detection. Values QSettings stores as
+ * serialized QVariants (@Variant, @DateTime, @Rect...) are not handled and have to go through QSettings.
+ */
+namespace IniFormat {
+
+enum class Status {
+    Ok,
+    FormatError,  ///< what QSettings reports as QSettings::FormatError, the readable values are still returned
+    Unsupported,  ///< a value needs QSettings to be decoded
+};
+
+Status read(QByteArrayView data, QVariantMap& values);
+
+/** Keys are written grouped by section, in the order of the map. Returns false if a value needs QSettings. */
+bool write(const QVariantMap& values, QByteArray& out);
+
+}  // namespace IniFormat
@@ -172,6 +172,10 @@ class SettingsObject : public QObject {
 
     virtual void suspendSave() = 0;
     virtual void resumeSave() = 0;
+    /*!
+     * \brief Writes changes that are still waiting to be saved.
+     */
+    virtual void flush() {}
    signals:
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings changes.
@@ -60,24 +60,14 @@ constexpr int MaxMclogsLines = 25000;
 constexpr int InitialMclogsLines = 10000;
 constexpr int FinalMclogsLines = 14900;
 
-QString truncateLogForMclogs(const QString& logContent)
-{
-    QStringList lines = logContent.split("\n");
-    if (lines.size() > MaxMclogsLines) {
-        QString truncatedLog = lines.mid(0, InitialMclogsLines).join("\n");
-        truncatedLog +=
-            "\n\n\n\n\n\n\n\n\n\n"
-            "------------------------------------------------------------\n"
-            "----------------------- Log truncated ----------------------\n"
-            "------------------------------------------------------------\n"
-            "----- Middle portion omitted to fit mclo.gs size limits ----\n"
-            "------------------------------------------------------------\n"
-            "\n\n\n\n\n\n\n\n\n\n";
-        truncatedLog += lines.mid(lines.size() - FinalMclogsLines - 1).join("\n");
-        return truncatedLog;
-    }
-    return logContent;
-}
+constexpr auto TruncationMarker =
+    "\n\n\n\n\n\n\n\n\n\n"
+    "------------------------------------------------------------\n"
+    "----------------------- Log truncated ----------------------\n"
+    "------------------------------------------------------------\n"
+    "----- Middle portion omitted to fit mclo.gs size limits ----\n"
+    "------------------------------------------------------------\n"
+    "\n\n\n\n\n\n\n\n\n\n";
 
 std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QFileInfo& filePath, QWidget* parentWidget)
 {
@@ -85,6 +75,20 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QFileInfo
 };
 
 std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString& text, QWidget* parentWidget)
+{
+    // only remember where the lines start, the upload reads them straight from the text
+    QList<qsizetype> lineStarts = { 0 };
+    for (qsizetype pos = text.indexOf('\n'); pos != -1; pos = text.indexOf('\n', pos + 1)) {
+        lineStarts.append(pos + 1);
+    }
+    auto line = [text, lineStarts](qsizetype row) {
+        auto end = row + 1 < lineStarts.size() ? lineStarts[row + 1] - 1 : text.size();
+        return text.mid(lineStarts[row], end - lineStarts[row]);
+    };
+    return uploadPaste(name, lineStarts.size(), line, parentWidget);
+}
+
+std::optional<QString> GuiUtil::uploadPaste(const QString& name, qsizetype lineCount, LogLines line, QWidget* parentWidget)
 {
     ProgressDialog dialog(parentWidget);
     auto pasteType = static_cast<PasteUpload::PasteType>(APPLICATION->settings()->get("PastebinType").toInt());
@@ -106,7 +110,7 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString&
         if (response != QMessageBox::Yes)
             return {};
 
-        if (baseURL == "https://api.mclo.gs" && text.count("\n") > MaxMclogsLines) {
+        if (baseURL == "https://api.mclo.gs" && lineCount > MaxMclogsLines) {
             auto truncateResponse = CustomMessageBox::selectable(
                                         parentWidget, QObject::tr("Confirm Truncation"),
                                         QObject::tr("The log has %1 lines, exceeding mclo.gs' limit of %2.\n"
@@ -114,7 +118,7 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString&
                                                     "If you choose 'No', mclo.gs will only keep the first %2 lines, cutting off "
                                                     "potentially useful info like crashes at the end.\n\n"
                                                     "Proceed with truncation?")
-                                            .arg(text.count("\n"))
+                                            .arg(lineCount)
                                             .arg(MaxMclogsLines)
                                             .arg(InitialMclogsLines)
                                             .arg(FinalMclogsLines),
@@ -128,14 +132,27 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString&
         }
     }
 
-    QString textToUpload = text;
-    if (shouldTruncate) {
-        textToUpload = truncateLogForMclogs(text);
-    }
+    // the lines are read again every time the request is sent, nothing but the current line is kept around
+    auto source = [lineCount, line, shouldTruncate](LogAnonymizer& anonymizer) {
+        auto write = [&anonymizer, &line](qsizetype first, qsizetype last) {
+            for (auto row = first; row < last; row++) {
+                if (row != first)
+                    anonymizer.write(u"\n");
+                anonymizer.write(line(row));
+            }
+        };
+        if (shouldTruncate) {
+            write(0, InitialMclogsLines);
+            anonymizer.write(QString::fromLatin1(TruncationMarker));
+            write(lineCount - FinalMclogsLines - 1, lineCount);
+        } else {
+            write(0, lineCount);
+        }
+    };
 
     auto job = NetJob::Ptr(new NetJob("Log Upload", APPLICATION->network()));
 
-    auto pasteJob = new PasteUpload(textToUpload, baseURL, pasteType);
+    auto pasteJob = new PasteUpload(PasteUpload::LogSource(source), baseURL, pasteType);
     job->addNetAction(Net::NetRequest::Ptr(pasteJob));
     QObject::connect(job.get(), &Task::failed, [parentWidget](QString reason) {
         CustomMessageBox::selectable(parentWidget, QObject::tr("Failed to upload logs!"), reason, QMessageBox::Critical)->show();
@@ -2,11 +2,16 @@
 
 #include <QFileInfo>
 #include <QWidget>
+#include <functional>
 #include <optional>
 
 namespace GuiUtil {
+/// the line of a log at a row, without its line break
+using LogLines = std::function<QString(qsizetype)>;
+
 std::optional<QString> uploadPaste(const QString& name, const QFileInfo& filePath, QWidget* parentWidget);
 std::optional<QString> uploadPaste(const QString& name, const QString& data, QWidget* parentWidget);
+std::optional<QString> uploadPaste(const QString& name, qsizetype lineCount, LogLines line, QWidget* parentWidget);
 void setClipboardText(QString text);
 QStringList BrowseForFiles(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
 QString BrowseForFile(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
@@ -189,6 +189,11 @@ void LauncherPage::on_metadataEnableBtn_clicked()
     ui->metadataWarningLabel->setHidden(ui->metadataEnableBtn->isChecked());
 }
 
+void LauncherPage::on_modpackUpdatePrefetchCheckBox_toggled(bool checked)
+{
+    ui->modpackUpdatePrefetchIntervalSpinBox->setEnabled(checked);
+}
+
 void LauncherPage::applySettings()
 {
     auto s = APPLICATION->settings();
@@ -205,10 +210,13 @@ void LauncherPage::applySettings()
     s->set("NumberOfConcurrentDownloads", ui->numberOfConcurrentDownloadsSpinBox->value());
     s->set("NumberOfManualRetries", ui->numberOfManualRetriesSpinBox->value());
     s->set("RequestTimeout", ui->timeoutSecondsSpinBox->value());
+    s->set("ModpackUpdatePrefetch", ui->modpackUpdatePrefetchCheckBox->isChecked());
+    s->set("ModpackUpdatePrefetchInterval", ui->modpackUpdatePrefetchIntervalSpinBox->value());
 
     // Console settings
     s->set("ConsoleMaxLines", ui->lineLimitSpinBox->value());
     s->set("ConsoleOverflowStop", ui->checkStopLogging->checkState() != Qt::Unchecked);
+    s->set("ConsoleUnlimitedScrollback", ui->unlimitedScrollbackCheckBox->isChecked());
 
     // Folders
     // TODO: Offer to move instances to new instance folder.
@@ -261,10 +269,14 @@ void LauncherPage::loadSettings()
     ui->numberOfConcurrentDownloadsSpinBox->setValue(s->get("NumberOfConcurrentDownloads").toInt());
     ui->numberOfManualRetriesSpinBox->setValue(s->get("NumberOfManualRetries").toInt());
     ui->timeoutSecondsSpinBox->setValue(s->get("RequestTimeout").toInt());
+    ui->modpackUpdatePrefetchCheckBox->setChecked(s->get("ModpackUpdatePrefetch").toBool());
+    ui->modpackUpdatePrefetchIntervalSpinBox->setValue(s->get("ModpackUpdatePrefetchInterval").toInt());
+    ui->modpackUpdatePrefetchIntervalSpinBox->setEnabled(ui->modpackUpdatePrefetchCheckBox->isChecked());
 
     // Console settings
     ui->lineLimitSpinBox->setValue(s->get("ConsoleMaxLines").toInt());
     ui->checkStopLogging->setChecked(s->get("ConsoleOverflowStop").toBool());
+    ui->unlimitedScrollbackCheckBox->setChecked(s->get("ConsoleUnlimitedScrollback").toBool());
 
     // Folders
     ui->instDirTextBox->setText(s->get("InstanceDir").toString());
@@ -75,6 +75,7 @@ class LauncherPage : public QWidget, public BasePage {
     void on_javaDirBrowseBtn_clicked();
     void on_skinsDirBrowseBtn_clicked();
     void on_metadataEnableBtn_clicked();
+    void on_modpackUpdatePrefetchCheckBox_toggled(bool checked);
 
    private:
     Ui::LauncherPage* ui;
@@ -163,6 +163,10 @@ LogPage::LogPage(BaseInstance* instance, QWidget* parent) : QWidget(parent), ui(
     connect(ui->searchBar, &QLineEdit::returnPressed, this, &LogPage::on_findButton_clicked);
     auto findPreviousShortcut = new QShortcut(QKeySequence(QKeySequence::FindPrevious), this);
     connect(findPreviousShortcut, &QShortcut::activated, this, &LogPage::findPreviousActivated);
+
+    // search the model in the background as the query changes
+    connect(ui->searchBar, &QLineEdit::textChanged, this, &LogPage::startSearch);
+    connect(ui->levelFilterBox, &QComboBox::currentIndexChanged, this, &LogPage::startSearch);
 }
 
 LogPage::~LogPage()
@@ -297,21 +301,65 @@ void LogPage::on_colorCheckbox_clicked(bool checked)
     m_model->setColorLines(checked);
 }
 
+LogSearch::Query LogPage::searchQuery() const
+{
+    LogSearch::Query query{ ui->searchBar->text(), {} };
+    switch (ui->levelFilterBox->currentIndex()) {
+        case 1:
+            query.levels = { MessageLevel::Warning, MessageLevel::Error, MessageLevel::Fatal };
+            break;
+        case 2:
+            query.levels = { MessageLevel::Error, MessageLevel::Fatal };
+            break;
+        default:
+            break;
+    }
+    return query;
+}
+
+void LogPage::startSearch()
+{
+    if (!m_model)
+        return;
+    m_model->search()->start(searchQuery());
+}
+
+void LogPage::findInLog(bool reverse)
+{
+    auto query = searchQuery();
+    if (!m_model || (query.text.isEmpty() && query.levels.isEmpty())) {
+        ui->text->findNext(query.text, reverse);
+        return;
+    }
+
+    auto search = m_model->search();
+    if (!search->isActive()) {
+        search->start(query);
+    }
+    auto row = search->nextMatch(ui->text->currentRow(), reverse);
+    if (row >= 0) {
+        ui->text->selectRow(row, query.text);
+    } else if (search->isRunning() && !query.text.isEmpty()) {
+        // nothing found yet, the scan is still going
+        ui->text->findNext(query.text, reverse);
+    }
+}
+
 void LogPage::on_findButton_clicked()
 {
     auto modifiers = QApplication::keyboardModifiers();
     bool reverse = modifiers & Qt::ShiftModifier;
-    ui->text->findNext(ui->searchBar->text(), reverse);
+    findInLog(reverse);
 }
 
 void LogPage::findNextActivated()
 {
-    ui->text->findNext(ui->searchBar->text(), false);
+    findInLog(false);
 }
 
 void LogPage::findPreviousActivated()
 {
-    ui->text->findNext(ui->searchBar->text(), true);
+    findInLog(true);
 }
 
 void LogPage::findActivated()
@@ -94,6 +94,9 @@ class LogPage : public QWidget, public BasePage {
     void modelStateToUI();
     void UIToModelState();
     void setInstanceLaunchTaskChanged(LaunchTask* proc, bool initial);
+    LogSearch::Query searchQuery() const;
+    void startSearch();
+    void findInLog(bool reverse);
 
    private:
     Ui::LogPage* ui;
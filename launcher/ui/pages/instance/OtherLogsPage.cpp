@@ -39,7 +39,9 @@
 
 #include <QMessageBox>
 
+#include "logs/LogFileModel.h"
 #include "ui/GuiUtil.h"
+#include "ui/dialogs/ProgressDialog.h"
 #include "ui/themes/ThemeManager.h"
 
 #include <FileSystem.h>
@@ -47,9 +49,17 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QFileSystemWatcher>
+#include <QListView>
 #include <QShortcut>
 #include <QUrl>
 
+namespace {
+// files above this size are not rendered into a document, but shown through LogFileModel
+constexpr qint64 LargeFileThreshold = 1024ll * 1024ll * 12ll;
+// text logs usually compress about ten times, be a bit conservative for .gz files
+constexpr qint64 LargeGzFileThreshold = LargeFileThreshold / 8;
+}  // namespace
+
 OtherLogsPage::OtherLogsPage(QString id, QString displayName, QString helpPage, BaseInstance* instance, QWidget* parent)
     : QWidget(parent)
     , m_id(id)
@@ -83,6 +93,28 @@ OtherLogsPage::OtherLogsPage(QString id, QString displayName, QString helpPage,
 
     ui->text->setModel(m_proxy);
 
+    m_largeFileModel = new LogFileModel(this);
+    m_largeFileModel->setLauncherLog(!m_instance);
+    m_largeFileProxy = new LogFormatProxyModel(this);
+    m_largeFileProxy->setFont(m_proxy->getFont());
+    m_largeFileProxy->setSourceModel(m_largeFileModel);
+    m_largeFileView = new QListView(this);
+    m_largeFileView->setUniformItemSizes(true);
+    m_largeFileView->setFont(m_proxy->getFont());
+    m_largeFileView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_largeFileView->setModel(m_largeFileProxy);
+    m_largeFileView->hide();
+    ui->gridLayout_2->addWidget(m_largeFileView, 1, 0, 1, 5);
+
+    connect(m_largeFileModel, &LogFileModel::loaded, this, [this] {
+        m_largeFileView->scrollToBottom();
+        setControlsEnabled(true);
+    });
+    connect(m_largeFileModel, &LogFileModel::loadFailed, this, [this](QString error) {
+        setLargeFileMode(false);
+        ui->text->setPlainText(tr("The file (%1) encountered an error when reading: %2.").arg(m_currentFile, error));
+    });
+
     if (m_instance) {
         m_model->setMaxLines(getConsoleMaxLines(m_instance->settings()));
         m_model->setStopOnOverflow(shouldStopOnConsoleOverflow(m_instance->settings()));
@@ -215,6 +247,7 @@ void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
 
     if ((index != 0 || m_instance) && (file.isEmpty() || !QFile::exists(FS::PathCombine(m_basePath, file)))) {
         m_currentFile = QString();
+        setLargeFileMode(false);
         ui->text->clear();
         setControlsEnabled(false);
     } else {
@@ -240,6 +273,7 @@ void OtherLogsPage::on_btnReload_clicked()
 void OtherLogsPage::reload()
 {
     if (m_currentFile.isEmpty()) {
+        setLargeFileMode(false);
         if (m_instance) {
             setControlsEnabled(false);
         } else {
@@ -254,6 +288,15 @@ void OtherLogsPage::reload()
     }
 
     QFile file(FS::PathCombine(m_basePath, m_currentFile));
+    if (file.size() > (file.fileName().endsWith(".gz") ? LargeGzFileThreshold : LargeFileThreshold)) {
+        // index the file in the background and only read the lines that are shown
+        setLargeFileMode(true);
+        setControlsEnabled(false);
+        m_largeFileModel->load(file.fileName());
+        return;
+    }
+    setLargeFileMode(false);
+
     if (!file.open(QFile::ReadOnly)) {
         setControlsEnabled(false);
         ui->btnReload->setEnabled(true);  // allow reload
@@ -265,15 +308,6 @@ void OtherLogsPage::reload()
             doc->setDefaultFont(m_proxy->getFont());
             ui->text->setPlainText(text);
         };
-        auto showTooBig = [setPlainText, &file]() {
-            setPlainText(tr("The file (%1) is too big. You may want to open it in a viewer optimized "
-                            "for large files.")
-                             .arg(file.fileName()));
-        };
-        if (file.size() > (1024ll * 1024ll * 12ll)) {
-            showTooBig();
-            return;
-        }
         MessageLevel last = MessageLevel::Unknown;
 
         auto handleLine = [this, &last](QString line) {
@@ -347,19 +381,75 @@ void OtherLogsPage::reload()
     }
 }
 
+void OtherLogsPage::setLargeFileMode(bool enabled)
+{
+    m_largeFileMode = enabled;
+    m_largeFileView->setVisible(enabled);
+    ui->text->setVisible(!enabled);
+    // the list view shows one line per row, always colored
+    ui->wrapCheckbox->setEnabled(!enabled);
+    ui->colorCheckbox->setEnabled(!enabled);
+    if (enabled) {
+        ui->text->clear();
+    }
+}
+
+void OtherLogsPage::findInLargeFile(const QString& what, bool reverse)
+{
+    if (what.isEmpty() || m_largeFileModel->isLoading())
+        return;
+    auto start = m_largeFileProxy->mapToSource(m_largeFileView->currentIndex());
+    auto task = m_largeFileModel->find(what, start, reverse);
+    if (!task)
+        return;
+    task->setStatus(tr("Searching %1...").arg(m_currentFile));
+    ProgressDialog progress(this);
+    progress.setSkipButton(true, tr("Abort"));
+    if (progress.execWithTask(task.get()) != QDialog::Accepted)
+        return;
+    auto row = task->result().value<qsizetype>();
+    if (row < 0 || row >= m_largeFileModel->rowCount())
+        return;
+    auto index = m_largeFileProxy->mapFromSource(m_largeFileModel->index(static_cast<int>(row)));
+    m_largeFileView->setCurrentIndex(index);
+    m_largeFileView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
+
 void OtherLogsPage::on_btnPaste_clicked()
 {
     QString name = m_currentFile.isEmpty() ? displayName() : m_currentFile;
+    if (m_largeFileMode) {
+        // read the lines from the file while uploading instead of putting all of it into one string
+        auto model = m_largeFileModel;
+        auto line = [model](qsizetype row) { return model->data(model->index(static_cast<int>(row)), Qt::DisplayRole).toString(); };
+        GuiUtil::uploadPaste(name, model->rowCount(), line, this);
+        return;
+    }
     GuiUtil::uploadPaste(name, ui->text->toPlainText(), this);
 }
 
 void OtherLogsPage::on_btnCopy_clicked()
 {
-    GuiUtil::setClipboardText(ui->text->toPlainText());
+    if (!m_largeFileMode) {
+        GuiUtil::setClipboardText(ui->text->toPlainText());
+        return;
+    }
+    auto task = m_largeFileModel->readText();
+    if (!task)
+        return;
+    task->setStatus(tr("Reading %1...").arg(m_currentFile));
+    ProgressDialog progress(this);
+    progress.setSkipButton(true, tr("Abort"));
+    if (progress.execWithTask(task.get()) == QDialog::Accepted)
+        GuiUtil::setClipboardText(task->result().toString());
 }
 
 void OtherLogsPage::on_btnBottom_clicked()
 {
+    if (m_largeFileMode) {
+        m_largeFileView->scrollToBottom();
+        return;
+    }
     ui->text->scrollToBottom();
 }
 
@@ -489,6 +579,7 @@ void OtherLogsPage::setControlsEnabled(const bool enabled)
     ui->btnCopy->setEnabled(enabled);
     ui->btnPaste->setEnabled(enabled);
     ui->text->setEnabled(enabled);
+    m_largeFileView->setEnabled(enabled);
 }
 
 QStringList OtherLogsPage::getPaths()
@@ -518,16 +609,28 @@ void OtherLogsPage::on_findButton_clicked()
 {
     auto modifiers = QApplication::keyboardModifiers();
     bool reverse = modifiers & Qt::ShiftModifier;
+    if (m_largeFileMode) {
+        findInLargeFile(ui->searchBar->text(), reverse);
+        return;
+    }
     ui->text->findNext(ui->searchBar->text(), reverse);
 }
 
 void OtherLogsPage::findNextActivated()
 {
+    if (m_largeFileMode) {
+        findInLargeFile(ui->searchBar->text(), false);
+        return;
+    }
     ui->text->findNext(ui->searchBar->text(), false);
 }
 
 void OtherLogsPage::findPreviousActivated()
 {
+    if (m_largeFileMode) {
+        findInLargeFile(ui->searchBar->text(), true);
+        return;
+    }
     ui->text->findNext(ui->searchBar->text(), true);
 }
 
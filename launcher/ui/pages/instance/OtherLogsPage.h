@@ -47,6 +47,8 @@ class OtherLogsPage;
 }
 
 class RecursiveFileSystemWatcher;
+class LogFileModel;
+class QListView;
 
 class OtherLogsPage : public QWidget, public BasePage {
     Q_OBJECT
@@ -88,6 +90,8 @@ class OtherLogsPage : public QWidget, public BasePage {
     void modelStateToUI();
     void UIToModelState();
     void setControlsEnabled(bool enabled);
+    void setLargeFileMode(bool enabled);
+    void findInLargeFile(const QString& what, bool reverse);
 
     QStringList getPaths();
 
@@ -106,4 +110,10 @@ class OtherLogsPage : public QWidget, public BasePage {
 
     LogFormatProxyModel* m_proxy;
     LogModel* m_model;
+
+    // large files are shown through a lazily populated list instead of the text document
+    bool m_largeFileMode = false;
+    QListView* m_largeFileView;
+    LogFormatProxyModel* m_largeFileProxy;
+    LogFileModel* m_largeFileModel;
 };
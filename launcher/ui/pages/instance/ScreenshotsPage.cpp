@@ -49,7 +49,6 @@
 #include <QMenu>
 #include <QModelIndex>
 #include <QMutableListIterator>
-#include <QPainter>
 #include <QRegularExpression>
 #include <QSet>
 #include <QStyledItemDelegate>
@@ -66,83 +65,17 @@
 
 #include <DesktopServices.h>
 #include <FileSystem.h>
-#include "RWStorage.h"
-
-using SharedIconCache = RWStorage<QString, QIcon>;
-using SharedIconCachePtr = std::shared_ptr<SharedIconCache>;
-
-class ThumbnailingResult : public QObject {
-    Q_OBJECT
-   public slots:
-    inline void emitResultsReady(const QString& path) { emit resultsReady(path); }
-    inline void emitResultsFailed(const QString& path) { emit resultsFailed(path); }
-   signals:
-    void resultsReady(const QString& path);
-    void resultsFailed(const QString& path);
-};
-
-class ThumbnailRunnable : public QRunnable {
-   public:
-    ThumbnailRunnable(QString path, SharedIconCachePtr cache)
-    {
-        m_path = path;
-        m_cache = cache;
-    }
-    void run()
-    {
-        QFileInfo info(m_path);
-        if (info.isDir())
-            return;
-        if ((info.suffix().compare("png", Qt::CaseInsensitive) != 0))
-            return;
-        if (!m_cache->stale(m_path))
-            return;
-        QImage image(m_path);
-        if (image.isNull()) {
-            m_resultEmitter.emitResultsFailed(m_path);
-            qDebug() << "Error loading screenshot (perhaps too large?):" + m_path;
-            return;
-        }
-        QImage small;
-        if (image.width() > image.height())
-            small = image.scaledToWidth(512).scaledToWidth(256, Qt::SmoothTransformation);
-        else
-            small = image.scaledToHeight(512).scaledToHeight(256, Qt::SmoothTransformation);
-        QPoint offset((256 - small.width()) / 2, (256 - small.height()) / 2);
-        QImage square(QSize(256, 256), QImage::Format_ARGB32);
-        square.fill(Qt::transparent);
-
-        QPainter painter(&square);
-        painter.drawImage(offset, small);
-        painter.end();
-
-        QIcon icon(QPixmap::fromImage(square));
-        m_cache->add(m_path, icon);
-        m_resultEmitter.emitResultsReady(m_path);
-    }
-    QString m_path;
-    SharedIconCachePtr m_cache;
-    ThumbnailingResult m_resultEmitter;
-};
+#include "ImageCache.h"
 
 // this is about as elegant and well written as a bag of bricks with scribbles done by insane
 // asylum patients.
 class FilterModel : public QIdentityProxyModel {
     Q_OBJECT
    public:
-    explicit FilterModel(QObject* parent = 0) : QIdentityProxyModel(parent)
+    explicit FilterModel(QObject* parent = 0) : QIdentityProxyModel(parent), m_placeholder(QIcon::fromTheme("screenshot-placeholder"))
     {
-        m_thumbnailingPool.setMaxThreadCount(4);
-        m_thumbnailCache = std::make_shared<SharedIconCache>();
-        m_thumbnailCache->add("placeholder", QIcon::fromTheme("screenshot-placeholder"));
         connect(&watcher, &QFileSystemWatcher::fileChanged, this, &FilterModel::fileChanged);
     }
-    virtual ~FilterModel()
-    {
-        m_thumbnailingPool.clear();
-        if (!m_thumbnailingPool.waitForDone(500))
-            qDebug() << "Thumbnail pool took longer than 500ms to finish";
-    }
     virtual QVariant data(const QModelIndex& proxyIndex, int role = Qt::DisplayRole) const
     {
         auto model = sourceModel();
@@ -156,18 +89,17 @@ class FilterModel : public QIdentityProxyModel {
         if (role == Qt::DecorationRole) {
             QVariant result = sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole);
             QString filePath = result.toString();
-            QIcon temp;
             if (!watched.contains(filePath)) {
                 ((QFileSystemWatcher&)watcher).addPath(filePath);
                 ((QSet<QString>&)watched).insert(filePath);
             }
-            if (m_thumbnailCache->get(filePath, temp)) {
-                return temp;
+            if (auto thumbnail = APPLICATION->imageCache()->find(filePath, s_thumbnailSize, true)) {
+                return QIcon(*thumbnail);
             }
-            if (!m_failed.contains(filePath)) {
+            if (!m_failed.contains(filePath) && !m_thumbnailing.contains(filePath)) {
                 ((FilterModel*)this)->thumbnailImage(filePath);
             }
-            return (m_thumbnailCache->get("placeholder"));
+            return m_placeholder;
         }
         return sourceModel()->data(mapToSource(proxyIndex), role);
     }
@@ -190,17 +122,25 @@ class FilterModel : public QIdentityProxyModel {
    private:
     void thumbnailImage(QString path)
     {
-        auto runnable = new ThumbnailRunnable(path, m_thumbnailCache);
-        connect(&runnable->m_resultEmitter, &ThumbnailingResult::resultsReady, this, &FilterModel::thumbnailReady);
-        connect(&runnable->m_resultEmitter, &ThumbnailingResult::resultsFailed, this, &FilterModel::thumbnailFailed);
-        m_thumbnailingPool.start(runnable);
+        m_thumbnailing.insert(path);
+        APPLICATION->imageCache()->load(
+            path, path, s_thumbnailSize, this,
+            [this, path](const QPixmap& thumbnail) {
+                m_thumbnailing.remove(path);
+                if (thumbnail.isNull()) {
+                    qDebug() << "Error loading screenshot (perhaps too large?):" + path;
+                    m_failed.insert(path);
+                    return;
+                }
+                emit layoutChanged();
+            },
+            true);
     }
    private slots:
-    void thumbnailReady(QString path) { emit layoutChanged(); }
-    void thumbnailFailed(QString path) { m_failed.insert(path); }
     void fileChanged(QString filepath)
     {
-        m_thumbnailCache->setStale(filepath);
+        APPLICATION->imageCache()->remove(filepath, s_thumbnailSize, true);
+        m_failed.remove(filepath);
         // reinsert the path...
         watcher.removePath(filepath);
         if (QFile::exists(filepath)) {
@@ -210,8 +150,10 @@ class FilterModel : public QIdentityProxyModel {
     }
 
    private:
-    SharedIconCachePtr m_thumbnailCache;
-    QThreadPool m_thumbnailingPool;
+    static constexpr QSize s_thumbnailSize{ 256, 256 };
+
+    QIcon m_placeholder;
+    QSet<QString> m_thumbnailing;
     QSet<QString> m_failed;
     QSet<QString> watched;
     QFileSystemWatcher watcher;
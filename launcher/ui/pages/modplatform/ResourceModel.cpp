@@ -8,13 +8,13 @@
 #include <QIcon>
 #include <QList>
 #include <QMessageBox>
-#include <QPixmapCache>
 #include <QUrl>
 #include <algorithm>
 #include <memory>
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "ImageCache.h"
 
 #include "modplatform/ResourceAPI.h"
 #include "net/ApiDownload.h"
@@ -61,8 +61,7 @@ auto ResourceModel::data(const QModelIndex& index, int role) const -> QVariant
         }
         case Qt::DecorationRole: {
             if (APPLICATION_DYN) {
-                if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(const_cast<QModelIndex&>(index), pack->logoUrl);
-                    icon_or_none.has_value())
+                if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(pack->logoUrl); icon_or_none.has_value())
                     return icon_or_none.value();
 
                 return QIcon::fromTheme("screenshot-placeholder");
@@ -272,6 +271,9 @@ void ResourceModel::refresh()
 
 void ResourceModel::clearData()
 {
+    if (m_prefetch_icon_job && m_prefetch_icon_job->isRunning())
+        m_prefetch_icon_job->abort();
+
     beginResetModel();
     m_packs.clear();
     endResetModel();
@@ -308,48 +310,95 @@ std::optional<ResourceAPI::SortingMethod> ResourceModel::getCurrentSortingMethod
     return sort;
 }
 
-std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
+void ResourceModel::prefetchNextPage(int row)
 {
-    QPixmap pixmap;
-    if (QPixmapCache::find(url.toString(), &pixmap))
-        return { pixmap };
+    // how close to the end of the list the view has to get for the next page to be fetched
+    static const int s_prefetch_rows = 10;
 
-    if (!m_current_icon_job) {
-        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
-        m_current_icon_job->setAskRetry(false);
-    }
+    if (row < m_packs.size() - s_prefetch_rows || m_search_state != SearchState::CanFetchMore || hasActiveSearchJob())
+        return;
+
+    fetchMore({});
+}
+
+std::optional<QIcon> ResourceModel::getIcon(const QUrl& url)
+{
+    if (auto pixmap = APPLICATION->imageCache()->find(url.toString(), ImageCache::s_logoSize))
+        return QIcon(*pixmap);
 
     if (m_currently_running_icon_actions.contains(url))
         return {};
     if (m_failed_icon_actions.contains(url))
         return {};
 
+    if (!m_current_icon_job) {
+        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
+        m_current_icon_job->setAskRetry(false);
+    }
+
+    m_current_icon_job->addNetAction(makeIconAction(url));
+    if (!m_current_icon_job->isRunning())
+        QMetaObject::invokeMethod(m_current_icon_job.get(), &NetJob::start);
+
+    return {};
+}
+
+void ResourceModel::prefetchIcons(const QList<ModPlatform::IndexedPack::Ptr>& packs)
+{
+    if (!APPLICATION_DYN)
+        return;
+
+    if (!m_prefetch_icon_job) {
+        // a couple at a time, so the icons of the entries being shown come first
+        m_prefetch_icon_job.reset(new NetJob("IconPrefetchJob", APPLICATION->network(), 2));
+        m_prefetch_icon_job->setAskRetry(false);
+    }
+
+    for (auto& pack : packs) {
+        auto url = QUrl(pack->logoUrl);
+        if (url.isEmpty() || APPLICATION->imageCache()->find(url.toString(), ImageCache::s_logoSize) ||
+            m_currently_running_icon_actions.contains(url) || m_failed_icon_actions.contains(url))
+            continue;
+        m_prefetch_icon_job->addNetAction(makeIconAction(url));
+    }
+
+    if (!m_prefetch_icon_job->isRunning())
+        QMetaObject::invokeMethod(m_prefetch_icon_job.get(), &NetJob::start);
+}
+
+Net::NetRequest::Ptr ResourceModel::makeIconAction(const QUrl& url)
+{
     auto cache_entry = APPLICATION->metacache()->resolveEntry(
         metaEntryBase(),
         QString("logos/%1").arg(QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex())));
     auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
+    // behind the search and info requests
+    icon_fetch_action->setPriority(QNetworkRequest::LowPriority);
 
     auto full_file_path = cache_entry->getFullPath();
-    connect(icon_fetch_action.get(), &Task::succeeded, this, [this, url, full_file_path, index] {
-        auto icon = QIcon(full_file_path);
-        QPixmapCache::insert(url.toString(), icon.pixmap(icon.actualSize({ 64, 64 })));
-
-        m_currently_running_icon_actions.remove(url);
+    connect(icon_fetch_action.get(), &Task::succeeded, this, [this, url, full_file_path] {
+        APPLICATION->imageCache()->load(url.toString(), full_file_path, ImageCache::s_logoSize, this, [this, url](const QPixmap& pixmap) {
+            m_currently_running_icon_actions.remove(url);
+            if (pixmap.isNull()) {
+                m_failed_icon_actions.insert(url);
+                return;
+            }
 
-        emit dataChanged(index, index, { Qt::DecorationRole });
+            for (int row = 0; row < m_packs.size(); row++) {
+                if (QUrl(m_packs[row]->logoUrl) == url)
+                    emit dataChanged(index(row), index(row), { Qt::DecorationRole });
+            }
+        });
     });
     connect(icon_fetch_action.get(), &Task::failed, this, [this, url] {
         m_currently_running_icon_actions.remove(url);
         m_failed_icon_actions.insert(url);
     });
+    connect(icon_fetch_action.get(), &Task::aborted, this, [this, url] { m_currently_running_icon_actions.remove(url); });
 
     m_currently_running_icon_actions.insert(url);
 
-    m_current_icon_job->addNetAction(icon_fetch_action);
-    if (!m_current_icon_job->isRunning())
-        QMetaObject::invokeMethod(m_current_icon_job.get(), &NetJob::start);
-
-    return {};
+    return icon_fetch_action;
 }
 
 /* Default callbacks */
@@ -385,9 +434,15 @@ void ResourceModel::searchRequestSucceeded(QList<ModPlatform::IndexedPack::Ptr>&
     if (filteredNewList.size() == 0)
         return;
 
+    // past the first page this was prefetched, so the view is not showing these yet
+    bool prefetched = !m_packs.isEmpty();
+
     beginInsertRows(QModelIndex(), m_packs.size(), m_packs.size() + filteredNewList.size() - 1);
     m_packs.append(filteredNewList);
     endInsertRows();
+
+    if (prefetched)
+        prefetchIcons(filteredNewList);
 }
 
 void ResourceModel::searchRequestForOneSucceeded(ModPlatform::IndexedPack::Ptr pack)
@@ -88,8 +88,11 @@ class ResourceModel : public QAbstractListModel {
     /** Schedule a refresh, clearing the current state. */
     void refresh();
 
-    /** Gets the icon at the URL for the given index. If it's not fetched yet, fetch it and update when fisinhed. */
-    std::optional<QIcon> getIcon(QModelIndex&, const QUrl&);
+    /** Starts fetching the next page if the entry at 'row' is close to the end of the list. */
+    void prefetchNextPage(int row);
+
+    /** Gets the icon at the URL. If it's not fetched yet, fetch it and update the entries using it when finished. */
+    std::optional<QIcon> getIcon(const QUrl&);
 
     void addPack(ModPlatform::IndexedPack::Ptr pack,
                  ModPlatform::IndexedVersion& version,
@@ -124,6 +127,8 @@ class ResourceModel : public QAbstractListModel {
     ConcurrentTask m_current_info_job;
 
     shared_qobject_ptr<NetJob> m_current_icon_job;
+    // Job for fetching the icons of entries that were not shown yet, behind the ones being shown
+    shared_qobject_ptr<NetJob> m_prefetch_icon_job;
     QSet<QUrl> m_currently_running_icon_actions;
     QSet<QUrl> m_failed_icon_actions;
 
@@ -135,6 +140,9 @@ class ResourceModel : public QAbstractListModel {
     static QHash<ResourceModel*, bool> s_running_models;
 
    private:
+    void prefetchIcons(const QList<ModPlatform::IndexedPack::Ptr>& packs);
+    Net::NetRequest::Ptr makeIconAction(const QUrl& url);
+
     /* Default search request callbacks */
     void searchRequestSucceeded(QList<ModPlatform::IndexedPack::Ptr>&);
     void searchRequestForOneSucceeded(ModPlatform::IndexedPack::Ptr);
@@ -45,6 +45,7 @@
 #include <StringUtils.h>
 #include <QDesktopServices>
 #include <QKeyEvent>
+#include <QScrollBar>
 
 #include "Markdown.h"
 
@@ -69,6 +70,8 @@ ResourcePage::ResourcePage(ResourceDownloadDialog* parent, BaseInstance& base_in
     m_searchTimer.setSingleShot(true);
 
     connect(&m_searchTimer, &QTimer::timeout, this, &ResourcePage::triggerSearch);
+    // search once the user stops typing, moving the cursor around does not change the search
+    connect(m_ui->searchEdit, &QLineEdit::textEdited, this, [this] { m_searchTimer.start(350); });
 
     // hide progress bar to prevent weird artifact
     m_fetchProgress.hide();
@@ -87,6 +90,7 @@ ResourcePage::ResourcePage(ResourceDownloadDialog* parent, BaseInstance& base_in
 
     connect(m_ui->packView, &QAbstractItemView::doubleClicked, this, &ResourcePage::onResourceToggle);
     connect(delegate, &ProjectItemDelegate::checkboxClicked, this, &ResourcePage::onResourceToggle);
+    connect(m_ui->packView->verticalScrollBar(), &QScrollBar::valueChanged, this, &ResourcePage::prefetchNextPage);
 }
 
 ResourcePage::~ResourcePage()
@@ -117,20 +121,27 @@ void ResourcePage::openedImpl()
     m_ui->searchEdit->setFocus();
 }
 
+void ResourcePage::prefetchNextPage()
+{
+    if (!m_model)
+        return;
+
+    auto viewport = m_ui->packView->viewport();
+    auto last = m_ui->packView->indexAt({ viewport->width() / 2, viewport->height() - 1 });
+    // below the last entry
+    m_model->prefetchNextPage(last.isValid() ? last.row() : m_model->rowCount({}) - 1);
+}
+
 auto ResourcePage::eventFilter(QObject* watched, QEvent* event) -> bool
 {
     if (event->type() == QEvent::KeyPress) {
         auto* keyEvent = static_cast<QKeyEvent*>(event);
         if (watched == m_ui->searchEdit) {
             if (keyEvent->key() == Qt::Key_Return) {
+                m_searchTimer.stop();
                 triggerSearch();
                 keyEvent->accept();
                 return true;
-            } else {
-                if (m_searchTimer.isActive())
-                    m_searchTimer.stop();
-
-                m_searchTimer.start(350);
             }
         } else if (watched == m_ui->packView) {
             // stop the event from going to the confirm button
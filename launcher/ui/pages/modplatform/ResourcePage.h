@@ -94,6 +94,8 @@ class ResourcePage : public QWidget, public BasePage {
     void onVersionSelectionChanged(int index);
     void onResourceSelected();
     void onResourceToggle(const QModelIndex& index);
+    /** Fetches the next page before the view gets to the end of the list. */
+    void prefetchNextPage();
 
     /** Associates regex expressions to pages in the order they're given in the map. */
     virtual QMap<QString, QString> urlHandlers() const = 0;
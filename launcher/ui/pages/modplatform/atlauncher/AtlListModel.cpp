@@ -19,6 +19,7 @@
 #include <Application.h>
 #include <BuildConfig.h>
 #include <Json.h>
+#include "ImageCache.h"
 
 #include "net/ApiDownload.h"
 #include "ui/widgets/ProjectItem.h"
@@ -199,7 +200,12 @@ void ListModel::requestLogo(QString file, QString url)
     auto fullPath = entry->getFullPath();
     connect(job, &NetJob::succeeded, this, [this, file, fullPath, job] {
         job->deleteLater();
-        emit logoLoaded(file, QIcon(fullPath));
+        APPLICATION->imageCache()->load(fullPath, fullPath, ImageCache::s_logoSize, this, [this, file](const QPixmap& pixmap) {
+            if (pixmap.isNull())
+                emit logoFailed(file);
+            else
+                emit logoLoaded(file, QIcon(pixmap));
+        });
         if (waitingCallbacks.contains(file)) {
             waitingCallbacks.value(file)(fullPath);
         }
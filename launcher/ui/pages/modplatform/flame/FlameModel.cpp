@@ -1,6 +1,7 @@
 #include "FlameModel.h"
 #include <Json.h>
 #include "Application.h"
+#include "ImageCache.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/flame/FlameAPI.h"
@@ -116,7 +117,12 @@ void ListModel::requestLogo(QString logo, QString url)
     auto fullPath = entry->getFullPath();
     connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
         job->deleteLater();
-        emit logoLoaded(logo, QIcon(fullPath));
+        APPLICATION->imageCache()->load(fullPath, fullPath, ImageCache::s_logoSize, this, [this, logo](const QPixmap& pixmap) {
+            if (pixmap.isNull())
+                emit logoFailed(logo);
+            else
+                emit logoLoaded(logo, QIcon(pixmap));
+        });
         if (m_waitingCallbacks.contains(logo)) {
             m_waitingCallbacks.value(logo)(fullPath);
         }
@@ -18,6 +18,7 @@
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "ImageCache.h"
 #include "Json.h"
 
 #include <QPainter>
@@ -209,12 +210,21 @@ void ListModel::logoLoaded(QString logo)
 {
     auto& logoObj = m_logoMap[logo];
     logoObj.downloadJob.reset();
-    logoObj.result = QIcon(logoObj.fullpath);
-    for (int i = 0; i < m_modpacks.size(); i++) {
-        if (m_modpacks[i].safeName == logo) {
-            emit dataChanged(createIndex(i, 0), createIndex(i, 0), { Qt::DecorationRole });
+    APPLICATION->imageCache()->load(logoObj.fullpath, logoObj.fullpath, ImageCache::s_logoSize, this, [this, logo](const QPixmap& pixmap) {
+        auto iter = m_logoMap.find(logo);
+        if (iter == m_logoMap.end())
+            return;
+        if (pixmap.isNull()) {
+            iter->failed = true;
+            return;
         }
-    }
+        iter->result = QIcon(pixmap);
+        for (int i = 0; i < m_modpacks.size(); i++) {
+            if (m_modpacks[i].safeName == logo) {
+                emit dataChanged(createIndex(i, 0), createIndex(i, 0), { Qt::DecorationRole });
+            }
+        }
+    });
 }
 
 void ListModel::logoFailed(QString logo)
@@ -35,6 +35,7 @@
 
 #include "ListModel.h"
 #include "Application.h"
+#include "ImageCache.h"
 #include "net/ApiDownload.h"
 #include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
@@ -274,7 +275,12 @@ void ListModel::requestLogo(QString file)
     auto fullPath = entry->getFullPath();
     connect(job, &NetJob::finished, this, [this, file, fullPath, job] {
         job->deleteLater();
-        emit logoLoaded(file, QIcon(fullPath));
+        APPLICATION->imageCache()->load(fullPath, fullPath, ImageCache::s_logoSize, this, [this, file](const QPixmap& pixmap) {
+            if (pixmap.isNull())
+                emit logoFailed(file);
+            else
+                emit logoLoaded(file, QIcon(pixmap));
+        });
         if (waitingCallbacks.contains(file)) {
             waitingCallbacks.value(file)(fullPath);
         }
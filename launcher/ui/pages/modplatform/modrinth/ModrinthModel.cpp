@@ -38,6 +38,7 @@
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "ImageCache.h"
 #include "Json.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
@@ -253,7 +254,12 @@ void ModpackListModel::requestLogo(QString logo, QString url)
     auto fullPath = entry->getFullPath();
     connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
         job->deleteLater();
-        emit logoLoaded(logo, QIcon(fullPath));
+        APPLICATION->imageCache()->load(fullPath, fullPath, ImageCache::s_logoSize, this, [this, logo](const QPixmap& pixmap) {
+            if (pixmap.isNull())
+                emit logoFailed(logo);
+            else
+                emit logoLoaded(logo, QIcon(pixmap));
+        });
         if (m_waitingCallbacks.contains(logo)) {
             m_waitingCallbacks.value(logo)(fullPath);
         }
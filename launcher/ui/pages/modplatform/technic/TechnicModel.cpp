@@ -36,6 +36,7 @@
 #include "TechnicModel.h"
 #include "Application.h"
 #include "BuildConfig.h"
+#include "ImageCache.h"
 #include "Json.h"
 
 #include "net/ApiDownload.h"
@@ -269,10 +270,10 @@ void Technic::ListModel::searchRequestFailed()
     }
 }
 
-void Technic::ListModel::logoLoaded(QString logo, QString out)
+void Technic::ListModel::logoLoaded(QString logo, QIcon out)
 {
     m_loadingLogos.removeAll(logo);
-    m_logoMap.insert(logo, QIcon(out));
+    m_logoMap.insert(logo, out);
     for (int i = 0; i < modpacks.size(); i++) {
         if (modpacks[i].logoName == logo) {
             emit dataChanged(createIndex(i, 0), createIndex(i, 0), { Qt::DecorationRole });
@@ -301,7 +302,12 @@ void Technic::ListModel::requestLogo(QString logo, QString url)
 
     connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
         job->deleteLater();
-        logoLoaded(logo, fullPath);
+        APPLICATION->imageCache()->load(fullPath, fullPath, ImageCache::s_logoSize, this, [this, logo](const QPixmap& pixmap) {
+            if (pixmap.isNull())
+                logoFailed(logo);
+            else
+                logoLoaded(logo, QIcon(pixmap));
+        });
     });
 
     connect(job, &NetJob::failed, this, [this, logo, job] {
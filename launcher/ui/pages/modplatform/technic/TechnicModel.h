@@ -66,7 +66,7 @@ class ListModel : public QAbstractListModel {
     void searchRequestFailed();
 
     void logoFailed(QString logo);
-    void logoLoaded(QString logo, QString out);
+    void logoLoaded(QString logo, QIcon out);
 
    private:
     void performSearch();
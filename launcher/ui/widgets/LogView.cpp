@@ -38,11 +38,21 @@
 #include <QTextBlock>
 #include <QTextDocumentFragment>
 
+#include <algorithm>
+
+namespace {
+// rows loaded at once when the view is filled or scrolled to the top
+constexpr int s_loadRows = 10000;
+// rows kept in the document while the view follows the end of the log
+constexpr int s_maxRows = 100000;
+}  // namespace
+
 LogView::LogView(QWidget* parent) : QPlainTextEdit(parent)
 {
     setWordWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
     m_defaultFormat = new QTextCharFormat(currentCharFormat());
     setUndoRedoEnabled(false);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &LogView::scrolled);
 }
 
 LogView::~LogView()
@@ -104,10 +114,19 @@ void LogView::repopulate()
 {
     auto doc = document();
     doc->clear();
+    m_firstRow = 0;
+    m_rowBlocks.clear();
+    m_blockBase = 0;
     if (!m_model) {
         return;
     }
-    rowsInserted(QModelIndex(), 0, m_model->rowCount() - 1);
+    // with an on-disk scrollback there may be millions of rows, the older ones are loaded when scrolled to
+    m_firstRow = std::max(0, m_model->rowCount() - s_loadRows);
+    if (m_firstRow > 0) {
+        // start at the end, that is what was loaded
+        m_scroll = true;
+    }
+    rowsInserted(QModelIndex(), m_firstRow, m_model->rowCount() - 1);
 }
 
 void LogView::rowsAboutToBeInserted(const QModelIndex& parent, int first, int last)
@@ -125,7 +144,7 @@ void LogView::rowsAboutToBeInserted(const QModelIndex& parent, int first, int la
     }
 }
 
-void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
+QTextDocumentFragment LogView::rowsFragment(int first, int last, QList<int>& rowBlocks) const
 {
     QTextDocument document;
     QTextCursor cursor(&document);
@@ -133,7 +152,7 @@ void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
     cursor.movePosition(QTextCursor::End);
     cursor.beginEditBlock();
     for (int i = first; i <= last; i++) {
-        auto idx = m_model->index(i, 0, parent);
+        auto idx = m_model->index(i, 0);
         auto text = m_model->data(idx, Qt::DisplayRole).toString();
         QTextCharFormat format(*m_defaultFormat);
         auto font = m_model->data(idx, Qt::FontRole);
@@ -148,16 +167,40 @@ void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
         if (bg.isValid() && m_colorLines) {
             format.setBackground(bg.value<QColor>());
         }
+        // a line may span several blocks, it has line breaks of its own
+        rowBlocks.append(cursor.blockNumber());
         cursor.insertText(text, format);
         cursor.insertBlock();
     }
+    rowBlocks.append(cursor.blockNumber());
     cursor.endEditBlock();
 
-    QTextDocumentFragment fragment(&document);
+    return QTextDocumentFragment(&document);
+}
+
+void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent)
+    QList<int> rowBlocks;
+    auto fragment = rowsFragment(first, last, rowBlocks);
+    // the first block of the fragment goes into the empty block at the end of the document
+    auto base = document()->blockCount() - 1 + m_blockBase;
+    for (int i = 0; i < rowBlocks.size() - 1; i++) {
+        m_rowBlocks.append(base + rowBlocks[i]);
+    }
+
     QTextCursor workCursor = textCursor();
     workCursor.movePosition(QTextCursor::End);
     workCursor.insertFragment(fragment);
 
+    if (m_scroll) {
+        // while following the log, the lines far above are let go of, they are loaded again when scrolled to
+        auto excess = m_model->rowCount() - m_firstRow - s_maxRows;
+        if (excess > 0) {
+            removeDocumentRows(0, excess);
+            m_firstRow += excess;
+        }
+    }
     if (m_scroll && !m_scrolling) {
         m_scrolling = true;
         QMetaObject::invokeMethod(this, "scrollToBottom", Qt::QueuedConnection);
@@ -166,10 +209,112 @@ void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
 
 void LogView::rowsRemoved(const QModelIndex& parent, int first, int last)
 {
-    // TODO: some day... maybe
     Q_UNUSED(parent)
-    Q_UNUSED(first)
-    Q_UNUSED(last)
+    auto count = last - first + 1;
+    // removed rows that were not loaded only move the document
+    auto before = std::min(last + 1, m_firstRow) - std::min(first, m_firstRow);
+    if (count > before) {
+        removeDocumentRows(std::max(first, m_firstRow) - m_firstRow, count - before);
+    }
+    m_firstRow -= before;
+}
+
+void LogView::removeDocumentRows(int first, int count)
+{
+    // every row ends in a block break, the block after the removed rows is always there
+    auto from = firstBlockOf(first);
+    auto to = firstBlockOf(first + count);
+    QTextCursor cursor(document()->findBlockByNumber(from));
+    cursor.setPosition(document()->findBlockByNumber(to).position(), QTextCursor::KeepAnchor);
+    cursor.removeSelectedText();
+
+    m_rowBlocks.remove(first, count);
+    if (first == 0) {
+        m_blockBase += to - from;
+    } else {
+        for (int i = first; i < m_rowBlocks.size(); i++) {
+            m_rowBlocks[i] -= to - from;
+        }
+    }
+}
+
+int LogView::firstBlockOf(int documentRow) const
+{
+    if (documentRow >= m_rowBlocks.size()) {
+        // the empty block at the end
+        return document()->blockCount() - 1;
+    }
+    return m_rowBlocks[documentRow] - m_blockBase;
+}
+
+void LogView::loadRowsFrom(int first)
+{
+    if (!m_model || first >= m_firstRow) {
+        return;
+    }
+    auto bar = verticalScrollBar();
+    auto value = bar->value();
+    auto lines = document()->blockCount();
+
+    QList<int> rowBlocks;
+    auto fragment = rowsFragment(first, m_firstRow - 1, rowBlocks);
+    // the empty block at the end of the fragment goes into the first block of the document
+    m_blockBase -= rowBlocks.last();
+    QList<int> loaded;
+    loaded.reserve(rowBlocks.size() - 1 + m_rowBlocks.size());
+    for (int i = 0; i < rowBlocks.size() - 1; i++) {
+        loaded.append(m_blockBase + rowBlocks[i]);
+    }
+    loaded.append(m_rowBlocks);
+    m_rowBlocks.swap(loaded);
+
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::Start);
+    cursor.insertFragment(fragment);
+    m_firstRow = first;
+
+    // keep showing what was shown
+    bar->setValue(value + document()->blockCount() - lines);
+}
+
+void LogView::scrolled(int value)
+{
+    // before getting to the top, there is no more scrolling there once it is reached
+    auto bar = verticalScrollBar();
+    if (value - bar->minimum() < bar->pageStep() && m_firstRow > 0) {
+        loadRowsFrom(std::max(0, m_firstRow - s_loadRows));
+    }
+}
+
+int LogView::currentRow() const
+{
+    auto block = textCursor().blockNumber() + m_blockBase;
+    auto row = std::upper_bound(m_rowBlocks.cbegin(), m_rowBlocks.cend(), block) - m_rowBlocks.cbegin() - 1;
+    return static_cast<int>(std::max<qsizetype>(row, 0)) + m_firstRow;
+}
+
+void LogView::selectRow(int row, const QString& what)
+{
+    if (row < m_firstRow) {
+        loadRowsFrom(row);
+    }
+    auto documentRow = row - m_firstRow;
+    if (documentRow < 0 || documentRow >= m_rowBlocks.size())
+        return;
+
+    auto block = document()->findBlockByNumber(firstBlockOf(documentRow));
+    QTextCursor cursor(block);
+    // the match may be in any of the blocks of the line
+    for (auto end = firstBlockOf(documentRow + 1); block.isValid() && block.blockNumber() < end; block = block.next()) {
+        auto column = block.text().indexOf(what, 0, Qt::CaseInsensitive);
+        if (column >= 0) {
+            cursor.setPosition(block.position() + column);
+            cursor.setPosition(block.position() + column + what.size(), QTextCursor::KeepAnchor);
+            break;
+        }
+    }
+    setTextCursor(cursor);
+    centerCursor();
 }
 
 void LogView::scrollToBottom()
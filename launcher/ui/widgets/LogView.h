@@ -1,6 +1,7 @@
 #pragma once
 #include <QAbstractItemView>
 #include <QPlainTextEdit>
+#include <QTextDocumentFragment>
 
 class QAbstractItemModel;
 
@@ -13,10 +14,15 @@ class LogView : public QPlainTextEdit {
     virtual void setModel(QAbstractItemModel* model);
     QAbstractItemModel* model() const;
 
+    /// model row of the line the text cursor is in
+    int currentRow() const;
+
    public slots:
     void setWordWrap(bool wrapping);
     void setColorLines(bool colorLines);
     void findNext(const QString& what, bool reverse);
+    /// select `what` in the line of the given model row and scroll to it
+    void selectRow(int row, const QString& what);
     void scrollToBottom();
 
    protected slots:
@@ -24,9 +30,18 @@ class LogView : public QPlainTextEdit {
     // note: this supports only appending
     void rowsInserted(const QModelIndex& parent, int first, int last);
     void rowsAboutToBeInserted(const QModelIndex& parent, int first, int last);
-    // note: this supports only removing from front
     void rowsRemoved(const QModelIndex& parent, int first, int last);
     void modelDestroyed(QObject* model);
+    void scrolled(int value);
+
+   protected:
+    /// puts the model rows from `first` on before the document
+    void loadRowsFrom(int first);
+    /// the model rows as text, with the block each of them starts at and the block after the last one
+    QTextDocumentFragment rowsFragment(int first, int last, QList<int>& rowBlocks) const;
+    /// removes `count` model rows from the document, starting at the document row `first`
+    void removeDocumentRows(int first, int count);
+    int firstBlockOf(int documentRow) const;
 
    protected:
     QAbstractItemModel* m_model = nullptr;
@@ -34,4 +49,9 @@ class LogView : public QPlainTextEdit {
     bool m_scroll = false;
     bool m_scrolling = false;
     bool m_colorLines = true;
+    // the document holds the model rows from this one to the end, earlier ones are loaded when scrolled to
+    int m_firstRow = 0;
+    // the first block of every row in the document, offset by m_blockBase so removing rows at the front does not move them
+    QList<int> m_rowBlocks;
+    int m_blockBase = 0;
 };
@@ -0,0 +1,129 @@
+#include <QDirIterator>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+#include <modplatform/atlauncher/ATLModLayers.h>
+
+using ATLauncher::ModLayers;
+
+class ATLModLayersTest : public QObject {
+    Q_OBJECT
+
+    QString m_data;
+    QList<ModLayers::Layer> m_layers;
+
+    // the files of a folder and what is in them
+    static QMap<QString, QByteArray> tree(const QString& path)
+    {
+        QMap<QString, QByteArray> files;
+        QDir dir(path);
+        QDirIterator it(path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            auto file = it.next();
+            QFile f(file);
+            if (f.open(QFile::ReadOnly)) {
+                files.insert(dir.relativeFilePath(file), f.readAll());
+            }
+        }
+        return files;
+    }
+
+    // what the installation did before the layers: every rule applied over the configs, one after the other
+    QMap<QString, QByteArray> sequential(const QString& staging)
+    {
+        auto minecraft = FS::PathCombine(staging, "minecraft");
+        if (!MMCZip::extractDir(FS::PathCombine(m_data, "Configs.zip"), minecraft))
+            return {};
+        for (auto& layer : m_layers) {
+            auto target = FS::PathCombine(minecraft, layer.target);
+            switch (layer.kind) {
+                case ModLayers::Layer::Kind::Extract:
+                    if (!MMCZip::extractDir(layer.source, layer.entry, target))
+                        return {};
+                    break;
+                case ModLayers::Layer::Kind::Decomp:
+                    if (!MMCZip::extractFile(layer.source, layer.entry, target))
+                        return {};
+                    break;
+                case ModLayers::Layer::Kind::Copy:
+                    if (QFileInfo::exists(target) && !FS::deletePath(target))
+                        return {};
+                    if (!FS::copy(layer.source, target)())
+                        return {};
+                    break;
+            }
+        }
+        return tree(minecraft);
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        m_data = QDir(QFINDTESTDATA("testdata/ATLModLayers")).absolutePath();
+        auto file = [this](const QString& name) { return FS::PathCombine(m_data, name); };
+        // all of them overlap the configs, and the later ones overlap the earlier ones
+        m_layers = {
+            { ModLayers::Layer::Kind::Extract, file("extract.zip"), "config", "config" },
+            { ModLayers::Layer::Kind::Extract, file("overrides.zip"), "config", "config" },
+            { ModLayers::Layer::Kind::Decomp, file("decomp.zip"), "shared.cfg", "config/shared.cfg" },
+            { ModLayers::Layer::Kind::Copy, file("copied.jar"), {}, "mods/copied.jar" },
+        };
+    }
+
+    void test_sameAsSequential()
+    {
+        QTemporaryDir sequentialDir;
+        auto expected = sequential(sequentialDir.path());
+        QVERIFY(!expected.isEmpty());
+        QCOMPARE(expected.value("config/shared.cfg"), QByteArray("from decomp\n"));
+        QCOMPARE(expected.value("config/nested/deep.cfg"), QByteArray("nested from overrides\n"));
+        QCOMPARE(expected.value("mods/copied.jar"), QByteArray("new jar from the pack\n"));
+        QVERIFY(expected.contains("config/configs-only.cfg"));
+        QVERIFY(!expected.contains("unrelated/ignored.txt"));
+
+        QStringList sources;
+        for (auto& layer : m_layers)
+            sources.append(layer.source);
+        std::sort(sources.begin(), sources.end());
+
+        // every order the downloads could finish in
+        do {
+            QTemporaryDir staging;
+            QVERIFY(MMCZip::extractDir(FS::PathCombine(m_data, "Configs.zip"), FS::PathCombine(staging.path(), "minecraft")));
+
+            ModLayers layers(staging.path());
+            for (auto& layer : m_layers)
+                layers.add(layer);
+            // the last one never tells it is done, it is only started with the rest at the end
+            for (int i = 0; i < sources.size() - 1; i++)
+                layers.start(sources[i]);
+            layers.startAll();
+
+            QVERIFY(layers.apply());
+            QVERIFY(layers.pending().isEmpty());
+            QCOMPARE(tree(FS::PathCombine(staging.path(), "minecraft")), expected);
+            QVERIFY(!QFileInfo::exists(FS::PathCombine(staging.path(), "modlayers")));
+        } while (std::next_permutation(sources.begin(), sources.end()));
+    }
+
+    void test_stop()
+    {
+        QTemporaryDir staging;
+        ModLayers layers(staging.path());
+        for (auto& layer : m_layers)
+            layers.add(layer);
+        layers.stop();
+        layers.startAll();
+        // nothing is made once stopped, and it doesn't count as done
+        QVERIFY(!layers.apply());
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(staging.path(), "minecraft", "config")));
+    }
+};
+
+QTEST_GUILESS_MAIN(ATLModLayersTest)
+
+#include "ATLModLayers_test.moc"
@@ -0,0 +1,89 @@
+#include <QTest>
+
+#include <logs/AnonymizeLog.h>
+
+class AnonymizeLogTest : public QObject {
+    Q_OBJECT
+   private slots:
+    void test_rules_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::addColumn<QString>("expected");
+
+        QTest::newRow("windows") << R"([12:00:00] [main/INFO]: Loading from C:\Users\Steve\AppData\Roaming\PrismLauncher\instances)"
+                                 << R"([12:00:00] [main/INFO]: Loading from C:\Users\********\AppData\Roaming\PrismLauncher\instances)";
+        QTest::newRow("windows-forward-slashes") << "Java path: c:/users/Alex/.jdks/java-21/bin/java"
+                                                 << "Java path: C:/Users/********/.jdks/java-21/bin/java";
+        QTest::newRow("linux") << "Game dir: /home/steve/.local/share/PrismLauncher/instances/1.21/minecraft"
+                               << "Game dir: /home/********/.local/share/PrismLauncher/instances/1.21/minecraft";
+        QTest::newRow("macos") << "Game dir: /Users/alex/Library/Application Support/PrismLauncher/instances/x"
+                               << "Game dir: /Users/********/Library/Application Support/PrismLauncher/instances/x";
+        QTest::newRow("session") << "Setting user: Steve (Session ID is token:eyJhbGciOi.abc:1234)"
+                                 << "Setting user: Steve (Session ID is <SESSION_TOKEN>)";
+        QTest::newRow("refresh-token") << R"(Saving new refresh token: "M.C123_BAY.0.U.-abc")"
+                                       << R"(Saving new refresh token: "<TOKEN>")";
+        QTest::newRow("device-code") << R"("device_code" :  "DAQABAAEAAAD--DLA3VO7QrddgJg7Wevr")"
+                                     << R"("device_code" :  "<DEVICE_CODE>")";
+        QTest::newRow("mixed") << "Mixed: C:/Users/Alex/a and /home/bob/b and /Users/carol/c"
+                               << "Mixed: C:/Users/********/a and /home/********/b and /Users/********/c";
+        QTest::newRow("escaped-word") << R"(Path \w/home/dave/x stays)" << R"(Path \w/home/dave/x stays)";
+        // every upload anonymizes a line at a time, so a match never continues on the next line
+        QTest::newRow("session-across-lines") << "(Session ID is token:abc\n:def)\n/home/steve/x"
+                                              << "(Session ID is token:abc\n:def)\n/home/********/x";
+        QTest::newRow("nothing") << "No personal info here at all" << "No personal info here at all";
+    }
+
+    void test_rules()
+    {
+        QFETCH(QString, input);
+        QFETCH(QString, expected);
+
+        QString log = input;
+        anonymizeLog(log);
+        QCOMPARE(log, expected);
+        QCOMPARE(anonymizeLogToUtf8(input), expected.toUtf8());
+    }
+
+    void test_streaming()
+    {
+        QStringList lines = { R"(Loading from C:\Users\Steve\AppData)", "Game dir: /home/steve/.minecraft",
+                              "(Session ID is token:abc:def)", "plain line", "/Users/alex/Library/x" };
+        QString log = lines.join('\n') + '\n';
+        QString expected = log;
+        anonymizeLog(expected);
+
+        // chunk boundaries must not change the result, whatever line they split
+        for (int chunkSize : { 1, 3, 7, 64, 4096 }) {
+            QString out;
+            int linesSeen = 0;
+            LogAnonymizer anonymizer([&out, &linesSeen](const QString& line) {
+                out.append(line);
+                linesSeen++;
+            });
+            for (qsizetype pos = 0; pos < log.size(); pos += chunkSize) {
+                anonymizer.write(QStringView(log).mid(pos, chunkSize));
+            }
+            anonymizer.finish();
+            QCOMPARE(out, expected);
+            QCOMPARE(linesSeen, lines.size());
+        }
+    }
+
+    void test_benchmark()
+    {
+        QString log;
+        for (int i = 0; i < 20000; i++) {
+            log += QString("[12:00:%1] [Render thread/INFO]: Loaded /home/steve/.minecraft/mods/mod%1.jar\n").arg(i);
+        }
+        QByteArray out;
+        QBENCHMARK
+        {
+            out = anonymizeLogToUtf8(log);
+        }
+        QVERIFY(!out.contains("steve"));
+    }
+};
+
+QTEST_GUILESS_MAIN(AnonymizeLogTest)
+
+#include "AnonymizeLog_test.moc"
@@ -0,0 +1,135 @@
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <net/ApiResponseCache.h>
+
+class ApiResponseCacheTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_key()
+    {
+        using Net::ApiResponseCache;
+
+        auto key = ApiResponseCache::key("modrinth", QUrl("https://api.modrinth.com/v2/search?offset=0&limit=25&index=relevance"));
+        QCOMPARE(ApiResponseCache::key("modrinth", QUrl("HTTPS://API.modrinth.com:443/v2/search?limit=25&index=relevance&offset=0")),
+                 key);
+        QCOMPARE(ApiResponseCache::key("modrinth", QUrl("https://api.modrinth.com/v2/./search/?index=relevance&offset=0&limit=25#top")),
+                 key);
+
+        QVERIFY(ApiResponseCache::key("modrinth", QUrl("https://api.modrinth.com/v2/search?offset=25&limit=25&index=relevance")) != key);
+        QVERIFY(ApiResponseCache::key("curseforge", QUrl("https://api.modrinth.com/v2/search?offset=0&limit=25&index=relevance")) != key);
+        // repeated parameters keep their order
+        QVERIFY(ApiResponseCache::key("modrinth", QUrl("https://a.b/c?x=1&x=2")) !=
+                ApiResponseCache::key("modrinth", QUrl("https://a.b/c?x=2&x=1")));
+    }
+
+    void test_isFresh()
+    {
+        using Net::ApiResponseCache;
+
+        ApiResponseCache::Entry entry;
+        entry.fetchedAt = 1000000;
+
+        QVERIFY(ApiResponseCache::isFresh(entry, 300, entry.fetchedAt + 299 * 1000));
+        QVERIFY(!ApiResponseCache::isFresh(entry, 300, entry.fetchedAt + 300 * 1000));
+        // fetched in the future, the clock was changed
+        QVERIFY(!ApiResponseCache::isFresh(entry, 300, entry.fetchedAt - 1));
+
+        // the server can shorten the lifetime but not make it longer than the TTL
+        entry.maxAge = 60;
+        QVERIFY(!ApiResponseCache::isFresh(entry, 300, entry.fetchedAt + 61 * 1000));
+        entry.maxAge = 3600;
+        QVERIFY(!ApiResponseCache::isFresh(entry, 300, entry.fetchedAt + 301 * 1000));
+        entry.maxAge = 0;
+        QVERIFY(!ApiResponseCache::isFresh(entry, 300, entry.fetchedAt));
+    }
+
+    void test_persistence()
+    {
+        using Net::ApiResponseCache;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto key = ApiResponseCache::key("curseforge", QUrl("https://api.curseforge.com/v1/mods/238222"));
+
+        {
+            ApiResponseCache cache(dir.filePath("api"));
+            QVERIFY(!cache.get(key).has_value());
+            cache.insert(key, { "{\"data\":{}}", "\"abc\"", 1234, 60 });
+        }
+
+        ApiResponseCache cache(dir.filePath("api"));
+        auto entry = cache.get(key);
+        QVERIFY(entry.has_value());
+        QCOMPARE(entry->data, QByteArray("{\"data\":{}}"));
+        QCOMPARE(entry->etag, QByteArray("\"abc\""));
+        QCOMPARE(entry->fetchedAt, qint64(1234));
+        QCOMPARE(entry->maxAge, qint64(60));
+
+        cache.remove(key);
+        QVERIFY(!cache.get(key).has_value());
+        QVERIFY(!ApiResponseCache(dir.filePath("api")).get(key).has_value());
+    }
+
+    void test_memoryLimit()
+    {
+        using Net::ApiResponseCache;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        ApiResponseCache cache(dir.filePath("api"), 1024);
+        for (int i = 0; i < 16; i++) {
+            cache.insert(QString::number(i), { QByteArray(200, 'a' + i), {}, i, -1 });
+        }
+        // evicted from memory, still on disk
+        for (int i = 0; i < 16; i++) {
+            auto entry = cache.get(QString::number(i));
+            QVERIFY(entry.has_value());
+            QCOMPARE(entry->data, QByteArray(200, 'a' + i));
+        }
+    }
+
+    void test_prune()
+    {
+        using Net::ApiResponseCache;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        ApiResponseCache cache(dir.filePath("api"));
+        for (int i = 0; i < 10; i++) {
+            cache.insert(QString::number(i), { QByteArray(1000, 'a' + i), {}, i, -1 });
+        }
+        // entry i was written i hours ago
+        auto now = QDateTime::currentDateTime();
+        QDir files(dir.filePath("api"));
+        auto names = files.entryList(QDir::Files);
+        QCOMPARE(names.size(), 10);
+        for (auto& name : names) {
+            QFile file(files.filePath(name));
+            QVERIFY(file.open(QIODevice::ReadWrite));
+            auto contents = file.readAll();
+            auto i = contents.at(contents.size() - 1) - 'a';
+            QVERIFY(file.setFileTime(now.addSecs(-3600 * i), QFileDevice::FileModificationTime));
+        }
+
+        // older than 5.5 hours
+        cache.prune(3600 * 11 / 2, -1);
+        QCOMPARE(files.entryList(QDir::Files).size(), 6);
+        // the oldest go first, until the rest fits, a bit more than 3 entries
+        cache.prune(-1, 3500);
+        QCOMPARE(files.entryList(QDir::Files).size(), 3);
+
+        ApiResponseCache reopened(dir.filePath("api"));
+        for (int i = 0; i < 10; i++) {
+            QCOMPARE(reopened.get(QString::number(i)).has_value(), i < 3);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ApiResponseCacheTest)
+
+#include "ApiResponseCache_test.moc"
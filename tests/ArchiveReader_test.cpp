@@ -0,0 +1,174 @@
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <archive/ArchiveReader.h>
+
+// writes stored zips byte by byte, to get the layouts other tools make that the reader has to cope with
+class ZipWriter {
+   public:
+    struct Options {
+        QByteArray prefix;   ///< data before the zip, the offsets in it don't count it
+        QByteArray comment;  ///< the comment of the archive
+        bool zip64 = false;
+        QByteArray extensible;  ///< the extensible data sector of the zip64 end of central directory record
+    };
+
+    static QByteArray make(const QList<QPair<QByteArray, QByteArray>>& entries, const Options& options = {})
+    {
+        QByteArray local;
+        QByteArray central;
+        QDataStream localOut(&local, QIODevice::WriteOnly);
+        QDataStream centralOut(&central, QIODevice::WriteOnly);
+        localOut.setByteOrder(QDataStream::LittleEndian);
+        centralOut.setByteOrder(QDataStream::LittleEndian);
+
+        for (auto& [name, data] : entries) {
+            auto offset = quint32(local.size());
+            auto crc = crc32(data);
+            localOut << quint32(0x04034b50) << quint16(20) << quint16(0x800) << quint16(0) << quint16(0) << quint16(0x21) << crc
+                     << quint32(data.size()) << quint32(data.size()) << quint16(name.size()) << quint16(0);
+            localOut.writeRawData(name.constData(), name.size());
+            localOut.writeRawData(data.constData(), data.size());
+
+            centralOut << quint32(0x02014b50) << quint16(20) << quint16(20) << quint16(0x800) << quint16(0) << quint16(0) << quint16(0x21)
+                       << crc << quint32(data.size()) << quint32(data.size()) << quint16(name.size()) << quint16(0) << quint16(0)
+                       << quint16(0) << quint16(0) << quint32(0) << offset;
+            centralOut.writeRawData(name.constData(), name.size());
+        }
+
+        QByteArray end;
+        QDataStream endOut(&end, QIODevice::WriteOnly);
+        endOut.setByteOrder(QDataStream::LittleEndian);
+        auto count = quint64(entries.size());
+        auto size = quint64(central.size());
+        auto offset = quint64(local.size());
+        if (options.zip64) {
+            auto recordOffset = offset + size;
+            endOut << quint32(0x06064b50) << quint64(44 + options.extensible.size()) << quint16(45) << quint16(45) << quint32(0)
+                   << quint32(0) << count << count << size << offset;
+            endOut.writeRawData(options.extensible.constData(), options.extensible.size());
+            endOut << quint32(0x07064b50) << quint32(0) << recordOffset << quint32(1);
+            endOut << quint32(0x06054b50) << quint16(0) << quint16(0) << quint16(0xFFFF) << quint16(0xFFFF) << quint32(0xFFFFFFFF)
+                   << quint32(0xFFFFFFFF);
+        } else {
+            endOut << quint32(0x06054b50) << quint16(0) << quint16(0) << quint16(count) << quint16(count) << quint32(size)
+                   << quint32(offset);
+        }
+        endOut << quint16(options.comment.size());
+        endOut.writeRawData(options.comment.constData(), options.comment.size());
+
+        return options.prefix + local + central + end;
+    }
+
+   private:
+    static quint32 crc32(const QByteArray& data)
+    {
+        quint32 crc = 0xFFFFFFFF;
+        for (char c : data) {
+            crc ^= uchar(c);
+            for (int i = 0; i < 8; i++)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+        return ~crc;
+    }
+};
+
+class ArchiveReaderTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    QString write(const QString& name, const QByteArray& data)
+    {
+        QFile file(m_dir.filePath(name));
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+            return {};
+        return file.fileName();
+    }
+
+    static QList<QPair<QByteArray, QByteArray>> entries()
+    {
+        return { { "pack.mcmeta", "{}" }, { "assets/", "" }, { "assets/texture.png", "not really a png" } };
+    }
+
+    static QStringList files() { return { "pack.mcmeta", "assets/texture.png" }; }
+
+   private slots:
+    void initTestCase() { QVERIFY(m_dir.isValid()); }
+
+    void test_plain()
+    {
+        auto path = write("plain.zip", ZipWriter::make(entries()));
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, true).value_or(QStringList()), files());
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, false).value_or(QStringList()),
+                 QStringList({ "pack.mcmeta", "assets/", "assets/texture.png" }));
+
+        MMCZip::ArchiveReader reader(path);
+        QVERIFY(reader.collectFiles());
+        QCOMPARE(reader.getFiles(), files());
+    }
+
+    void test_commentWithSignature()
+    {
+        // a comment that looks like the start of an end of central directory record
+        QByteArray comment("made by a tool PK\x05\x06", 19);
+        comment += QByteArray(18, '\x01') + " and more";
+        auto path = write("comment.zip", ZipWriter::make(entries(), { {}, comment }));
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, true).value_or(QStringList()), files());
+    }
+
+    void test_prepended()
+    {
+        // like a self-extracting archive, whose offsets don't count the stub
+        auto path = write("prepended.zip", ZipWriter::make(entries(), { QByteArray(4096, 'x') }));
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, true).value_or(QStringList()), files());
+    }
+
+    void test_zip64()
+    {
+        auto path = write("zip64.zip", ZipWriter::make(entries(), { {}, {}, true }));
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, true).value_or(QStringList()), files());
+
+        // the record is found through the locator, not by assuming its size
+        path = write("zip64-extensible.zip", ZipWriter::make(entries(), { {}, "a comment", true, QByteArray(24, '\x02') }));
+        QCOMPARE(MMCZip::ArchiveReader::readCentralDirectory(path, true).value_or(QStringList()), files());
+    }
+
+    void test_corrupt()
+    {
+        auto zip = ZipWriter::make(entries());
+
+        // cut in the end of central directory record
+        auto path = write("truncated.zip", zip.left(zip.size() - 10));
+        QVERIFY(!MMCZip::ArchiveReader::readCentralDirectory(path, true).has_value());
+        // libarchive gets to go through it instead, it may still find the entries from their local headers
+        MMCZip::ArchiveReader truncated(path);
+        if (truncated.collectFiles())
+            QCOMPARE(truncated.getFiles(), files());
+
+        // a directory that claims more entries than it has
+        auto broken = zip;
+        auto eocd = broken.size() - 22;
+        broken[eocd + 8] = 9;
+        broken[eocd + 10] = 9;
+        path = write("count.zip", broken);
+        QVERIFY(!MMCZip::ArchiveReader::readCentralDirectory(path, true).has_value());
+
+        // a directory that starts before the file
+        broken = zip;
+        broken[eocd + 15] = '\x7f';
+        path = write("size.zip", broken);
+        QVERIFY(!MMCZip::ArchiveReader::readCentralDirectory(path, true).has_value());
+
+        path = write("empty.zip", {});
+        QVERIFY(!MMCZip::ArchiveReader::readCentralDirectory(path, true).has_value());
+        path = write("text.zip", "not a zip at all, but long enough to have room for a record");
+        QVERIFY(!MMCZip::ArchiveReader::readCentralDirectory(path, true).has_value());
+    }
+};
+
+QTEST_GUILESS_MAIN(ArchiveReaderTest)
+
+#include "ArchiveReader_test.moc"
@@ -304,6 +304,39 @@ class FileSystemTest : public QObject {
         }
     }
 
+    void test_mergeFolder()
+    {
+        QTemporaryDir tempDir;
+        QDir root(tempDir.path());
+        auto write = [&root](const QString& path, const QByteArray& data) { FS::write(root.filePath(path), data); };
+
+        write("minecraft/mods/downloaded.jar", "downloaded");
+        write("overrides/mods/downloaded.jar", "override");
+        write("overrides/config/mod.toml", "config");
+        write("overrides/options.txt", "options");
+
+        QVERIFY(FS::mergeFolder(root.filePath("minecraft"), root.filePath("overrides")));
+        QVERIFY(!root.exists("overrides"));
+        // files that are already there are kept, everything else is moved in
+        QCOMPARE(FS::read(root.filePath("minecraft/mods/downloaded.jar")), QByteArray("downloaded"));
+        QCOMPARE(FS::read(root.filePath("minecraft/config/mod.toml")), QByteArray("config"));
+        QCOMPARE(FS::read(root.filePath("minecraft/options.txt")), QByteArray("options"));
+
+        // without a target folder it is a plain move
+        write("client-overrides/options.txt", "client");
+        QVERIFY(FS::mergeFolder(root.filePath("game"), root.filePath("client-overrides")));
+        QCOMPARE(FS::read(root.filePath("game/options.txt")), QByteArray("client"));
+
+        // replacing overwrites the files that are already there, and keeps empty folders
+        write("layer/mods/downloaded.jar", "layer");
+        QVERIFY(root.mkpath("layer/resourcepacks"));
+        QVERIFY(FS::mergeFolder(root.filePath("minecraft"), root.filePath("layer"), true));
+        QVERIFY(!root.exists("layer"));
+        QCOMPARE(FS::read(root.filePath("minecraft/mods/downloaded.jar")), QByteArray("layer"));
+        QCOMPARE(FS::read(root.filePath("minecraft/config/mod.toml")), QByteArray("config"));
+        QVERIFY(root.exists("minecraft/resourcepacks"));
+    }
+
     void test_getDesktop() { QCOMPARE(FS::getDesktopDir(), QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)); }
 
     void test_link()
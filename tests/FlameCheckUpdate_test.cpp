@@ -0,0 +1,76 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/flame/FlameAPI.h>
+#include <modplatform/flame/FlameCheckUpdate.h>
+
+// testdata/FlameCheckUpdate holds responses of the CurseForge /mods and /mods/files endpoints, cut down to the fields that are read
+class FlameCheckUpdateTest : public QObject {
+    Q_OBJECT
+
+    static QJsonArray loadResponse(const QString& name)
+    {
+        auto path = QFINDTESTDATA("testdata/FlameCheckUpdate/" + name);
+        return QJsonDocument::fromJson(FS::read(path)).object()["data"].toArray();
+    }
+
+   private slots:
+    void test_latestFileIds()
+    {
+        auto projects = loadResponse("mods.json");
+
+        auto fileIds = FlameCheckUpdate::latestFileIds(projects, "1.20.1");
+        QCOMPARE(fileIds.size(), 3);
+        QCOMPARE(fileIds["238222"], QStringList({ "5101366", "5120001", "5101365" }));
+        // listed once per loader, requested once
+        QCOMPARE(fileIds["306612"], QStringList({ "5383715" }));
+        QCOMPARE(fileIds["32274"], QStringList({ "5400000" }));
+
+        QCOMPARE(FlameCheckUpdate::latestFileIds(projects, "1.19.2")["238222"], QStringList({ "4712868" }));
+        QCOMPARE(FlameCheckUpdate::latestFileIds(projects, QString())["238222"].size(), 4);
+        QVERIFY(FlameCheckUpdate::latestFileIds(projects, "1.21")["306612"].isEmpty());
+    }
+
+    void test_loadFiles()
+    {
+        auto versions = FlameCheckUpdate::loadFiles(loadResponse("files.json"));
+        QCOMPARE(versions.size(), 3);
+
+        auto jei = versions["238222"];
+        QCOMPARE(jei.size(), 3);
+        // newest first
+        QCOMPARE(jei[0].fileId.toInt(), 5120001);
+        QCOMPARE(jei[1].fileId.toInt(), 5101366);
+        QCOMPARE(jei[2].fileId.toInt(), 5101365);
+        QCOMPARE(jei[1].hash, QString("a6fb5c8f1c2cda8e53c9f0c4a1b4e2f0c5a6b7d8"));
+
+        QVERIFY(versions["32274"].first().downloadUrl.isEmpty());
+    }
+
+    void test_latestVersion()
+    {
+        FlameAPI api;
+        auto versions = FlameCheckUpdate::loadFiles(loadResponse("files.json"));
+
+        auto forge = api.getLatestVersion(versions["238222"], { ModPlatform::Forge }, ModPlatform::Forge, true);
+        QVERIFY(forge.has_value());
+        QCOMPARE(forge->fileId.toInt(), 5120001);
+
+        auto fabric = api.getLatestVersion(versions["238222"], { ModPlatform::Fabric }, ModPlatform::Fabric, true);
+        QVERIFY(fabric.has_value());
+        QCOMPARE(fabric->fileId.toInt(), 5101365);
+
+        auto quilt = api.getLatestVersion(versions["306612"], { ModPlatform::Quilt }, ModPlatform::Quilt, true);
+        QVERIFY(quilt.has_value());
+        QCOMPARE(quilt->fileId.toInt(), 5383715);
+
+        QVERIFY(!api.getLatestVersion(versions["306612"], { ModPlatform::Forge }, ModPlatform::Forge, true).has_value());
+    }
+};
+
+QTEST_GUILESS_MAIN(FlameCheckUpdateTest)
+
+#include "FlameCheckUpdate_test.moc"
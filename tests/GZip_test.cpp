@@ -1,5 +1,7 @@
 #include <QTest>
 
+#include <QTemporaryFile>
+
 #include <GZip.h>
 #include <random>
 
@@ -45,6 +47,75 @@ class GZipTest : public QObject {
             fib(prev, cur);
         } while (cur < size);
     }
+
+    void test_SeekIndex()
+    {
+        QByteArray text;
+        for (int i = 0; i < 200000; i++) {
+            text.append(QByteArray::number(i) + " some log line\n");
+        }
+        QByteArray compressed;
+        QVERIFY(GZip::zip(text, compressed));
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(compressed);
+        file.flush();
+
+        // small spacing so reads have to start from seek points in the middle of the stream
+        GZip::SeekIndex index;
+        qint64 seen = 0;
+        QVERIFY(index.build(&file, [&seen](const QByteArray& block) {
+                         seen += block.size();
+                         return true;
+                     }, 64 * 1024)
+                    .isEmpty());
+        QCOMPARE(seen, text.size());
+        QCOMPARE(index.size(), text.size());
+
+        for (qint64 offset : { qint64(0), qint64(1), qint64(65535), qint64(65536), qint64(1000000), qint64(text.size() - 10) }) {
+            QCOMPARE(index.read(&file, offset, 100), text.mid(offset, 100));
+        }
+    }
+
+    void test_multiMember()
+    {
+        // concatenated gzip files, like a log rotated by appending to its archive
+        QByteArray text;
+        QByteArray compressed;
+        for (int member = 0; member < 3; member++) {
+            QByteArray part;
+            for (int i = 0; i < 50000; i++) {
+                part.append(QByteArray::number(member) + ":" + QByteArray::number(i) + " some log line\n");
+            }
+            QByteArray zipped;
+            QVERIFY(GZip::zip(part, zipped));
+            text.append(part);
+            compressed.append(zipped);
+        }
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(compressed);
+        file.flush();
+
+        QByteArray streamed;
+        file.seek(0);
+        QVERIFY(GZip::readGzFileByBlocks(&file, [&streamed](const QByteArray& block) {
+                    streamed.append(block);
+                    return true;
+                }).isEmpty());
+        QCOMPARE(streamed, text);
+
+        GZip::SeekIndex index;
+        QVERIFY(index.build(&file, {}, 64 * 1024).isEmpty());
+        QCOMPARE(index.size(), text.size());
+        // from the middle of a member, across the boundary to the next one, and in the last one
+        auto boundary = text.indexOf("1:0 ");
+        for (qint64 offset : { qint64(0), qint64(100000), boundary - 50, boundary, qint64(text.size() - 10) }) {
+            QCOMPARE(index.read(&file, offset, 100), text.mid(offset, 100));
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
@@ -0,0 +1,145 @@
+#include <QHash>
+#include <QSignalSpy>
+#include <QTest>
+#include <QTimer>
+
+#include <functional>
+
+#include <minecraft/mod/tasks/GetModDependenciesTask.h>
+
+// answers the lookups of the resolver from a table of mods instead of the network
+class FakeLookup : public Task {
+    Q_OBJECT
+   public:
+    explicit FakeLookup(std::function<void()> fill) : m_fill(std::move(fill)) {}
+
+   protected:
+    void executeTask() override
+    {
+        // like a reply, it comes in later
+        QTimer::singleShot(0, this, [this] {
+            m_fill();
+            emitSucceeded();
+        });
+    }
+
+   private:
+    std::function<void()> m_fill;
+};
+
+class TableDependenciesTask : public GetModDependenciesTask {
+    Q_OBJECT
+   public:
+    TableDependenciesTask(const QHash<QString, QStringList>& dependencies, QList<std::shared_ptr<PackDependency>> selected)
+        : GetModDependenciesTask(Version("1.20.1"), ModPlatform::NeoForge, {}, {}, selected), m_dependencies(dependencies)
+    {}
+
+    static ModPlatform::IndexedVersion version(const QString& id, const QStringList& dependencies)
+    {
+        ModPlatform::IndexedVersion version;
+        version.addonId = id;
+        version.fileId = id + "-file";
+        version.version = "1.0";
+        version.fileName = id + "-1.0.jar";
+        version.mcVersion = { "1.20.1" };
+        version.loaders = ModPlatform::NeoForge;
+        for (auto& dependency : dependencies) {
+            version.dependencies.append({ dependency, ModPlatform::DependencyType::REQUIRED, {} });
+        }
+        return version;
+    }
+
+    // how many times the version of each project was looked up
+    QHash<QString, int> m_versionLookups;
+
+   protected:
+    Task::Ptr getProjectsInfoTask(ModPlatform::ResourceProvider, QList<std::shared_ptr<PackDependency>> pDeps) override
+    {
+        return makeShared<FakeLookup>([pDeps] {
+            for (auto& pDep : pDeps) {
+                pDep->pack->name = pDep->pack->addonId.toString();
+            }
+        });
+    }
+
+    Task::Ptr getVersionsTask(QList<std::shared_ptr<PackDependency>>) override { return makeShared<FakeLookup>([] {}); }
+
+    Task::Ptr getDependencyVersionTask(std::shared_ptr<PackDependency> pDep) override
+    {
+        auto id = pDep->dependency.addonId.toString();
+        m_versionLookups[id]++;
+        return makeShared<FakeLookup>([this, pDep, id] {
+            if (m_dependencies.contains(id)) {
+                pDep->version = version(id, m_dependencies.value(id));
+            }
+        });
+    }
+
+   private:
+    QHash<QString, QStringList> m_dependencies;
+};
+
+class GetModDependenciesTaskTest : public QObject {
+    Q_OBJECT
+
+    static std::shared_ptr<GetModDependenciesTask::PackDependency> selected(const QString& id, const QStringList& dependencies)
+    {
+        auto pack = std::make_shared<ModPlatform::IndexedPack>();
+        pack->addonId = id;
+        pack->name = id;
+        pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+        return std::make_shared<GetModDependenciesTask::PackDependency>(pack, TableDependenciesTask::version(id, dependencies));
+    }
+
+    static QStringList resolve(TableDependenciesTask& task)
+    {
+        QSignalSpy succeeded(&task, &Task::succeeded);
+        task.start();
+        if (succeeded.isEmpty()) {
+            succeeded.wait();
+        }
+        QStringList ids;
+        for (auto& pDep : task.getDependecies()) {
+            ids.append(pDep->pack->addonId.toString());
+        }
+        ids.sort();
+        return ids;
+    }
+
+   private slots:
+    void test_diamond()
+    {
+        // a needs b and c, which both need d
+        TableDependenciesTask task({ { "b", { "d" } }, { "c", { "d" } }, { "d", {} } }, { selected("a", { "b", "c" }) });
+
+        QCOMPARE(resolve(task), QStringList({ "b", "c", "d" }));
+        // d is looked up once, for whichever of b and c gets to it first
+        QCOMPARE(task.m_versionLookups.value("b"), 1);
+        QCOMPARE(task.m_versionLookups.value("c"), 1);
+        QCOMPARE(task.m_versionLookups.value("d"), 1);
+    }
+
+    void test_cycle()
+    {
+        // a needs b, b and c need each other, and c needs a, which is selected already
+        TableDependenciesTask task({ { "b", { "c" } }, { "c", { "b", "a" } } }, { selected("a", { "b" }) });
+
+        QCOMPARE(resolve(task), QStringList({ "b", "c" }));
+        QCOMPARE(task.m_versionLookups.value("b"), 1);
+        QCOMPARE(task.m_versionLookups.value("c"), 1);
+        QVERIFY(!task.m_versionLookups.contains("a"));
+    }
+
+    void test_missing()
+    {
+        // versions that can't be found are left out, with what only they need
+        TableDependenciesTask task({ { "b", {} } }, { selected("a", { "b", "gone" }) });
+
+        QCOMPARE(resolve(task), QStringList({ "b" }));
+        QCOMPARE(task.m_versionLookups.value("gone"), 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(GetModDependenciesTaskTest)
+
+#include "GetModDependenciesTask_test.moc"
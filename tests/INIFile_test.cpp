@@ -1,8 +1,10 @@
 #include <QTest>
 
 #include <settings/INIFile.h>
+#include <settings/INISettingsObject.h>
 #include <QList>
 #include <QSettings>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QVariant>
 #include "FileSystem.h"
@@ -190,6 +192,82 @@ PreLaunchCommand=)";
         FS::deletePath(fileName);
 #endif
     }
+
+    void test_QSettingsCompatibility_data()
+    {
+        QTest::addColumn<QString>("key");
+        QTest::addColumn<QVariant>("value");
+
+        QTest::newRow("plain") << "plain" << QVariant("value");
+        QTest::newRow("padded") << "padded" << QVariant("  padded  ");
+        QTest::newRow("separators") << "separators" << QVariant("a=b;c,d");
+        QTest::newRow("escapes") << "escapes" << QVariant("line\nbreak\ttab \"quoted\" back\\slash");
+        QTest::newRow("control followed by digit") << "control" << QVariant(QString("bell\x01"
+                                                                                     "0"));
+        QTest::newRow("unicode") << "unicode" << QVariant(QString::fromUtf8("h\xc3\xa9llo \xe2\x9c\x93 \xf0\x9f\x98\x80"));
+        QTest::newRow("at sign") << "at" << QVariant("@not a variant");
+        QTest::newRow("empty") << "empty" << QVariant("");
+        QTest::newRow("byte array") << "bytes" << QVariant(QByteArray("\x00\xff raw", 7));
+        QTest::newRow("list") << "list" << QVariant(QStringList{ "a", "b, c", " d ", "@e" });
+        QTest::newRow("section") << "UI/Page/Columns" << QVariant("x");
+        QTest::newRow("odd key") << QString::fromUtf8("with space%\xc3\xa9") << QVariant("y");
+    }
+
+    void test_QSettingsCompatibility()
+    {
+        QFETCH(QString, key);
+        QFETCH(QVariant, value);
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // written by us, read by QSettings
+        auto ours = dir.filePath("ours.cfg");
+        INIFile out;
+        out.set(key, value);
+        QVERIFY(out.saveFile(ours));
+        QSettings read{ ours, QSettings::Format::IniFormat };
+        QCOMPARE(read.status(), QSettings::Status::NoError);
+        QCOMPARE(read.value(key), value);
+
+        // written by QSettings, read by us
+        auto theirs = dir.filePath("theirs.cfg");
+        {
+            QSettings write{ theirs, QSettings::Format::IniFormat };
+            write.setValue("ConfigVersion", "1.3");
+            write.setValue(key, value);
+        }
+        INIFile in;
+        QVERIFY(in.loadFile(theirs));
+        QCOMPARE(in.get(key, "NOT SET"), value);
+    }
+
+    void test_WriteBehind()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto fileName = dir.filePath("settings.cfg");
+        {
+            INISettingsObject settings(fileName);
+            settings.setWriteBehind(true);
+            settings.registerSetting("counter", 0);
+            for (int i = 1; i <= 100; i++)
+                settings.set("counter", i);
+
+            // nothing is written until the changes settle
+            QVERIFY(!QFile::exists(fileName));
+            QTRY_VERIFY(QFile::exists(fileName));
+            INIFile written;
+            QVERIFY(written.loadFile(fileName));
+            QCOMPARE(written.get("counter", 0).toInt(), 100);
+
+            settings.set("counter", 101);
+        }
+        // pending changes are written on destruction
+        INIFile written;
+        QVERIFY(written.loadFile(fileName));
+        QCOMPARE(written.get("counter", 0).toInt(), 101);
+    }
 };
 
 QTEST_GUILESS_MAIN(IniFileTest)
@@ -0,0 +1,118 @@
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <ImageCache.h>
+
+class ImageCacheTest : public QObject {
+    Q_OBJECT
+
+    static QString writeImage(const QString& path, QSize size, QColor color)
+    {
+        QImage image(size, QImage::Format_ARGB32);
+        image.fill(color);
+        image.save(path, "PNG");
+        return path;
+    }
+
+   private slots:
+    void test_scalesDown()
+    {
+        QTemporaryDir dir;
+        auto source = writeImage(dir.filePath("source.png"), { 300, 200 }, Qt::red);
+        auto thumbnailPath = dir.filePath("thumbnails/source.png");
+
+        auto thumbnail = ImageCache::makeThumbnail(source, thumbnailPath, { 64, 64 });
+        QCOMPARE(thumbnail.size(), QSize(64, 42));
+        QCOMPARE(QImage(thumbnailPath).size(), QSize(64, 42));
+    }
+
+    void test_keepsSmallImages()
+    {
+        QTemporaryDir dir;
+        auto source = writeImage(dir.filePath("source.png"), { 16, 32 }, Qt::red);
+
+        QCOMPARE(ImageCache::makeThumbnail(source, dir.filePath("thumbnail.png"), { 64, 64 }).size(), QSize(16, 32));
+    }
+
+    void test_padded()
+    {
+        QTemporaryDir dir;
+        auto source = writeImage(dir.filePath("source.png"), { 300, 200 }, Qt::red);
+
+        // centered on a transparent square
+        auto thumbnail = ImageCache::makeThumbnail(source, dir.filePath("thumbnail.png"), { 64, 64 }, true);
+        QCOMPARE(thumbnail.size(), QSize(64, 64));
+        QCOMPARE(thumbnail.pixelColor(32, 32), QColor(Qt::red));
+        QCOMPARE(thumbnail.pixelColor(32, 0).alpha(), 0);
+        QCOMPARE(thumbnail.pixelColor(32, 63).alpha(), 0);
+
+        source = writeImage(dir.filePath("small.png"), { 16, 32 }, Qt::red);
+        thumbnail = ImageCache::makeThumbnail(source, dir.filePath("small-thumbnail.png"), { 64, 64 }, true);
+        QCOMPARE(thumbnail.size(), QSize(64, 64));
+        QCOMPARE(thumbnail.pixelColor(32, 32), QColor(Qt::red));
+        QCOMPARE(thumbnail.pixelColor(0, 32).alpha(), 0);
+    }
+
+    void test_remakesOutdatedThumbnails()
+    {
+        QTemporaryDir dir;
+        auto source = writeImage(dir.filePath("source.png"), { 128, 128 }, Qt::red);
+        auto thumbnailPath = dir.filePath("thumbnail.png");
+
+        auto thumbnail = ImageCache::makeThumbnail(source, thumbnailPath, { 64, 64 });
+        QCOMPARE(thumbnail.pixelColor(0, 0), QColor(Qt::red));
+
+        writeImage(source, { 128, 128 }, Qt::blue);
+        QFile file(source);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+        file.close();
+
+        thumbnail = ImageCache::makeThumbnail(source, thumbnailPath, { 64, 64 });
+        QCOMPARE(thumbnail.pixelColor(0, 0), QColor(Qt::blue));
+    }
+
+    void test_unreadableImage()
+    {
+        QTemporaryDir dir;
+        QFile file(dir.filePath("source.png"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("not an image");
+        file.close();
+
+        QVERIFY(ImageCache::makeThumbnail(file.fileName(), dir.filePath("thumbnail.png"), { 64, 64 }).isNull());
+        QVERIFY(!QFile::exists(dir.filePath("thumbnail.png")));
+    }
+
+    void test_prune()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QDir files(dir.filePath("thumbnails"));
+        QVERIFY(files.mkpath("."));
+        // thumbnail i was used i hours ago
+        auto now = QDateTime::currentDateTime();
+        for (int i = 0; i < 10; i++) {
+            QFile file(files.filePath(QString("%1.png").arg(i)));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QByteArray(1000, 'a'));
+            QVERIFY(file.flush());
+            QVERIFY(file.setFileTime(now.addSecs(-3600 * i), QFileDevice::FileModificationTime));
+        }
+
+        ImageCache cache(files.path());
+        // older than 5.5 hours
+        cache.prune(3600 * 11 / 2, -1);
+        QCOMPARE(files.entryList(QDir::Files).size(), 6);
+        // the oldest go first, until the rest fits, a bit more than 3 thumbnails
+        cache.prune(-1, 3500);
+        QCOMPARE(files.entryList(QDir::Files), QStringList({ "0.png", "1.png", "2.png" }));
+    }
+};
+
+QTEST_GUILESS_MAIN(ImageCacheTest)
+
+#include "ImageCache_test.moc"
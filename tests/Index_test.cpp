@@ -1,3 +1,7 @@
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 
 #include <meta/Index.h>
@@ -33,6 +37,36 @@ class IndexTest : public QObject {
         windex.merge(std::shared_ptr<Meta::Index>(new Meta::Index({ std::make_shared<Meta::VersionList>("list6") })));
         QCOMPARE(windex.lists().size(), 6);
     }
+
+    void test_localLoad()
+    {
+        QTemporaryDir root;
+        QVERIFY(root.isValid());
+        auto previous = QDir::currentPath();
+        // meta files are kept relative to the working directory
+        QVERIFY(QDir::setCurrent(root.path()));
+        QVERIFY(QDir().mkpath("meta"));
+        QFile file("meta/index.json");
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(R"({"formatVersion": 1, "packages": [{"uid": "list1", "name": "List 1"}, {"uid": "list2"}]})");
+        file.close();
+
+        // the first load parses the JSON, the second one uses what was parsed then
+        for (int i = 0; i < 2; i++) {
+            Meta::Index index;
+            auto task = index.loadTask(Net::Mode::Offline);
+            QSignalSpy succeeded(task.get(), &Task::succeeded);
+            task->start();
+            QVERIFY(succeeded.count() == 1 || succeeded.wait());
+            QVERIFY(index.status() == Meta::BaseEntity::LoadStatus::Local);
+            QVERIFY(index.hasUid("list1"));
+            QVERIFY(index.hasUid("list2"));
+            QCOMPARE(index.get("list1")->name(), QString("List 1"));
+            QVERIFY(QFile::exists("meta/.parsed/index.json"));
+        }
+
+        QVERIFY(QDir::setCurrent(previous));
+    }
 };
 
 QTEST_GUILESS_MAIN(IndexTest)
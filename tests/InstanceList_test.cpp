@@ -0,0 +1,171 @@
+#include <QDir>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+#include <BaseInstance.h>
+#include <InstanceList.h>
+#include <settings/INIFile.h>
+#include <settings/INISettingsObject.h>
+
+class InstanceListTest : public QObject {
+    Q_OBJECT
+
+    static constexpr int s_instanceCount = 10000;
+
+    QTemporaryDir m_root;
+    std::unique_ptr<INISettingsObject> m_globalSettings;
+    std::unique_ptr<InstanceList> m_list;
+    QStringList m_ids;
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_root.isValid());
+        // the instance list logs every instance it finds and loads
+        QLoggingCategory::setFilterRules("default.debug=false\ndefault.info=false");
+        // the instance snapshot is kept relative to the working directory
+        QVERIFY(QDir::setCurrent(m_root.path()));
+
+        m_globalSettings = std::make_unique<INISettingsObject>(m_root.filePath("global.cfg"));
+        for (auto id : { "ShowGameTime", "RecordGameTime", "PreLaunchCommand", "WrapperCommand", "PostExitCommand", "ShowConsole",
+                         "AutoCloseConsole", "ShowConsoleOnError", "LogPrePostOutput", "ConsoleMaxLines", "ConsoleOverflowStop",
+                         "ConsoleUnlimitedScrollback" }) {
+            m_globalSettings->registerSetting(id, QVariant());
+        }
+
+        QDir instDir(m_root.filePath("instances"));
+        for (int i = 0; i < s_instanceCount; i++) {
+            auto id = QString("inst%1").arg(i);
+            QVERIFY(instDir.mkpath(id));
+            QFile cfg(instDir.filePath(id + "/instance.cfg"));
+            QVERIFY(cfg.open(QFile::WriteOnly));
+            cfg.write(QString("ConfigVersion=1.3\nInstanceType=Test\nname=Instance %1\nManagedPackName=pack%1\ntotalTimePlayed=%1\n")
+                          .arg(i)
+                          .toUtf8());
+            m_ids.append(id);
+        }
+
+        m_list = std::make_unique<InstanceList>(m_globalSettings.get(), instDir.path());
+        QVERIFY(m_list->loadList() == InstanceList::NoError);
+        QCOMPARE(m_list->count(), s_instanceCount);
+    }
+
+    void cleanupTestCase()
+    {
+        // also waits for the snapshot to be written
+        m_list->saveNow();
+        m_list.reset();
+        m_globalSettings.reset();
+    }
+
+    void test_lookup()
+    {
+        for (int i = 0; i < s_instanceCount; i += 997) {
+            auto inst = m_list->getInstanceById(m_ids[i]);
+            QVERIFY(inst);
+            QCOMPARE(inst->id(), m_ids[i]);
+            QCOMPARE(m_list->getInstanceByManagedName(QString("pack%1").arg(i)), inst);
+            QCOMPARE(m_list->getInstanceIndexById(m_ids[i]).data(InstanceList::InstanceIDRole).toString(), m_ids[i]);
+        }
+        QVERIFY(!m_list->getInstanceById("missing"));
+        QVERIFY(!m_list->getInstanceByManagedName("missing"));
+        QVERIFY(!m_list->getInstanceIndexById("missing").isValid());
+
+        QBENCHMARK
+        {
+            for (auto& id : m_ids) {
+                m_list->getInstanceIndexById(id);
+            }
+        }
+    }
+
+    void test_managedNameChange()
+    {
+        auto inst = m_list->getInstanceById("inst7");
+        inst->settings()->set("ManagedPackName", "renamed");
+        QCOMPARE(m_list->getInstanceByManagedName("renamed"), inst);
+        QVERIFY(!m_list->getInstanceByManagedName("pack7"));
+    }
+
+    void test_totalPlayTime()
+    {
+        // every instance has played as many seconds as its number
+        const qint64 expected = qint64(s_instanceCount) * (s_instanceCount - 1) / 2;
+        QCOMPARE(m_list->getTotalPlayTime(), int(expected));
+
+        auto inst = m_list->getInstanceById("inst42");
+        inst->settings()->set("totalTimePlayed", 1042);
+        emit inst->propertiesChanged(inst);
+        QCOMPARE(m_list->getTotalPlayTime(), int(expected + 1000));
+    }
+
+    void test_sessionPlayTime()
+    {
+        m_globalSettings->set("RecordGameTime", true);
+        auto inst = m_list->getInstanceById("inst43");
+        auto total = m_list->getTotalPlayTime();
+        auto played = inst->totalTimePlayed();
+
+        // in the order the launch task does it
+        inst->setRunning(true);
+        inst->setMinecraftRunning(true);
+        QTest::qWait(1100);
+        QVERIFY(m_list->getTotalPlayTime() > total);
+        inst->setMinecraftRunning(false);
+        inst->setRunning(false);
+
+        auto session = inst->totalTimePlayed() - played;
+        QVERIFY(session >= 1);
+        QCOMPARE(inst->settings()->get("totalTimePlayed").toLongLong(), played + session);
+        QCOMPARE(m_list->getTotalPlayTime(), int(total + session));
+
+        inst->resetTimePlayed();
+        QCOMPARE(m_list->getTotalPlayTime(), int(total - played));
+        m_globalSettings->set("RecordGameTime", false);
+    }
+
+    void test_applySettings()
+    {
+        QStringList ids;
+        for (int i = 0; i < 200; i++) {
+            ids.append(m_ids[i * 31]);
+        }
+        QSignalSpy dataChanged(m_list.get(), &InstanceList::dataChanged);
+        auto task = m_list->applySettings(ids, { { "notes", "retargeted" }, { "ManagedPackName", QVariant() } });
+        QSignalSpy succeeded(task.get(), &Task::succeeded);
+        task->start();
+        QVERIFY(succeeded.wait());
+
+        // one update for the whole batch
+        QCOMPARE(dataChanged.count(), 1);
+        for (auto& id : ids) {
+            auto inst = m_list->getInstanceById(id);
+            QCOMPARE(inst->notes(), QString("retargeted"));
+            INIFile written;
+            QVERIFY(written.loadFile(QDir(inst->instanceRoot()).filePath("instance.cfg")));
+            QCOMPARE(written.get("notes", QVariant()).toString(), QString("retargeted"));
+            QVERIFY(!written.contains("ManagedPackName"));
+        }
+        QVERIFY(!m_list->getInstanceByManagedName("pack31"));
+    }
+
+    void test_propertiesChangedStorm()
+    {
+        QBENCHMARK
+        {
+            for (int i = 0; i < m_list->count(); i++) {
+                auto inst = m_list->at(i);
+                emit inst->propertiesChanged(inst);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(InstanceListTest)
+
+#include "InstanceList_test.moc"
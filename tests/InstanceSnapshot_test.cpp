@@ -0,0 +1,194 @@
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+#include <BaseInstance.h>
+#include <FileSystem.h>
+#include <InstanceList.h>
+#include <InstanceSnapshot.h>
+#include <settings/INISettingsObject.h>
+
+class InstanceSnapshotTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_root;
+    std::unique_ptr<INISettingsObject> m_globalSettings;
+
+    static QString snapshotPath() { return QDir("cache").absoluteFilePath("instances.snapshot"); }
+
+    static bool writeInstance(const QString& instDir, const QString& id, const QString& name)
+    {
+        if (!QDir(instDir).mkpath(id))
+            return false;
+        QFile cfg(FS::PathCombine(instDir, id, "instance.cfg"));
+        if (!cfg.open(QFile::WriteOnly | QFile::Truncate))
+            return false;
+        return cfg.write(QString("ConfigVersion=1.3\nInstanceType=Test\nname=%1\n").arg(name).toUtf8()) > 0;
+    }
+
+    // a fresh instance folder with the instances 'ids', named after them
+    QString makeInstances(const QString& folder, const QStringList& ids)
+    {
+        auto instDir = m_root.filePath(folder);
+        for (auto& id : ids) {
+            if (!writeInstance(instDir, id, "Instance " + id))
+                return {};
+        }
+        return QDir(instDir).canonicalPath();
+    }
+
+    std::unique_ptr<InstanceList> loadList(const QString& instDir)
+    {
+        auto list = std::make_unique<InstanceList>(m_globalSettings.get(), instDir);
+        if (list->loadList() != InstanceList::NoError)
+            return {};
+        return list;
+    }
+
+    // load the list once, which takes the snapshot of it
+    bool takeSnapshot(const QString& instDir)
+    {
+        auto list = loadList(instDir);
+        if (!list)
+            return false;
+        list->saveNow();
+        return QFileInfo::exists(snapshotPath());
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_root.isValid());
+        QLoggingCategory::setFilterRules("default.debug=false\ndefault.info=false");
+        // the instance snapshot is kept relative to the working directory
+        QVERIFY(QDir::setCurrent(m_root.path()));
+
+        m_globalSettings = std::make_unique<INISettingsObject>(m_root.filePath("global.cfg"));
+        for (auto id : { "ShowGameTime", "RecordGameTime", "PreLaunchCommand", "WrapperCommand", "PostExitCommand", "ShowConsole",
+                         "AutoCloseConsole", "ShowConsoleOnError", "LogPrePostOutput", "ConsoleMaxLines", "ConsoleOverflowStop",
+                         "ConsoleUnlimitedScrollback" }) {
+            m_globalSettings->registerSetting(id, QVariant());
+        }
+    }
+
+    void cleanupTestCase() { m_globalSettings.reset(); }
+
+    void test_changed()
+    {
+        auto instDir = makeInstances("changed", { "a", "b", "c" });
+        QVERIFY(!instDir.isEmpty());
+        QVERIFY(takeSnapshot(instDir));
+
+        // 'b' is edited, 'a' is edited too but keeps its size and modification time, so it looks untouched
+        QVERIFY(writeInstance(instDir, "b", "Renamed b"));
+        QFile a(FS::PathCombine(instDir, "a", "instance.cfg"));
+        auto modified = QFileInfo(a).lastModified();
+        QVERIFY(a.open(QFile::ReadWrite));
+        auto contents = a.readAll().replace("Instance a", "Sneakily a");
+        QVERIFY(a.seek(0));
+        QCOMPARE(a.write(contents), qint64(contents.size()));
+        QVERIFY(a.flush());
+        QVERIFY(a.setFileTime(modified, QFileDevice::FileModificationTime));
+        a.close();
+
+        auto list = loadList(instDir);
+        QVERIFY(list);
+        QCOMPARE(list->count(), 3);
+        // the instances come from the snapshot, before anything was read from disk
+        auto b = list->getInstanceById("b");
+        QVERIFY(b);
+        QCOMPARE(b->name(), QString("Instance b"));
+
+        // the check reloads the instance that changed, in place
+        QTRY_COMPARE(b->name(), QString("Renamed b"));
+        QCOMPARE(list->getInstanceById("b"), b);
+        QCOMPARE(list->getInstanceById("a")->name(), QString("Instance a"));
+        QCOMPARE(list->getInstanceById("c")->name(), QString("Instance c"));
+        // so the snapshot isn't still being written by the next test
+        list->saveNow();
+    }
+
+    void test_addedAndRemoved()
+    {
+        auto instDir = makeInstances("added", { "a", "b", "c" });
+        QVERIFY(!instDir.isEmpty());
+        QVERIFY(takeSnapshot(instDir));
+
+        QVERIFY(QDir(FS::PathCombine(instDir, "c")).removeRecursively());
+        QVERIFY(writeInstance(instDir, "d", "Instance d"));
+
+        auto list = loadList(instDir);
+        QVERIFY(list);
+        QCOMPARE(list->count(), 3);
+        QVERIFY(list->getInstanceById("c"));
+        QVERIFY(!list->getInstanceById("d"));
+        auto a = list->getInstanceById("a");
+
+        QTRY_VERIFY(list->getInstanceById("d"));
+        QVERIFY(!list->getInstanceById("c"));
+        QCOMPARE(list->count(), 3);
+        QCOMPARE(list->getInstanceById("d")->name(), QString("Instance d"));
+        QCOMPARE(list->getInstanceById("a"), a);
+        QCOMPARE(list->getInstanceIndexById("d").data(InstanceList::InstanceIDRole).toString(), QString("d"));
+        list->saveNow();
+    }
+
+    void test_unusable_data()
+    {
+        QTest::addColumn<QString>("kind");
+        QTest::newRow("garbage") << "garbage";
+        QTest::newRow("truncated") << "truncated";
+        QTest::newRow("old version") << "old version";
+        QTest::newRow("other folder") << "other folder";
+    }
+
+    void test_unusable()
+    {
+        QFETCH(QString, kind);
+        auto instDir = makeInstances("unusable-" + kind, { "a", "b" });
+        QVERIFY(!instDir.isEmpty());
+        QVERIFY(takeSnapshot(instDir));
+
+        QByteArray data = FS::read(snapshotPath());
+        if (kind == "garbage") {
+            data = "this is not a snapshot";
+        } else if (kind == "truncated") {
+            data.chop(5);
+        } else if (kind == "old version") {
+            // the version follows the magic number, big endian
+            data[7] = 0;
+        } else {
+            QList<InstanceSnapshot::Entry> entries;
+            QVERIFY(InstanceSnapshot::load(snapshotPath(), instDir, entries));
+            QVERIFY(InstanceSnapshot::save(snapshotPath(), m_root.filePath("elsewhere"), entries));
+            data = FS::read(snapshotPath());
+        }
+        FS::write(snapshotPath(), data);
+        QList<InstanceSnapshot::Entry> entries;
+        QVERIFY(!InstanceSnapshot::load(snapshotPath(), instDir, entries));
+
+        // the snapshot is ignored and the folder is scanned, so the list is up to date right away
+        QVERIFY(writeInstance(instDir, "b", "Renamed b"));
+        QVERIFY(writeInstance(instDir, "c", "Instance c"));
+        auto list = loadList(instDir);
+        QVERIFY(list);
+        QCOMPARE(list->count(), 3);
+        QCOMPARE(list->getInstanceById("a")->name(), QString("Instance a"));
+        QCOMPARE(list->getInstanceById("b")->name(), QString("Renamed b"));
+        QCOMPARE(list->getInstanceById("c")->name(), QString("Instance c"));
+
+        // and a good snapshot is written over it
+        list->saveNow();
+        QVERIFY(InstanceSnapshot::load(snapshotPath(), instDir, entries));
+        QCOMPARE(entries.size(), 3);
+    }
+};
+
+QTEST_GUILESS_MAIN(InstanceSnapshotTest)
+
+#include "InstanceSnapshot_test.moc"
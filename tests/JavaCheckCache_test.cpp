@@ -0,0 +1,82 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <java/JavaCheckCache.h>
+
+class JavaCheckCacheTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_root;
+
+    QString writeBinary(const QString& name, const QByteArray& contents)
+    {
+        auto path = m_root.filePath(name);
+        QFile file(path);
+        if (!file.open(QFile::WriteOnly | QFile::Truncate))
+            return {};
+        file.write(contents);
+        return path;
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_root.isValid());
+        // the cache is kept relative to the working directory
+        QVERIFY(QDir::setCurrent(m_root.path()));
+    }
+
+    void test_roundTrip()
+    {
+        auto path = writeBinary("java", "#!/bin/sh\n");
+        auto identity = JavaCheckCache::identify(path);
+        QVERIFY(identity.isValid());
+
+        JavaChecker::Result result{ path, 3 };
+        QVERIFY(!JavaCheckCache::lookup(identity, result));
+
+        JavaChecker::Result checked{ path, 0 };
+        checked.validity = JavaChecker::Result::Validity::Valid;
+        checked.javaVersion = QString("21.0.2");
+        checked.javaVendor = "Eclipse Adoptium";
+        checked.realPlatform = "amd64";
+        checked.mojangPlatform = "64";
+        checked.is_64bit = true;
+        JavaCheckCache::store(identity, checked);
+        QVERIFY(QFile::exists(m_root.filePath("cache/javacheck.json")));
+
+        QVERIFY(JavaCheckCache::lookup(JavaCheckCache::identify(path), result));
+        QCOMPARE(result.id, 3);
+        QCOMPARE(result.path, path);
+        QCOMPARE(result.javaVersion.toString(), QString("21.0.2"));
+        QCOMPARE(result.javaVendor, QString("Eclipse Adoptium"));
+        QCOMPARE(result.realPlatform, QString("amd64"));
+        QVERIFY(result.is_64bit);
+        QVERIFY(result.validity == JavaChecker::Result::Validity::Valid);
+    }
+
+    void test_changedBinary()
+    {
+        auto path = writeBinary("java2", "#!/bin/sh\n");
+        JavaChecker::Result checked{ path, 0 };
+        checked.validity = JavaChecker::Result::Validity::Valid;
+        checked.javaVersion = QString("17.0.1");
+        JavaCheckCache::store(JavaCheckCache::identify(path), checked);
+
+        // an update replaces the binary
+        writeBinary("java2", "#!/bin/sh\nexec true\n");
+        JavaChecker::Result result{ path, 0 };
+        QVERIFY(!JavaCheckCache::lookup(JavaCheckCache::identify(path), result));
+    }
+
+    void test_missingBinary()
+    {
+        QVERIFY(!JavaCheckCache::identify(m_root.filePath("nothing-here")).isValid());
+    }
+};
+
+QTEST_GUILESS_MAIN(JavaCheckCacheTest)
+
+#include "JavaCheckCache_test.moc"
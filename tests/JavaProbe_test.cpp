@@ -0,0 +1,94 @@
+#include <QDir>
+#include <QFile>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <java/JavaChecker.h>
+
+class JavaProbeTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_root;
+
+    // just enough of an ELF header for the host architecture
+    static QByteArray elfHeader()
+    {
+        QByteArray header(64, '\0');
+        header.replace(0, 4, "\x7f" "ELF");
+        header[4] = 2;  // 64-bit
+        header[5] = 1;  // little endian
+        auto arch = QSysInfo::currentCpuArchitecture();
+        if (arch == "x86_64")
+            header[18] = char(0x3E);
+        else if (arch == "arm64")
+            header[18] = char(0xB7);
+        else
+            return {};
+        return header;
+    }
+
+    QString makeHome(const QString& name, const QByteArray& release, const QByteArray& binary)
+    {
+        QDir home(m_root.filePath(name));
+        if (!home.mkpath("bin"))
+            return {};
+        QFile releaseFile(home.filePath("release"));
+        if (!release.isNull() && (!releaseFile.open(QFile::WriteOnly) || releaseFile.write(release) != release.size()))
+            return {};
+        QFile java(home.filePath("bin/java"));
+        if (!java.open(QFile::WriteOnly) || java.write(binary) != binary.size())
+            return {};
+        return java.fileName();
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_root.isValid());
+#if !defined(Q_OS_LINUX)
+        QSKIP("The fake runtimes are ELF binaries");
+#endif
+        if (elfHeader().isEmpty())
+            QSKIP("No fake runtime for this architecture");
+    }
+
+    void test_release()
+    {
+        auto java = makeHome("jdk17", "IMPLEMENTOR=\"Eclipse Adoptium\"\nJAVA_VERSION=\"17.0.10\"\nOS_ARCH=\"x86_64\"\n", elfHeader());
+        QVERIFY(!java.isEmpty());
+
+        JavaChecker::Result result{ java, 0 };
+        QVERIFY(JavaChecker::probe(java, result));
+        QVERIFY(result.validity == JavaChecker::Result::Validity::Valid);
+        QCOMPARE(result.javaVersion.toString(), QString("17.0.10"));
+        QCOMPARE(result.javaVendor, QString("Eclipse Adoptium"));
+        QVERIFY(result.is_64bit);
+        QCOMPARE(result.mojangPlatform, QString("64"));
+        // the output tells where the result came from
+        QVERIFY(result.outLog.contains("jdk17/release"));
+        QVERIFY(result.outLog.contains("java.version=17.0.10\n"));
+    }
+
+    void test_inconclusive()
+    {
+        JavaChecker::Result result{ "", 0 };
+        // no vendor
+        auto java = makeHome("novendor", "JAVA_VERSION=\"1.8.0_392\"\n", elfHeader());
+        QVERIFY(!JavaChecker::probe(java, result));
+        QVERIFY(result.outLog.contains("does not name the Java version and vendor"));
+        // no release file
+        java = makeHome("norelease", QByteArray(), elfHeader());
+        QVERIFY(!JavaChecker::probe(java, result));
+        QVERIFY(result.outLog.contains("has no release file"));
+        // not a binary we can read
+        java = makeHome("script", "IMPLEMENTOR=\"Someone\"\nJAVA_VERSION=\"21\"\n", "#!/bin/sh\n");
+        QVERIFY(!JavaChecker::probe(java, result));
+        QVERIFY(result.outLog.contains("could not be read from its header"));
+        QVERIFY(result.validity == JavaChecker::Result::Validity::Errored);
+    }
+};
+
+QTEST_GUILESS_MAIN(JavaProbeTest)
+
+#include "JavaProbe_test.moc"
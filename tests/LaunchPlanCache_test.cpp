@@ -0,0 +1,123 @@
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/LaunchPlanCache.h>
+#include <minecraft/Library.h>
+#include <minecraft/MinecraftInstance.h>
+#include <minecraft/PackProfile.h>
+#include <settings/INISettingsObject.h>
+
+class LaunchPlanCacheTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_roundTrip()
+    {
+        QTemporaryDir root;
+        QVERIFY(root.isValid());
+        auto path = root.filePath("plans/inst.plan");
+
+        auto minecraft = std::make_shared<VersionFile>();
+        minecraft->uid = "net.minecraft";
+        minecraft->version = "1.20.1";
+        minecraft->name = "Minecraft";
+        minecraft->mainClass = "net.minecraft.client.main.Main";
+        minecraft->libraries.append(std::make_shared<Library>("com.mojang:brigadier:1.1.8"));
+
+        auto loader = std::make_shared<VersionFile>();
+        loader->uid = "net.fabricmc.fabric-loader";
+        loader->version = "0.15.7";
+        loader->mainClass = "net.fabricmc.loader.impl.launch.knot.KnotClient";
+        loader->addTweakers.append("some.Tweaker");
+
+        LaunchPlanCache::Plan plan;
+        plan.key = "key";
+        plan.created = 1234;
+        plan.files = { minecraft, loader };
+        QVERIFY(LaunchPlanCache::save(path, plan));
+
+        LaunchPlanCache::Plan loaded;
+        QVERIFY(LaunchPlanCache::load(path, loaded));
+        QCOMPARE(loaded.key, plan.key);
+        QCOMPARE(loaded.created, plan.created);
+        QCOMPARE(loaded.files.size(), 2);
+        // applied in the same order
+        QCOMPARE(loaded.files[0]->uid, minecraft->uid);
+        QCOMPARE(loaded.files[0]->mainClass, minecraft->mainClass);
+        QCOMPARE(loaded.files[0]->libraries.size(), 1);
+        QCOMPARE(loaded.files[0]->libraries[0]->rawName().serialize(), QString("com.mojang:brigadier:1.1.8"));
+        QCOMPARE(loaded.files[1]->uid, loader->uid);
+        QCOMPARE(loaded.files[1]->version, loader->version);
+        QCOMPARE(loaded.files[1]->addTweakers, loader->addTweakers);
+    }
+
+    void test_planSurvivesRuntimeContextChange()
+    {
+        QTemporaryDir root;
+        QVERIFY(root.isValid());
+        // plans are kept relative to the launcher's data directory
+        auto previousDir = QDir::currentPath();
+        QDir::setCurrent(root.path());
+
+        // the global settings an instance takes over
+        INISettingsObject global(root.filePath("global.cfg"));
+        for (auto id : { "ShowGameTime", "RecordGameTime", "PreLaunchCommand", "WrapperCommand", "PostExitCommand", "ShowConsole",
+                         "AutoCloseConsole", "ShowConsoleOnError", "LogPrePostOutput", "ConsoleMaxLines", "ConsoleOverflowStop",
+                         "ConsoleUnlimitedScrollback" })
+            global.registerSetting(id, QVariant());
+
+        auto instanceRoot = root.filePath("instance");
+        FS::write(FS::PathCombine(instanceRoot, "mmc-pack.json"),
+                  R"({ "formatVersion": 1, "components": [ { "uid": "net.minecraft", "version": "1.20.1" } ] })");
+        MinecraftInstance instance(&global, std::make_unique<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg")),
+                                   instanceRoot);
+        auto profile = instance.getPackProfile();
+        QVERIFY(profile->load());
+
+        auto minecraft = std::make_shared<VersionFile>();
+        minecraft->uid = "net.minecraft";
+        minecraft->version = "1.20.1";
+        minecraft->mainClass = "net.minecraft.client.main.Main";
+        minecraft->libraries.append(std::make_shared<Library>("com.mojang:brigadier:1.1.8"));
+
+        LaunchPlanCache::Plan plan;
+        plan.key = profile->launchPlanKey();
+        plan.created = QDateTime::currentMSecsSinceEpoch();
+        plan.files = { minecraft };
+        QVERIFY(LaunchPlanCache::save(QDir("cache/launchplans").absoluteFilePath(instance.id() + ".plan"), plan));
+
+        QVERIFY(profile->reloadFromLaunchPlan(Net::Mode::Offline));
+        // what CheckJava does right after loading, through MinecraftInstance::updateRuntimeContext()
+        profile->invalidateLaunchProfile();
+
+        auto launchProfile = profile->getProfile();
+        QVERIFY(launchProfile);
+        QCOMPARE(launchProfile->getMainClass(), minecraft->mainClass);
+        QCOMPARE(launchProfile->getLibraries().size(), 1);
+        QCOMPARE(launchProfile->getLibraries()[0]->rawName().serialize(), QString("com.mojang:brigadier:1.1.8"));
+
+        QDir::setCurrent(previousDir);
+    }
+
+    void test_broken()
+    {
+        QTemporaryDir root;
+        QVERIFY(root.isValid());
+        LaunchPlanCache::Plan plan;
+        QVERIFY(!LaunchPlanCache::load(root.filePath("missing.plan"), plan));
+
+        QFile file(root.filePath("garbage.plan"));
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write("not a plan");
+        file.close();
+        QVERIFY(!LaunchPlanCache::load(file.fileName(), plan));
+    }
+};
+
+QTEST_GUILESS_MAIN(LaunchPlanCacheTest)
+
+#include "LaunchPlanCache_test.moc"
@@ -0,0 +1,109 @@
+#include <QDir>
+#include <QTest>
+
+#include <launch/LogModel.h>
+
+class LogModelTest : public QObject {
+    Q_OBJECT
+
+    static MessageLevel levelOf(int i) { return i % 3 == 0 ? MessageLevel::Warning : MessageLevel::Info; }
+
+    static void fill(LogModel& model, int from, int to)
+    {
+        for (int i = from; i < to; i++) {
+            model.append(levelOf(i), QString("line %1").arg(i));
+        }
+    }
+
+    // the rows of the model hold the lines [first, first + count)
+    static void checkRows(const LogModel& model, int first, int count)
+    {
+        QCOMPARE(model.rowCount(), count);
+        for (int row = 0; row < count; row++) {
+            auto index = model.index(row);
+            QCOMPARE(model.data(index, Qt::DisplayRole).toString(), QString("line %1").arg(first + row));
+            QCOMPARE(model.data(index, LogModel::LevelRole).toInt(), static_cast<int>(levelOf(first + row)));
+        }
+    }
+
+   private slots:
+    void test_spill()
+    {
+        LogModel model;
+        model.setMaxLines(5);
+        model.setUnlimitedScrollback(true);
+        fill(model, 0, 5);
+        checkRows(model, 0, 5);
+
+        // past the window the oldest lines go to disk, every row stays
+        fill(model, 5, 100);
+        checkRows(model, 0, 100);
+        QCOMPARE(static_cast<int>(model.previousLevel()), static_cast<int>(levelOf(99)));
+        QVERIFY(model.toPlainText().startsWith("line 0\nline 1\n"));
+        QVERIFY(model.toPlainText().endsWith("line 98\nline 99\n"));
+        QVERIFY(!model.isOverFlow());
+
+        model.clear();
+        QCOMPARE(model.rowCount(), 0);
+        fill(model, 0, 8);
+        checkRows(model, 0, 8);
+    }
+
+    void test_shrinkWhileSpilled()
+    {
+        LogModel model;
+        model.setMaxLines(10);
+        model.setUnlimitedScrollback(true);
+        fill(model, 0, 23);
+
+        // the lines that don't fit in the smaller window are spilled as well
+        model.setMaxLines(4);
+        checkRows(model, 0, 23);
+        fill(model, 23, 30);
+        checkRows(model, 0, 30);
+
+        // and it grows again without losing any
+        model.setMaxLines(8);
+        fill(model, 30, 40);
+        checkRows(model, 0, 40);
+    }
+
+    void test_shrinkWithoutScrollback()
+    {
+        LogModel model;
+        model.setMaxLines(10);
+        fill(model, 0, 7);
+
+        // without the scrollback the oldest lines are dropped
+        model.setMaxLines(4);
+        checkRows(model, 3, 4);
+        fill(model, 7, 9);
+        checkRows(model, 5, 4);
+    }
+
+    void test_scrollbackUnavailable()
+    {
+#if !defined(Q_OS_UNIX)
+        QSKIP("The temporary folder is moved through TMPDIR");
+#endif
+        auto tmpdir = qgetenv("TMPDIR");
+        qputenv("TMPDIR", QDir::current().filePath("does-not-exist/either").toUtf8());
+        LogModel model;
+        model.setMaxLines(5);
+        model.setUnlimitedScrollback(true);
+        fill(model, 0, 20);
+        if (tmpdir.isNull()) {
+            qunsetenv("TMPDIR");
+        } else {
+            qputenv("TMPDIR", tmpdir);
+        }
+
+        // lines can't be spilled, so the oldest are dropped like without the scrollback
+        checkRows(model, 15, 5);
+        QCOMPARE(static_cast<int>(model.previousLevel()), static_cast<int>(levelOf(19)));
+    }
+};
+
+QTEST_GUILESS_MAIN(LogModelTest)
+
+#include "LogModel_test.moc"
@@ -0,0 +1,166 @@
+#include <QSignalSpy>
+#include <QTest>
+
+#include <launch/LogModel.h>
+#include <launch/LogSearch.h>
+
+class LogSearchTest : public QObject {
+    Q_OBJECT
+
+    static QList<int> search(LogSearch& logSearch, const LogSearch::Query& query)
+    {
+        QSignalSpy finished(&logSearch, &LogSearch::finished);
+        logSearch.start(query);
+        if (finished.isEmpty()) {
+            finished.wait();
+        }
+        return logSearch.matchingRows();
+    }
+
+   private slots:
+    void test_caseFolding()
+    {
+        LogSearch logSearch;
+        logSearch.lineAppended(MessageLevel::Info, "Loading Minecraft 1.20.1");
+        logSearch.lineAppended(MessageLevel::Info, "LOADING mods");
+        logSearch.lineAppended(MessageLevel::Warning, "Über den Wolken");
+        logSearch.lineAppended(MessageLevel::Info, "nothing to see here");
+
+        QCOMPARE(search(logSearch, { "loading", {} }), QList<int>({ 0, 1 }));
+        QCOMPARE(search(logSearch, { "MINECRAFT", {} }), QList<int>({ 0 }));
+        QCOMPARE(search(logSearch, { "über", {} }), QList<int>({ 2 }));
+        QCOMPARE(search(logSearch, { "ÜBER DEN", {} }), QList<int>({ 2 }));
+        QCOMPARE(search(logSearch, { "", { MessageLevel::Warning } }), QList<int>({ 2 }));
+        QCOMPARE(search(logSearch, { "loading", { MessageLevel::Warning } }), QList<int>());
+    }
+
+    void test_lineBreaks()
+    {
+        LogSearch logSearch;
+        logSearch.lineAppended(MessageLevel::Error, "Exception in thread \"main\"\n\tat Main.main(Main.java:1)");
+        logSearch.lineAppended(MessageLevel::Info, "at");
+
+        // a match may span the line breaks within one line of the model, but never two lines
+        QCOMPARE(search(logSearch, { "\"main\" \tat", {} }), QList<int>({ 0 }));
+        QCOMPARE(search(logSearch, { ":1) at", {} }), QList<int>());
+    }
+
+    void test_wraparound()
+    {
+        LogSearch logSearch;
+        for (int i = 0; i < 10; i++) {
+            logSearch.lineAppended(MessageLevel::Info, i % 3 == 0 ? "match" : "other");
+        }
+        QCOMPARE(search(logSearch, { "match", {} }), QList<int>({ 0, 3, 6, 9 }));
+
+        QCOMPARE(logSearch.nextMatch(0, false), 3);
+        QCOMPARE(logSearch.nextMatch(4, false), 6);
+        QCOMPARE(logSearch.nextMatch(9, false), 0);
+        QCOMPARE(logSearch.nextMatch(9, true), 6);
+        QCOMPARE(logSearch.nextMatch(0, true), 9);
+        // nothing to go to
+        search(logSearch, { "match", { MessageLevel::Error } });
+        QCOMPARE(logSearch.nextMatch(0, false), -1);
+    }
+
+    void test_liveMatches()
+    {
+        LogSearch logSearch;
+        logSearch.lineAppended(MessageLevel::Info, "first match");
+        QCOMPARE(search(logSearch, { "match", {} }), QList<int>({ 0 }));
+
+        QSignalSpy found(&logSearch, &LogSearch::matchesFound);
+        logSearch.lineAppended(MessageLevel::Info, "no");
+        logSearch.lineAppended(MessageLevel::Info, "MATCH again");
+        QCOMPARE(found.count(), 1);
+        QCOMPARE(found.first().first().value<QList<int>>(), QList<int>({ 2 }));
+        QCOMPARE(logSearch.matchingRows(), QList<int>({ 0, 2 }));
+    }
+
+    void test_rowMapping()
+    {
+        // the search follows the rows of the model while the oldest lines are dropped
+        LogModel model;
+        model.setMaxLines(5);
+        auto logSearch = model.search();
+        for (int i = 0; i < 5000; i++) {
+            model.append(MessageLevel::Info, QString("line %1%2").arg(i).arg(i % 7 == 0 ? " needle" : ""));
+        }
+        QCOMPARE(model.rowCount(), 5);
+
+        auto rows = search(*logSearch, { "NEEDLE", {} });
+        QVERIFY(!rows.isEmpty());
+        for (int row = 0; row < model.rowCount(); row++) {
+            auto line = model.data(model.index(row), Qt::DisplayRole).toString();
+            QCOMPARE(rows.contains(row), line.contains("needle"));
+        }
+
+        for (int i = 5000; i < 5010; i++) {
+            model.append(MessageLevel::Info, QString("line %1%2").arg(i).arg(i % 7 == 0 ? " needle" : ""));
+        }
+        rows = logSearch->matchingRows();
+        for (int row = 0; row < model.rowCount(); row++) {
+            auto line = model.data(model.index(row), Qt::DisplayRole).toString();
+            QCOMPARE(rows.contains(row), line.contains("needle"));
+        }
+        // and nothing from before the window
+        for (auto row : rows) {
+            QVERIFY(row >= 0 && row < model.rowCount());
+        }
+    }
+
+    void test_scrollback()
+    {
+        // lines past the window are spilled to disk, they keep their rows and are searched there
+        LogModel model;
+        model.setMaxLines(5);
+        model.setUnlimitedScrollback(true);
+        auto text = [](int i) { return QString("line %1%2").arg(i).arg(i % 7 == 0 ? " needle" : ""); };
+        for (int i = 0; i < 20; i++) {
+            model.append(i % 2 ? MessageLevel::Warning : MessageLevel::Info, text(i));
+        }
+        QCOMPARE(model.rowCount(), 20);
+
+        auto checkRows = [&model](const QList<int>& rows) {
+            for (int row = 0; row < model.rowCount(); row++) {
+                auto line = model.data(model.index(row), Qt::DisplayRole).toString();
+                QCOMPARE(rows.contains(row), line.contains("needle"));
+            }
+        };
+        auto logSearch = model.search();
+        auto rows = search(*logSearch, { "NEEDLE", {} });
+        QCOMPARE(rows, QList<int>({ 0, 7, 14 }));
+        QCOMPARE(search(*logSearch, { "needle", { MessageLevel::Warning } }), QList<int>({ 7 }));
+        QCOMPARE(search(*logSearch, { "line 1", {} }), QList<int>({ 1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 }));
+
+        // matched live while they spill
+        search(*logSearch, { "needle", {} });
+        for (int i = 20; i < 30; i++) {
+            model.append(MessageLevel::Info, text(i));
+        }
+        checkRows(logSearch->matchingRows());
+        QCOMPARE(logSearch->nextMatch(14, false), 21);
+        QCOMPARE(logSearch->nextMatch(0, true), 28);
+
+        // without the scrollback, the oldest lines in memory are dropped, after the ones on disk
+        model.setUnlimitedScrollback(false);
+        for (int i = 30; i < 40; i++) {
+            model.append(MessageLevel::Info, text(i));
+        }
+        QCOMPARE(model.rowCount(), 30);
+        checkRows(logSearch->matchingRows());
+        checkRows(search(*logSearch, { "needle", {} }));
+
+        // and spilled again after that gap
+        model.setUnlimitedScrollback(true);
+        for (int i = 40; i < 50; i++) {
+            model.append(MessageLevel::Info, text(i));
+        }
+        checkRows(logSearch->matchingRows());
+        checkRows(search(*logSearch, { "needle", {} }));
+    }
+};
+
+QTEST_GUILESS_MAIN(LogSearchTest)
+
+#include "LogSearch_test.moc"
@@ -0,0 +1,166 @@
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <archive/ArchiveWriter.h>
+#include <modplatform/ModpackUpdatePrefetcher.h>
+
+class ModpackUpdatePrefetcherTest : public QObject {
+    Q_OBJECT
+
+    static QByteArray modrinthIndex(const QStringList& sha512s)
+    {
+        QByteArray files;
+        for (auto& sha512 : sha512s) {
+            if (!files.isEmpty())
+                files += ",";
+            files += QString(R"({ "path": "mods/%1.jar", "hashes": { "sha512": "%1" }, )"
+                             R"("downloads": [ "https://cdn.modrinth.com/%1.jar" ] })")
+                         .arg(sha512)
+                         .toUtf8();
+        }
+        return R"({ "formatVersion": 1, "files": [ )" + files + " ] }";
+    }
+
+    static QByteArray flameManifest(const QList<int>& fileIds)
+    {
+        QByteArray files;
+        for (auto fileId : fileIds) {
+            if (!files.isEmpty())
+                files += ",";
+            files += QString(R"({ "projectID": 1, "fileID": %1, "required": true })").arg(fileId).toUtf8();
+        }
+        return R"({ "manifestType": "minecraftModpack", "files": [ )" + files + " ] }";
+    }
+
+    static bool writeFile(const QString& path, const QByteArray& data)
+    {
+        QFile file(path);
+        return FS::ensureFilePathExists(path) && file.open(QFile::WriteOnly) && file.write(data) == data.size();
+    }
+
+    static bool writePack(const QString& path, const QString& fileName, const QByteArray& data)
+    {
+        MMCZip::ArchiveWriter pack(path);
+        return pack.open() && pack.addFile(fileName, data) && pack.close();
+    }
+
+   private slots:
+    void test_modrinthFiles()
+    {
+        auto index = QByteArray(R"({
+            "formatVersion": 1,
+            "files": [
+                {
+                    "path": "mods/sodium.jar",
+                    "hashes": { "sha1": "aa", "sha512": "0102" },
+                    "downloads": [ "https://cdn.modrinth.com/sodium.jar", "https://mirror.example/sodium.jar" ]
+                },
+                {
+                    "path": "mods/server-only.jar",
+                    "hashes": { "sha512": "0304" },
+                    "env": { "client": "unsupported", "server": "required" },
+                    "downloads": [ "https://cdn.modrinth.com/server-only.jar" ]
+                },
+                {
+                    "path": "mods/optional.jar",
+                    "hashes": { "sha512": "0506" },
+                    "env": { "client": "optional", "server": "optional" },
+                    "downloads": [ "https://cdn.modrinth.com/optional.jar" ]
+                },
+                {
+                    "path": "mods/no-download.jar",
+                    "hashes": { "sha512": "0708" },
+                    "downloads": []
+                }
+            ]
+        })");
+
+        auto files = ModpackUpdatePrefetcher::modrinthFiles(index);
+        // files the client doesn't use and files without a link are never downloaded
+        QCOMPARE(files.size(), 2);
+
+        QCOMPARE(files[0].key, ModpackUpdatePrefetcher::modrinthKey(QByteArray::fromHex("0102")));
+        QCOMPARE(files[0].key, QString("modrinth/0102"));
+        QCOMPARE(files[0].url, QUrl("https://cdn.modrinth.com/sodium.jar"));
+        QCOMPARE(files[0].algorithm, QCryptographicHash::Sha512);
+        QCOMPARE(files[0].hash, QByteArray::fromHex("0102"));
+
+        QCOMPARE(files[1].key, QString("modrinth/0506"));
+    }
+
+    void test_flameFiles()
+    {
+        auto manifest = QByteArray(R"({
+            "manifestType": "minecraftModpack",
+            "files": [
+                { "projectID": 238222, "fileID": 4593548, "required": true },
+                { "projectID": 32274, "fileID": 4592000, "required": false },
+                { "projectID": 1 }
+            ]
+        })");
+
+        QCOMPARE(ModpackUpdatePrefetcher::flameFiles(manifest), QList<int>({ 4593548, 4592000 }));
+        QCOMPARE(ModpackUpdatePrefetcher::flameKey(4593548), QString("flame/4593548"));
+    }
+
+    void test_changedModrinthFiles()
+    {
+        QTemporaryDir dir;
+        auto root = FS::PathCombine(dir.path(), "instance");
+        QVERIFY(writeFile(FS::PathCombine(root, "mrpack", "modrinth.index.json"), modrinthIndex({ "0102", "0304" })));
+        auto pack = FS::PathCombine(dir.path(), "update.mrpack");
+        QVERIFY(writePack(pack, "modrinth.index.json", modrinthIndex({ "0102", "0506", "0708" })));
+
+        QStringList keys;
+        for (auto& file : ModpackUpdatePrefetcher::changedModrinthFiles(root, pack))
+            keys.append(file.key);
+        QCOMPARE(keys, QStringList({ "modrinth/0506", "modrinth/0708" }));
+
+        // nothing installed yet, everything is new
+        QCOMPARE(ModpackUpdatePrefetcher::changedModrinthFiles(FS::PathCombine(dir.path(), "missing"), pack).size(), 3);
+        // no pack, nothing to fetch
+        QVERIFY(ModpackUpdatePrefetcher::changedModrinthFiles(root, FS::PathCombine(dir.path(), "missing.mrpack")).isEmpty());
+    }
+
+    void test_changedFlameFiles()
+    {
+        QTemporaryDir dir;
+        auto root = FS::PathCombine(dir.path(), "instance");
+        QVERIFY(writeFile(FS::PathCombine(root, "flame", "manifest.json"), flameManifest({ 10, 20 })));
+        auto pack = FS::PathCombine(dir.path(), "update.zip");
+        QVERIFY(writePack(pack, "manifest.json", flameManifest({ 20, 30, 40 })));
+
+        QCOMPARE(ModpackUpdatePrefetcher::changedFlameFiles(root, pack), QList<int>({ 30, 40 }));
+    }
+
+    void test_pruneFiles()
+    {
+        QTemporaryDir dir;
+        for (auto key : { "modrinth/0102", "modrinth/0506", "flame/42", "flame/43" })
+            QVERIFY(writeFile(FS::PathCombine(dir.path(), key), "data"));
+
+        auto pruned = ModpackUpdatePrefetcher::pruneFiles(dir.path(), { "modrinth/0506", "flame/43" });
+        pruned.sort();
+        QCOMPARE(pruned, QStringList({ "flame/42", "modrinth/0102" }));
+
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(dir.path(), "modrinth/0102")));
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(dir.path(), "flame/42")));
+        QVERIFY(QFileInfo::exists(FS::PathCombine(dir.path(), "modrinth/0506")));
+        QVERIFY(QFileInfo::exists(FS::PathCombine(dir.path(), "flame/43")));
+
+        // everything wanted, nothing goes
+        QVERIFY(ModpackUpdatePrefetcher::pruneFiles(dir.path(), { "modrinth/0506", "flame/43" }).isEmpty());
+    }
+
+    void test_invalid()
+    {
+        QVERIFY(ModpackUpdatePrefetcher::modrinthFiles("").isEmpty());
+        QVERIFY(ModpackUpdatePrefetcher::flameFiles("not json").isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(ModpackUpdatePrefetcherTest)
+
+#include "ModpackUpdatePrefetcher_test.moc"
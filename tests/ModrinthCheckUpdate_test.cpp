@@ -0,0 +1,88 @@
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <Json.h>
+#include <modplatform/modrinth/ModrinthCheckUpdate.h>
+
+// testdata/ModrinthCheckUpdate holds a response of the Modrinth /version_files/update endpoint, cut down to the fields that are read
+class ModrinthCheckUpdateTest : public QObject {
+    Q_OBJECT
+
+    static QJsonObject loadResponse(const QString& name)
+    {
+        auto path = QFINDTESTDATA("testdata/ModrinthCheckUpdate/" + name);
+        return QJsonDocument::fromJson(FS::read(path)).object();
+    }
+
+   private slots:
+    void test_loadVersions()
+    {
+        auto versions = ModrinthCheckUpdate::loadVersions(loadResponse("update.json"), "sha512", "");
+        // the version without a file to download is left out
+        QCOMPARE(versions.size(), 2);
+
+        auto fabricApi = versions["aaaa"];
+        QCOMPARE(fabricApi.addonId.toString(), QString("P7dR8mSH"));
+        QCOMPARE(fabricApi.version_number, QString("0.92.1+1.20.1"));
+        QCOMPARE(fabricApi.hash, QString("bbbb"));
+        QVERIFY(fabricApi.is_preferred);
+
+        // the primary file, unless another one is for the loader asked for
+        QCOMPARE(versions["cccc"].fileName, QString("sodium-forge-0.5.8.jar"));
+        QVERIFY(!versions.contains("ffff"));
+    }
+
+    void test_loadVersionsForLoader()
+    {
+        auto versions = ModrinthCheckUpdate::loadVersions(loadResponse("update.json"), "sha512", "fabric");
+
+        auto sodium = versions["cccc"];
+        QCOMPARE(sodium.fileName, QString("sodium-fabric-0.5.8.jar"));
+        QCOMPARE(sodium.hash, QString("eeee"));
+    }
+
+    void test_firstLoaderWins()
+    {
+        auto response = loadResponse("update.json");
+        auto request = [](std::optional<ModPlatform::ModLoaderTypes> loader, const QJsonObject& response, bool succeeded) {
+            ModrinthCheckUpdate::LoaderRequest request;
+            request.loader = loader;
+            *request.response = QJsonDocument(response).toJson();
+            request.succeeded = succeeded;
+            return request;
+        };
+        // a failed request and one that wasn't sent, then forge, which only knows sodium, then fabric, which knows both
+        QList<ModrinthCheckUpdate::LoaderRequest> requests{
+            request(ModPlatform::NeoForge, response, false),
+            request(ModPlatform::Quilt, {}, false),
+            request(ModPlatform::Forge, QJsonObject{ { "cccc", response.value("cccc") } }, true),
+            request(ModPlatform::Fabric, response, true),
+        };
+
+        auto parsed = ModrinthCheckUpdate::parseResponses(requests, "sha512");
+        QVERIFY(parsed.error.isEmpty());
+        // every request keeps its place
+        QCOMPARE(parsed.versions.size(), 4);
+        QVERIFY(parsed.versions[0].isEmpty());
+        QVERIFY(parsed.versions[1].isEmpty());
+        QCOMPARE(parsed.versions[2].keys(), QList<QString>({ "cccc" }));
+        QCOMPARE(parsed.versions[3].size(), 2);
+
+        auto versions = ModrinthCheckUpdate::firstVersions(parsed);
+        QCOMPARE(versions.size(), 2);
+        QCOMPARE(versions["cccc"].fileName, QString("sodium-forge-0.5.8.jar"));
+        QCOMPARE(versions["aaaa"].version_number, QString("0.92.1+1.20.1"));
+    }
+
+    void test_malformedResponse()
+    {
+        QJsonObject response{ { "aaaa", QJsonObject{ { "id", "v2" } } } };
+        QVERIFY_THROWS_EXCEPTION(Json::JsonException, ModrinthCheckUpdate::loadVersions(response, "sha512", ""));
+    }
+};
+
+QTEST_GUILESS_MAIN(ModrinthCheckUpdateTest)
+
+#include "ModrinthCheckUpdate_test.moc"
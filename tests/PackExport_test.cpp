@@ -0,0 +1,195 @@
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtConcurrentMap>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+#include <archive/ArchiveReader.h>
+#include <archive/ExportToZipTask.h>
+#include <modplatform/helpers/HashUtils.h>
+
+class PackExportTest : public QObject {
+    Q_OBJECT
+
+    static constexpr int s_modCount = 500;
+    static constexpr int s_modSize = 64 * 1024;
+
+    static void writeFile(const QString& path, const QByteArray& data)
+    {
+        FS::ensureFilePathExists(path);
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(data);
+    }
+
+    static QFileInfoList listFiles(const QDir& root)
+    {
+        QFileInfoList files;
+        MMCZip::collectFileListRecursively(root.path(), nullptr, &files, nullptr);
+        return files;
+    }
+
+    static QStringList zipContents(const QString& path)
+    {
+        MMCZip::ArchiveReader reader(path);
+        if (!reader.collectFiles())
+            return {};
+        auto files = reader.getFiles();
+        files.sort();
+        return files;
+    }
+
+    QTemporaryDir m_instance;
+    QStringList m_mods;
+
+   private slots:
+    // a synthetic instance, with the mods of a large pack and some config
+    void initTestCase()
+    {
+        QVERIFY(m_instance.isValid());
+        QDir root(m_instance.path());
+        QByteArray data(s_modSize, Qt::Uninitialized);
+        for (int i = 0; i < s_modCount; i++) {
+            QRandomGenerator(i).fillRange(reinterpret_cast<quint32*>(data.data()), data.size() / sizeof(quint32));
+            auto relative = QString("mods/mod%1.jar").arg(i);
+            writeFile(root.filePath(relative), data);
+            m_mods << relative;
+        }
+        for (int i = 0; i < 50; i++)
+            writeFile(root.filePath(QString("config/mod%1.toml").arg(i)), QByteArray("enabled = true\n").repeated(100));
+    }
+
+    void test_hashSharesReads()
+    {
+        auto path = QDir(m_instance.path()).filePath(m_mods.first());
+        auto hashes = Hashing::hash(path, { Hashing::Algorithm::Sha512, Hashing::Algorithm::Sha1, Hashing::Algorithm::Murmur2 });
+        QCOMPARE(hashes, QStringList({ Hashing::hash(path, Hashing::Algorithm::Sha512), Hashing::hash(path, Hashing::Algorithm::Sha1),
+                                       Hashing::hash(path, Hashing::Algorithm::Murmur2) }));
+
+        QCOMPARE(Hashing::hash(QDir(m_instance.path()).filePath("missing.jar"), { Hashing::Algorithm::Sha1 }), QStringList({ "" }));
+    }
+
+    void test_deferredFiles_data()
+    {
+        QTest::addColumn<bool>("completeEarly");
+        QTest::newRow("complete while writing") << true;
+        QTest::newRow("complete after writing") << false;
+    }
+
+    void test_deferredFiles()
+    {
+        QFETCH(bool, completeEarly);
+
+        QTemporaryDir out;
+        auto output = out.filePath("pack.zip");
+        QDir root(m_instance.path());
+        MMCZip::ExportToZipTask task(output, root, listFiles(root), "overrides/");
+        task.setDeferredFiles(m_mods);
+        QSignalSpy succeeded(&task, &Task::succeeded);
+
+        task.start();
+        if (completeEarly) {
+            task.complete(m_mods.mid(1), { { "index.json", "{}" } });
+        } else {
+            QTest::qWait(500);
+            QVERIFY(task.isRunning());
+            task.complete(m_mods.mid(1), { { "index.json", "{}" } });
+        }
+        QVERIFY(succeeded.wait(10000));
+
+        auto contents = zipContents(output);
+        QVERIFY(contents.contains("index.json"));
+        QVERIFY(contents.contains("overrides/config/mod0.toml"));
+        QVERIFY(contents.contains("overrides/" + m_mods.first()));
+        QVERIFY(!contents.contains("overrides/" + m_mods.last()));
+        QCOMPARE(contents.size(), 1 + 50 + 1);
+    }
+
+    void test_abortWhileWaiting()
+    {
+        QTemporaryDir out;
+        auto output = out.filePath("pack.zip");
+        QDir root(m_instance.path());
+        MMCZip::ExportToZipTask task(output, root, listFiles(root), "overrides/");
+        task.setDeferredFiles(m_mods);
+        QSignalSpy aborted(&task, &Task::aborted);
+
+        task.start();
+        QTest::qWait(500);
+        QVERIFY(task.abort());
+        QVERIFY(aborted.count() == 1 || aborted.wait(10000));
+        QVERIFY(!QFile::exists(output));
+    }
+
+    void benchmark_hashing_data()
+    {
+        QTest::addColumn<bool>("parallel");
+        QTest::newRow("sequential") << false;
+        QTest::newRow("parallel") << true;
+    }
+
+    void benchmark_hashing()
+    {
+        QFETCH(bool, parallel);
+
+        QStringList paths;
+        for (auto& mod : m_mods)
+            paths << QDir(m_instance.path()).filePath(mod);
+        auto hashFile = [](const QString& path) { return Hashing::hash(path, { Hashing::Algorithm::Sha512, Hashing::Algorithm::Sha1 }); };
+
+        QBENCHMARK
+        {
+            if (parallel) {
+                QtConcurrent::blockingMapped(paths, hashFile);
+            } else {
+                for (auto& path : paths)
+                    hashFile(path);
+            }
+        }
+    }
+
+    // how an export spends its time: the files to look up are hashed, and the archive written before or while that happens
+    void benchmark_export_data()
+    {
+        QTest::addColumn<bool>("overlapped");
+        QTest::newRow("hash then zip") << false;
+        QTest::newRow("zip while hashing") << true;
+    }
+
+    void benchmark_export()
+    {
+        QFETCH(bool, overlapped);
+
+        QTemporaryDir out;
+        QDir root(m_instance.path());
+        auto files = listFiles(root);
+        auto hashFile = [&root](const QString& relative) {
+            return Hashing::hash(root.filePath(relative), { Hashing::Algorithm::Sha512, Hashing::Algorithm::Sha1 });
+        };
+
+        QBENCHMARK
+        {
+            MMCZip::ExportToZipTask task(out.filePath("pack.zip"), root, files, "overrides/");
+            QSignalSpy finished(&task, &Task::finished);
+            if (overlapped) {
+                task.setDeferredFiles(m_mods);
+                task.start();
+                QtConcurrent::blockingMapped(m_mods, hashFile);
+                task.complete(m_mods, { { "index.json", "{}" } });
+            } else {
+                QtConcurrent::blockingMapped(m_mods, hashFile);
+                task.setExcludeFiles(m_mods);
+                task.addExtraFile("index.json", "{}");
+                task.start();
+            }
+            QVERIFY(finished.wait(60000));
+            QVERIFY(task.wasSuccessful());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PackExportTest)
+
+#include "PackExport_test.moc"
@@ -13,10 +13,288 @@
  * limitations under the License.
  */
 
+#include <QRandomGenerator>
 #include <QTest>
 
+#include <algorithm>
+#include <iterator>
+
 #include <Version.h>
 
+namespace {
+// Version as it was before it was parsed into compact sections, to check that the ordering did not change
+class LegacyVersion {
+   public:
+    LegacyVersion(QString str) : m_string(std::move(str)) { parse(); }
+    LegacyVersion() = default;
+
+    bool operator<(const LegacyVersion& other) const;
+    bool operator<=(const LegacyVersion& other) const;
+    bool operator>(const LegacyVersion& other) const;
+    bool operator>=(const LegacyVersion& other) const;
+    bool operator==(const LegacyVersion& other) const;
+    bool operator!=(const LegacyVersion& other) const;
+
+    QString toString() const { return m_string; }
+    bool isEmpty() const { return m_string.isEmpty(); }
+
+   private:
+    struct Section {
+        explicit Section(QString fullString) : m_fullString(std::move(fullString))
+        {
+            qsizetype cutoff = m_fullString.size();
+            for (int i = 0; i < m_fullString.size(); i++) {
+                if (!m_fullString[i].isDigit()) {
+                    cutoff = i;
+                    break;
+                }
+            }
+
+            auto numPart = QStringView{ m_fullString }.left(cutoff);
+
+            if (!numPart.isEmpty()) {
+                m_isNull = false;
+                m_numPart = numPart.toInt();
+            }
+
+            auto stringPart = QStringView{ m_fullString }.mid(cutoff);
+
+            if (!stringPart.isEmpty()) {
+                m_isNull = false;
+                m_stringPart = stringPart.toString();
+            }
+        }
+
+        explicit Section() = default;
+
+        bool m_isNull = true;
+
+        int m_numPart = 0;
+        QString m_stringPart;
+
+        QString m_fullString;
+
+        inline bool isAppendix() const { return m_stringPart.startsWith('+'); }
+        inline bool isPreRelease() const { return m_stringPart.startsWith('-') && m_stringPart.length() > 1; }
+
+        inline bool operator==(const Section& other) const
+        {
+            if (m_isNull && !other.m_isNull)
+                return false;
+            if (!m_isNull && other.m_isNull)
+                return false;
+
+            if (!m_isNull && !other.m_isNull) {
+                return (m_numPart == other.m_numPart) && (m_stringPart == other.m_stringPart);
+            }
+
+            return true;
+        }
+
+        inline bool operator<(const Section& other) const
+        {
+            static auto unequal_is_less = [](Section const& non_null) -> bool {
+                if (non_null.m_stringPart.isEmpty())
+                    return non_null.m_numPart == 0;
+                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.isPreRelease();
+            };
+
+            if (!m_isNull && other.m_isNull)
+                return unequal_is_less(*this);
+            if (m_isNull && !other.m_isNull)
+                return !unequal_is_less(other);
+
+            if (!m_isNull && !other.m_isNull) {
+                if (m_numPart < other.m_numPart)
+                    return true;
+                if (m_numPart == other.m_numPart && m_stringPart < other.m_stringPart)
+                    return true;
+
+                if (!m_stringPart.isEmpty() && other.m_stringPart.isEmpty())
+                    return false;
+                if (m_stringPart.isEmpty() && !other.m_stringPart.isEmpty())
+                    return true;
+
+                return false;
+            }
+
+            return m_fullString < other.m_fullString;
+        }
+
+        inline bool operator!=(const Section& other) const { return !(*this == other); }
+        inline bool operator>(const Section& other) const { return !(*this < other || *this == other); }
+    };
+
+   private:
+    QString m_string;
+    QList<Section> m_sections;
+
+    void parse();
+};
+
+#define LEGACY_VERSION_OPERATOR(return_on_different)                                               \
+    bool exclude_our_sections = false;                                                      \
+    bool exclude_their_sections = false;                                                    \
+                                                                                            \
+    const auto size = qMax(m_sections.size(), other.m_sections.size());                     \
+    for (int i = 0; i < size; ++i) {                                                        \
+        Section sec1 = (i >= m_sections.size()) ? Section() : m_sections.at(i);             \
+        Section sec2 = (i >= other.m_sections.size()) ? Section() : other.m_sections.at(i); \
+                                                                                            \
+        { /* Don't include appendixes in the comparison */                                  \
+            if (sec1.isAppendix())                                                          \
+                exclude_our_sections = true;                                                \
+            if (sec2.isAppendix())                                                          \
+                exclude_their_sections = true;                                              \
+                                                                                            \
+            if (exclude_our_sections) {                                                     \
+                sec1 = Section();                                                           \
+                if (sec2.m_isNull)                                                          \
+                    break;                                                                  \
+            }                                                                               \
+                                                                                            \
+            if (exclude_their_sections) {                                                   \
+                sec2 = Section();                                                           \
+                if (sec1.m_isNull)                                                          \
+                    break;                                                                  \
+            }                                                                               \
+        }                                                                                   \
+                                                                                            \
+        if (sec1 != sec2)                                                                   \
+            return return_on_different;                                                     \
+    }
+
+bool LegacyVersion::operator<(const LegacyVersion& other) const
+{
+    LEGACY_VERSION_OPERATOR(sec1 < sec2)
+
+    return false;
+}
+bool LegacyVersion::operator==(const LegacyVersion& other) const
+{
+    LEGACY_VERSION_OPERATOR(false)
+
+    return true;
+}
+bool LegacyVersion::operator!=(const LegacyVersion& other) const
+{
+    return !operator==(other);
+}
+bool LegacyVersion::operator<=(const LegacyVersion& other) const
+{
+    return *this < other || *this == other;
+}
+bool LegacyVersion::operator>(const LegacyVersion& other) const
+{
+    return !(*this <= other);
+}
+bool LegacyVersion::operator>=(const LegacyVersion& other) const
+{
+    return !(*this < other);
+}
+
+void LegacyVersion::parse()
+{
+    m_sections.clear();
+    QString currentSection;
+
+    if (m_string.isEmpty())
+        return;
+
+    auto classChange = [&currentSection](QChar lastChar, QChar currentChar) {
+        if (lastChar.isNull())
+            return false;
+        if (lastChar.isDigit() != currentChar.isDigit())
+            return true;
+
+        const QList<QChar> s_separators{ '.', '-', '+' };
+        if (s_separators.contains(currentChar) && currentSection.at(0) != currentChar)
+            return true;
+
+        return false;
+    };
+
+    currentSection += m_string.at(0);
+    for (int i = 1; i < m_string.size(); ++i) {
+        const auto& current_char = m_string.at(i);
+        if (classChange(m_string.at(i - 1), current_char)) {
+            if (!currentSection.isEmpty())
+                m_sections.append(Section(currentSection));
+            currentSection = "";
+        }
+
+        currentSection += current_char;
+    }
+
+    if (!currentSection.isEmpty())
+        m_sections.append(Section(currentSection));
+}
+
+// version lists in the formats of the Minecraft and Forge ones, some thousand entries each
+QStringList minecraftVersions()
+{
+    QStringList versions = { "rd-132211", "rd-132328", "rd-160052", "rd-161348", "c0.0.11a", "c0.0.13a", "c0.30_01c", "inf-20100618" };
+    for (int i = 4; i <= 26; i++)
+        versions << QString("a1.%1.%2").arg(i / 10).arg(i % 10);
+    for (int i = 0; i <= 8; i++)
+        versions << QString("b1.%1").arg(i) << QString("b1.%1.1").arg(i) << QString("b1.%1_01").arg(i);
+
+    // number of patch releases of every 1.x
+    const int patches[] = { 1, 0, 5, 2, 7, 2, 4, 10, 9, 4, 2, 2, 2, 2, 4, 2, 5, 1, 2, 4, 6, 5 };
+    for (int minor = 0; minor < int(std::size(patches)); minor++) {
+        for (int patch = 0; patch <= patches[minor]; patch++) {
+            auto release = patch == 0 ? QString("1.%1").arg(minor) : QString("1.%1.%2").arg(minor).arg(patch);
+            versions << release;
+            for (int pre = 1; pre <= 7; pre++)
+                versions << QString("%1-pre%2").arg(release).arg(pre);
+            for (int rc = 1; rc <= 3; rc++)
+                versions << QString("%1-rc%2").arg(release).arg(rc);
+        }
+    }
+    for (int year = 11; year <= 24; year++) {
+        for (int week = 1; week <= 52; week += 2) {
+            for (auto suffix : { 'a', 'b', 'c' })
+                versions << QString("%1w%2%3").arg(year).arg(week, 2, 10, QChar('0')).arg(suffix);
+        }
+    }
+    versions << "3D Shareware v1.34" << "20w14infinite" << "22w13oneblockatatime" << "1.RV-Pre1" << "23w13a_or_b";
+    return versions;
+}
+
+QStringList forgeVersions()
+{
+    QStringList versions;
+    const int patches[] = { 0, 0, 5, 2, 7, 2, 4, 10, 9, 4, 2, 2, 2, 2, 4, 2, 5, 1, 2, 4, 6, 5 };
+    for (int minor = 1; minor < int(std::size(patches)); minor++) {
+        for (int patch = 0; patch <= patches[minor]; patch++) {
+            auto minecraft = patch == 0 ? QString("1.%1").arg(minor) : QString("1.%1.%2").arg(minor).arg(patch);
+            const int major = minor + 20;
+            for (int forgeMinor = 0; forgeMinor < 4; forgeMinor++) {
+                for (int build = 0; build < 60; build += 3) {
+                    if (minor <= 12)
+                        // legacy builds carry a build number and sometimes the branch
+                        versions << QString("%1-%2.%3.%4.%5").arg(minecraft).arg(major).arg(forgeMinor).arg(build).arg(1000 + build * 7)
+                                 << QString("%1-%2.%3.%4.%5-%1").arg(minecraft).arg(major).arg(forgeMinor).arg(build).arg(1000 + build * 7);
+                    else
+                        versions << QString("%1-%2.%3.%4").arg(minecraft).arg(major).arg(forgeMinor).arg(build);
+                }
+            }
+        }
+    }
+    return versions;
+}
+
+QList<Version> shuffled(const QStringList& strings)
+{
+    QList<Version> versions;
+    versions.reserve(strings.size());
+    for (auto& string : strings)
+        versions.append(Version(string));
+    std::shuffle(versions.begin(), versions.end(), QRandomGenerator(42));
+    return versions;
+}
+}  // namespace
+
 class VersionTest : public QObject {
     Q_OBJECT
 
@@ -181,6 +459,48 @@ class VersionTest : public QObject {
         QCOMPARE(v1 > v2, !lessThan && !equal);
         QCOMPARE(v1 == v2, equal);
     }
+
+    void test_matchesLegacyOrdering()
+    {
+        auto strings = minecraftVersions() + forgeVersions();
+        strings << "" << "1" << "01" << "1.0+build.5" << "1.0-" << "1.0--pre" << "..1" << "1.2+a+b" << "99999999999" << "1.0.0-rc.1";
+
+        QList<Version> versions;
+        QList<LegacyVersion> legacy;
+        for (auto& string : strings) {
+            versions.append(Version(string));
+            legacy.append(LegacyVersion(string));
+        }
+
+        QRandomGenerator random(7);
+        for (int i = 0; i < strings.size(); i++) {
+            for (int n = 0; n < 64; n++) {
+                auto j = random.bounded(int(strings.size()));
+                if ((versions[i] < versions[j]) != (legacy[i] < legacy[j]) || (versions[i] == versions[j]) != (legacy[i] == legacy[j]))
+                    QFAIL(qPrintable(QString("%1 and %2 compare differently than before").arg(strings[i], strings[j])));
+            }
+        }
+    }
+
+    void test_sortMinecraftVersions()
+    {
+        const auto versions = shuffled(minecraftVersions());
+        QBENCHMARK
+        {
+            auto sorted = versions;
+            std::sort(sorted.begin(), sorted.end());
+        }
+    }
+
+    void test_sortForgeVersions()
+    {
+        const auto versions = shuffled(forgeVersions());
+        QBENCHMARK
+        {
+            auto sorted = versions;
+            std::sort(sorted.begin(), sorted.end());
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(VersionTest)
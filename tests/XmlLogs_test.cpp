@@ -101,6 +101,56 @@ class XmlLogParseTest : public QObject {
         QCOMPARE(levels, entry_levels);
     }
 
+    void parseLargeStream_data()
+    {
+        QString source = QFINDTESTDATA("testdata/TestLogs");
+        QString longXml = QString::fromUtf8(FS::read(FS::PathCombine(source, "TerraFirmaGreg-Modern-forge.xml.log")));
+
+        // one event with a very long stack trace, delivered one line at a time
+        QStringList trace;
+        trace << R"(<log4j:Event logger="net.minecraft.server.MinecraftServer" timestamp="1745005464389" level="ERROR" thread="Server thread">)"
+              << R"(<log4j:Message><![CDATA[Encountered an unexpected exception)";
+        for (int i = 0; i < 20000; i++) {
+            trace << QString("	at net.minecraft.server.Frame%1.tick(Frame%1.java:%1)").arg(i);
+        }
+        trace << "]]></log4j:Message>"
+              << "</log4j:Event>";
+
+        QTest::addColumn<QString>("log");
+        QTest::addColumn<int>("repeats");
+        QTest::addColumn<int>("num_entries");
+
+        QTest::newRow("long-forge-xml-x50") << longXml << 50 << 869 * 50;
+        QTest::newRow("long-stacktrace") << trace.join('\n') << 1 << 1;
+    }
+
+    void parseLargeStream()
+    {
+        QFETCH(QString, log);
+        QFETCH(int, repeats);
+        QFETCH(int, num_entries);
+
+        QStringList lines;
+        auto chunk = log.split(QRegularExpression("\n|\r\n|\r"));
+        for (int i = 0; i < repeats; i++) {
+            lines.append(chunk);
+        }
+
+        int count = 0;
+        QBENCHMARK
+        {
+            LogParser parser;
+            count = 0;
+            for (const auto& line : lines) {
+                parser.appendLine(line);
+                count += parser.parseAvailable().size();
+            }
+            QVERIFY(!parser.getError().has_value());
+        }
+
+        QCOMPARE(count, num_entries);
+    }
+
    private:
     LogParser m_parser;
 